@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +22,38 @@ void seqlock_single_writer_destroy(struct SingleWriterSeqLock*);
 void seqlock_single_writer_load(struct SingleWriterSeqLock* wrapper_lock, char* dst, size_t size);
 void seqlock_single_writer_store(struct SingleWriterSeqLock* wrapper_lock, char* src, size_t size);
 void seqlock_single_writer_assign(struct SingleWriterSeqLock* wrapper_lock, int value);
+// Copies the region into `dst` once. Returns false if a write interfered, otherwise sets `seq`, if not null, to the
+// sequence number of the copied version.
+bool seqlock_single_writer_try_load(struct SingleWriterSeqLock* wrapper_lock, char* dst, size_t size, uint64_t* seq);
+uint64_t seqlock_single_writer_sequence(struct SingleWriterSeqLock* wrapper_lock);
+
+// A region in shared memory guarded by a `SeqLock<mode::MultiWriter>`, which writers of other processes and languages
+// can share. The lock occupies the first 128 bytes of the file: the sequence number at offset 0 and the writer
+// `SpinLock` at offset 64. The data starts at offset 128.
+struct MultiWriterSeqLock {
+    void* lock;
+    void* shm;
+    void* shared_data;
+    size_t shared_data_size;
+};
+
+struct MultiWriterSeqLock* seqlock_multi_writer_create_shared(const char* filename, size_t size);
+void seqlock_multi_writer_destroy(struct MultiWriterSeqLock* wrapper_lock);
+void seqlock_multi_writer_load(struct MultiWriterSeqLock* wrapper_lock, char* dst, size_t size);
+void seqlock_multi_writer_store(struct MultiWriterSeqLock* wrapper_lock, char* src, size_t size);
+bool seqlock_multi_writer_try_store(struct MultiWriterSeqLock* wrapper_lock, char* src, size_t size);
+bool seqlock_multi_writer_try_load(struct MultiWriterSeqLock* wrapper_lock, char* dst, size_t size, uint64_t* seq);
+uint64_t seqlock_multi_writer_sequence(struct MultiWriterSeqLock* wrapper_lock);
+
+// A runtime-sized, growable region in shared memory. See `DynamicRegion` in `dynamic_region.hpp`.
+struct SingleWriterDynamicRegion;
+
+struct SingleWriterDynamicRegion* seqlock_dynamic_region_create(const char* filename, size_t capacity);
+struct SingleWriterDynamicRegion* seqlock_dynamic_region_open(const char* filename);
+void seqlock_dynamic_region_destroy(struct SingleWriterDynamicRegion* region);
+bool seqlock_dynamic_region_load(struct SingleWriterDynamicRegion* region, char* dst, size_t size, size_t* region_size);
+bool seqlock_dynamic_region_store(struct SingleWriterDynamicRegion* region, const char* src, size_t size);
+size_t seqlock_dynamic_region_capacity(struct SingleWriterDynamicRegion* region);
 
 #ifdef __cplusplus
 }
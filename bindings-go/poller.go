@@ -0,0 +1,142 @@
+package seqlock
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Watched is a region whose sequence number a Poller watches, like SeqLockNative or SeqLockNativeMulti.
+type Watched interface {
+	Sequence() uint64
+}
+
+// Update notifies that Region committed the version with the sequence number Seq.
+type Update struct {
+	Region Watched
+	Seq    uint64
+}
+
+type subscription struct {
+	region Watched
+	last   uint64
+	fn     func(seq uint64)
+	ch     chan<- Update
+}
+
+// Poller watches many regions from a single goroutine locked to its OS thread, and notifies subscribers when a region
+// commits a new version, either through a callback or over a channel. Subscribers then read the region with Load or,
+// without copying it, LoadFn.
+//
+// Notifications are conflated: a subscriber that falls behind is notified of the latest version only. Callbacks run on
+// the polling goroutine and must return quickly. A notification that does not fit in a full channel is dropped, since
+// the pending one already tells the subscriber to read the region, and counted in Dropped.
+type Poller struct {
+	idle  time.Duration
+	yield bool
+
+	mu      sync.Mutex
+	pending []*subscription
+	added   atomic.Bool
+
+	// Only accessed by the polling goroutine.
+	subs []*subscription
+
+	stop    atomic.Bool
+	done    chan struct{}
+	dropped atomic.Uint64
+}
+
+// NewPoller returns a Poller which sleeps for idle after a pass in which no region changed. An idle of 0 busy-polls,
+// which gives the lowest latency at the cost of a full core. With GOMAXPROCS=1, a busy-polling Poller yields after
+// each pass in which no region changed, since the goroutines it notifies could only run once it is preempted.
+func NewPoller(idle time.Duration) *Poller {
+	return &Poller{idle: idle}
+}
+
+// Watch calls fn with the sequence number of every new version of region committed from now on.
+func (p *Poller) Watch(region Watched, fn func(seq uint64)) {
+	p.add(&subscription{region: region, last: region.Sequence(), fn: fn})
+}
+
+// WatchChan sends an Update to ch for every new version of region committed from now on.
+func (p *Poller) WatchChan(region Watched, ch chan<- Update) {
+	p.add(&subscription{region: region, last: region.Sequence(), ch: ch})
+}
+
+func (p *Poller) add(sub *subscription) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.pending = append(p.pending, sub)
+	p.added.Store(true)
+}
+
+// Start starts polling in a new goroutine.
+func (p *Poller) Start() {
+	p.stop.Store(false)
+	p.yield = runtime.GOMAXPROCS(0) == 1
+	p.done = make(chan struct{})
+	go p.run()
+}
+
+// Stop stops polling and waits for the polling goroutine to exit. No callback runs after Stop returns.
+func (p *Poller) Stop() {
+	p.stop.Store(true)
+	<-p.done
+}
+
+// Dropped returns the number of notifications dropped because a channel was full.
+func (p *Poller) Dropped() uint64 {
+	return p.dropped.Load()
+}
+
+func (p *Poller) run() {
+	// The goroutine keeps its thread, such that the thread can be pinned and isolated, and the poller does not compete
+	// with other goroutines for scheduling.
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+	defer close(p.done)
+
+	for !p.stop.Load() {
+		if p.added.Load() {
+			p.mu.Lock()
+			p.subs = append(p.subs, p.pending...)
+			p.pending = nil
+			p.added.Store(false)
+			p.mu.Unlock()
+		}
+
+		if !p.poll() {
+			if p.idle > 0 {
+				time.Sleep(p.idle)
+			} else if p.yield {
+				runtime.Gosched()
+			}
+		}
+	}
+}
+
+// poll checks every region once and returns true if at least one changed.
+func (p *Poller) poll() bool {
+	changed := false
+	for _, sub := range p.subs {
+		seq := sub.region.Sequence()
+		if seq%2 != 0 || seq == sub.last {
+			continue
+		}
+		sub.last = seq
+		changed = true
+
+		if sub.fn != nil {
+			sub.fn(seq)
+			continue
+		}
+		select {
+		case sub.ch <- Update{Region: sub.region, Seq: seq}:
+		default:
+			p.dropped.Add(1)
+		}
+	}
+	return changed
+}
@@ -0,0 +1,251 @@
+package seqlock
+
+import (
+	"fmt"
+	"os"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+func TestSeqLockNativeLoadFn(t *testing.T) {
+	lock, err := NewSeqLockNativeShared("/seqlock-native-loadfn", os.Getpagesize()-8)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer lock.Close()
+
+	lock.StoreFn(func(data []byte) {
+		for i := range data {
+			data[i] = 3
+		}
+	})
+
+	sum := 0
+	if !lock.LoadFn(func(data []byte) {
+		for _, b := range data {
+			sum += int(b)
+		}
+	}) {
+		t.Fatal("LoadFn should succeed without a writer")
+	}
+	if sum != 3*lock.Size() {
+		t.Fatalf("invalid sum %d", sum)
+	}
+
+	// A write during fn invalidates the load.
+	if lock.LoadFn(func(data []byte) { lock.Store(data) }) {
+		t.Fatal("LoadFn should fail if a write interfered")
+	}
+}
+
+func TestPoller(t *testing.T) {
+	const regions = 8
+
+	locks := make([]*SeqLockNative, regions)
+	for i := range locks {
+		lock, err := NewSeqLockNativeShared(fmt.Sprintf("/seqlock-poller-%d", i), 64)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer lock.Close()
+		locks[i] = lock
+	}
+
+	poller := NewPoller(10 * time.Microsecond)
+
+	// Even regions notify through a callback, odd ones over a channel.
+	var calls [regions]atomic.Uint64
+	updates := make(chan Update, regions)
+	for i, lock := range locks {
+		if i%2 == 0 {
+			i := i
+			poller.Watch(lock, func(seq uint64) { calls[i].Store(seq) })
+		} else {
+			poller.WatchChan(lock, updates)
+		}
+	}
+	poller.Start()
+	defer poller.Stop()
+
+	from := make([]byte, 64)
+	for i, lock := range locks {
+		from[0] = byte(i)
+		lock.Store(from)
+	}
+
+	deadline := time.After(5 * time.Second)
+	seen := make(map[Watched]uint64)
+	for len(seen) < regions/2 {
+		select {
+		case update := <-updates:
+			seen[update.Region] = update.Seq
+			if !update.Region.(*SeqLockNative).LoadFn(func(data []byte) {}) {
+				t.Error("LoadFn should succeed without a writer")
+			}
+		case <-deadline:
+			t.Fatalf("only %d channel notifications", len(seen))
+		}
+	}
+	for i := 1; i < regions; i += 2 {
+		if seen[locks[i]] != 2 {
+			t.Fatalf("region %d: invalid sequence number %d", i, seen[locks[i]])
+		}
+	}
+	for i := 0; i < regions; i += 2 {
+		for calls[i].Load() != 2 {
+			select {
+			case <-deadline:
+				t.Fatalf("region %d: no callback", i)
+			default:
+				time.Sleep(time.Millisecond)
+			}
+		}
+	}
+}
+
+func TestPollerConflates(t *testing.T) {
+	lock, err := NewSeqLockNativeShared("/seqlock-poller-conflate", 64)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer lock.Close()
+
+	poller := NewPoller(0)
+	updates := make(chan Update, 1)
+	poller.WatchChan(lock, updates)
+	poller.Start()
+
+	from := make([]byte, 64)
+	for i := 0; i < 1000; i++ {
+		lock.Store(from)
+	}
+	time.Sleep(10 * time.Millisecond)
+	poller.Stop()
+
+	// The subscriber did not read the channel, so it holds a single pending notification.
+	if len(updates) != 1 {
+		t.Fatalf("%d pending notifications, should be 1", len(updates))
+	}
+	t.Logf("dropped %d notifications", poller.Dropped())
+}
+
+var benchSizes = []int{64, 4096, 64 << 10, 1 << 20}
+
+// Compares the native copy, the native zero-copy LoadFn and the cgo call, across payload sizes.
+func BenchmarkLoad(b *testing.B) {
+	for _, size := range benchSizes {
+		b.Run(fmt.Sprintf("Native/%d", size), func(b *testing.B) {
+			lock, err := NewSeqLockNativeShared("/seqlock-bench-load-native", size)
+			if err != nil {
+				b.Fatal(err)
+			}
+			defer lock.Close()
+
+			into := make([]byte, size)
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				lock.Load(into)
+			}
+		})
+
+		b.Run(fmt.Sprintf("NativeLoadFn/%d", size), func(b *testing.B) {
+			lock, err := NewSeqLockNativeShared("/seqlock-bench-load-native-fn", size)
+			if err != nil {
+				b.Fatal(err)
+			}
+			defer lock.Close()
+
+			// Reads one byte per cache line in place instead of copying everything.
+			var sum byte
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				lock.LoadFn(func(data []byte) {
+					for j := 0; j < size; j += 64 {
+						sum += data[j]
+					}
+				})
+			}
+			_ = sum
+		})
+
+		b.Run(fmt.Sprintf("FFI/%d", size), func(b *testing.B) {
+			lock, err := NewSeqLockFFIShared("/seqlock-bench-load-ffi", size)
+			if err != nil {
+				b.Fatal(err)
+			}
+			defer lock.Close()
+
+			into := make([]byte, size)
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				lock.Load(into)
+			}
+		})
+	}
+}
+
+func BenchmarkStore(b *testing.B) {
+	for _, size := range benchSizes {
+		b.Run(fmt.Sprintf("Native/%d", size), func(b *testing.B) {
+			lock, err := NewSeqLockNativeShared("/seqlock-bench-store-native", size)
+			if err != nil {
+				b.Fatal(err)
+			}
+			defer lock.Close()
+
+			from := make([]byte, size)
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				lock.Store(from)
+			}
+		})
+
+		b.Run(fmt.Sprintf("FFI/%d", size), func(b *testing.B) {
+			lock, err := NewSeqLockFFIShared("/seqlock-bench-store-ffi", size)
+			if err != nil {
+				b.Fatal(err)
+			}
+			defer lock.Close()
+
+			from := make([]byte, size)
+			b.SetBytes(int64(size))
+			for i := 0; i < b.N; i++ {
+				lock.Store(from)
+			}
+		})
+	}
+}
+
+// Measures the latency from a store to its notification, with a busy-polling Poller watching `regions` regions.
+func BenchmarkPollerLatency(b *testing.B) {
+	for _, regions := range []int{1, 16, 256} {
+		b.Run(fmt.Sprintf("regions/%d", regions), func(b *testing.B) {
+			locks := make([]*SeqLockNative, regions)
+			for i := range locks {
+				lock, err := NewSeqLockNativeShared(fmt.Sprintf("/seqlock-bench-poller-%d", i), 64)
+				if err != nil {
+					b.Fatal(err)
+				}
+				defer lock.Close()
+				locks[i] = lock
+			}
+
+			poller := NewPoller(0)
+			updates := make(chan Update, 1)
+			poller.WatchChan(locks[regions-1], updates)
+			for _, lock := range locks[:regions-1] {
+				poller.Watch(lock, func(uint64) {})
+			}
+			poller.Start()
+			defer poller.Stop()
+
+			from := make([]byte, 64)
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				locks[regions-1].Store(from)
+				<-updates
+			}
+		})
+	}
+}
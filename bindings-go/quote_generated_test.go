@@ -0,0 +1,337 @@
+// Code generated by tools/seqlockgen.py from quote.toml. DO NOT EDIT.
+
+package seqlock
+
+import (
+	"encoding/binary"
+	"fmt"
+	"math"
+)
+
+const (
+	QuoteSize                      = 192
+	QuoteLayoutHash         uint64 = 0xa7a6cda010f1ff44
+	QuoteSingleWriterOffset        = 64
+	QuoteMultiWriterOffset         = 128
+)
+
+// Bits of the fields of a Quote, to load sets of fields.
+const (
+	QuoteBid     uint32 = 1 << 0
+	QuoteAsk     uint32 = 1 << 1
+	QuoteBidSize uint32 = 1 << 2
+	QuoteAskSize uint32 = 1 << 3
+	QuoteVenue   uint32 = 1 << 4
+	QuoteHalted  uint32 = 1 << 5
+	QuoteDepth   uint32 = 1 << 6
+	QuoteAll     uint32 = 1<<7 - 1
+)
+
+// Quote: The top of the book of an instrument, and the depth on its own cache lines.
+type Quote struct {
+	Bid     float64
+	Ask     float64
+	BidSize uint32
+	AskSize uint32
+	Venue   [8]byte
+	Halted  bool
+	Depth   [16]int64
+}
+
+// Encode writes the layout hash and all fields into data, which holds at least QuoteSize bytes.
+func (v *Quote) Encode(data []byte) {
+	binary.LittleEndian.PutUint64(data[0:], QuoteLayoutHash)
+	binary.LittleEndian.PutUint64(data[8:], math.Float64bits(v.Bid))
+	binary.LittleEndian.PutUint64(data[16:], math.Float64bits(v.Ask))
+	binary.LittleEndian.PutUint32(data[24:], v.BidSize)
+	binary.LittleEndian.PutUint32(data[28:], v.AskSize)
+	copy(data[32:40], v.Venue[:])
+	data[40] = 0
+	if v.Halted {
+		data[40] = 1
+	}
+	for i := range v.Depth {
+		binary.LittleEndian.PutUint64(data[64+i*8:], uint64(v.Depth[i]))
+	}
+}
+
+// Decode reads all fields from data, which holds at least QuoteSize bytes.
+func (v *Quote) Decode(data []byte) {
+	v.DecodeFields(data, QuoteAll)
+}
+
+// DecodeFields reads the fields set in fields from data, leaving the others untouched.
+func (v *Quote) DecodeFields(data []byte, fields uint32) {
+	if fields&QuoteBid != 0 {
+		v.Bid = math.Float64frombits(binary.LittleEndian.Uint64(data[8:]))
+	}
+	if fields&QuoteAsk != 0 {
+		v.Ask = math.Float64frombits(binary.LittleEndian.Uint64(data[16:]))
+	}
+	if fields&QuoteBidSize != 0 {
+		v.BidSize = binary.LittleEndian.Uint32(data[24:])
+	}
+	if fields&QuoteAskSize != 0 {
+		v.AskSize = binary.LittleEndian.Uint32(data[28:])
+	}
+	if fields&QuoteVenue != 0 {
+		copy(v.Venue[:], data[32:40])
+	}
+	if fields&QuoteHalted != 0 {
+		v.Halted = data[40] != 0
+	}
+	if fields&QuoteDepth != 0 {
+		for i := range v.Depth {
+			v.Depth[i] = int64(binary.LittleEndian.Uint64(data[64+i*8:]))
+		}
+	}
+}
+
+// QuoteRegion holds a Quote in a lock whose data starts where the C++ QuoteRegion of the same mode puts it:
+// at QuoteSingleWriterOffset for a single writer, see NewSeqLockNativeRegionShared, or at QuoteMultiWriterOffset
+// in a SeqLockNativeMulti.
+type QuoteRegion struct {
+	lock interface {
+		LoadFn(fn func(data []byte)) bool
+		StoreFn(fn func(data []byte))
+		Size() int
+		DataOffset() int
+	}
+}
+
+func NewQuoteRegion(lock interface {
+	LoadFn(fn func(data []byte)) bool
+	StoreFn(fn func(data []byte))
+	Size() int
+	DataOffset() int
+}) (QuoteRegion, error) {
+	if lock.Size() < QuoteSize {
+		return QuoteRegion{}, fmt.Errorf("region of %d bytes cannot hold a Quote of %d bytes", lock.Size(), QuoteSize)
+	}
+	if offset := lock.DataOffset(); offset != QuoteSingleWriterOffset && offset != QuoteMultiWriterOffset {
+		return QuoteRegion{}, fmt.Errorf("region with data at offset %d is not laid out like a C++ QuoteRegion", offset)
+	}
+	return QuoteRegion{lock: lock}, nil
+}
+
+func (r QuoteRegion) Store(v *Quote) {
+	r.lock.StoreFn(v.Encode)
+}
+
+func (r QuoteRegion) Load(v *Quote) {
+	r.LoadFields(v, QuoteAll)
+}
+
+// LoadFields loads the fields set in fields, reading only their bytes from the shared memory.
+func (r QuoteRegion) LoadFields(v *Quote, fields uint32) {
+	for !r.lock.LoadFn(func(data []byte) { v.DecodeFields(data, fields) }) {
+	}
+}
+
+func (r QuoteRegion) LoadBid() float64 {
+	var value float64
+	for !r.lock.LoadFn(func(data []byte) {
+		value = math.Float64frombits(binary.LittleEndian.Uint64(data[8:]))
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadAsk() float64 {
+	var value float64
+	for !r.lock.LoadFn(func(data []byte) {
+		value = math.Float64frombits(binary.LittleEndian.Uint64(data[16:]))
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadBidSize() uint32 {
+	var value uint32
+	for !r.lock.LoadFn(func(data []byte) {
+		value = binary.LittleEndian.Uint32(data[24:])
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadAskSize() uint32 {
+	var value uint32
+	for !r.lock.LoadFn(func(data []byte) {
+		value = binary.LittleEndian.Uint32(data[28:])
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadVenue() [8]byte {
+	var value [8]byte
+	for !r.lock.LoadFn(func(data []byte) {
+		copy(value[:], data[32:40])
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadHalted() bool {
+	var value bool
+	for !r.lock.LoadFn(func(data []byte) {
+		value = data[40] != 0
+	}) {
+	}
+	return value
+}
+
+func (r QuoteRegion) LoadDepth() [16]int64 {
+	var value [16]int64
+	for !r.lock.LoadFn(func(data []byte) {
+		for i := range value {
+			value[i] = int64(binary.LittleEndian.Uint64(data[64+i*8:]))
+		}
+	}) {
+	}
+	return value
+}
+
+// CheckLayout returns an error if the region was stored by a writer with a different layout, or never stored.
+func (r QuoteRegion) CheckLayout() error {
+	var layoutHash uint64
+	for !r.lock.LoadFn(func(data []byte) { layoutHash = binary.LittleEndian.Uint64(data[0:]) }) {
+	}
+	if layoutHash == 0 {
+		return fmt.Errorf("Quote was never stored")
+	}
+	if layoutHash != QuoteLayoutHash {
+		return fmt.Errorf("Quote has layout hash %#x instead of %#x", layoutHash, QuoteLayoutHash)
+	}
+	return nil
+}
+
+const (
+	TradeSize                      = 24
+	TradeLayoutHash         uint64 = 0x56c4d9096beb8572
+	TradeSingleWriterOffset        = 8
+	TradeMultiWriterOffset         = 128
+)
+
+// Bits of the fields of a Trade, to load sets of fields.
+const (
+	TradePrice    uint32 = 1 << 0
+	TradeQuantity uint32 = 1 << 1
+	TradeSide     uint32 = 1 << 2
+	TradeAll      uint32 = 1<<3 - 1
+)
+
+type Trade struct {
+	Price    float64
+	Quantity int32
+	Side     int8
+}
+
+// Encode writes the layout hash and all fields into data, which holds at least TradeSize bytes.
+func (v *Trade) Encode(data []byte) {
+	binary.LittleEndian.PutUint64(data[0:], TradeLayoutHash)
+	binary.LittleEndian.PutUint64(data[8:], math.Float64bits(v.Price))
+	binary.LittleEndian.PutUint32(data[16:], uint32(v.Quantity))
+	data[20] = byte(v.Side)
+}
+
+// Decode reads all fields from data, which holds at least TradeSize bytes.
+func (v *Trade) Decode(data []byte) {
+	v.DecodeFields(data, TradeAll)
+}
+
+// DecodeFields reads the fields set in fields from data, leaving the others untouched.
+func (v *Trade) DecodeFields(data []byte, fields uint32) {
+	if fields&TradePrice != 0 {
+		v.Price = math.Float64frombits(binary.LittleEndian.Uint64(data[8:]))
+	}
+	if fields&TradeQuantity != 0 {
+		v.Quantity = int32(binary.LittleEndian.Uint32(data[16:]))
+	}
+	if fields&TradeSide != 0 {
+		v.Side = int8(data[20])
+	}
+}
+
+// TradeRegion holds a Trade in a lock whose data starts where the C++ TradeRegion of the same mode puts it:
+// at TradeSingleWriterOffset for a single writer, see NewSeqLockNativeRegionShared, or at TradeMultiWriterOffset
+// in a SeqLockNativeMulti.
+type TradeRegion struct {
+	lock interface {
+		LoadFn(fn func(data []byte)) bool
+		StoreFn(fn func(data []byte))
+		Size() int
+		DataOffset() int
+	}
+}
+
+func NewTradeRegion(lock interface {
+	LoadFn(fn func(data []byte)) bool
+	StoreFn(fn func(data []byte))
+	Size() int
+	DataOffset() int
+}) (TradeRegion, error) {
+	if lock.Size() < TradeSize {
+		return TradeRegion{}, fmt.Errorf("region of %d bytes cannot hold a Trade of %d bytes", lock.Size(), TradeSize)
+	}
+	if offset := lock.DataOffset(); offset != TradeSingleWriterOffset && offset != TradeMultiWriterOffset {
+		return TradeRegion{}, fmt.Errorf("region with data at offset %d is not laid out like a C++ TradeRegion", offset)
+	}
+	return TradeRegion{lock: lock}, nil
+}
+
+func (r TradeRegion) Store(v *Trade) {
+	r.lock.StoreFn(v.Encode)
+}
+
+func (r TradeRegion) Load(v *Trade) {
+	r.LoadFields(v, TradeAll)
+}
+
+// LoadFields loads the fields set in fields, reading only their bytes from the shared memory.
+func (r TradeRegion) LoadFields(v *Trade, fields uint32) {
+	for !r.lock.LoadFn(func(data []byte) { v.DecodeFields(data, fields) }) {
+	}
+}
+
+func (r TradeRegion) LoadPrice() float64 {
+	var value float64
+	for !r.lock.LoadFn(func(data []byte) {
+		value = math.Float64frombits(binary.LittleEndian.Uint64(data[8:]))
+	}) {
+	}
+	return value
+}
+
+func (r TradeRegion) LoadQuantity() int32 {
+	var value int32
+	for !r.lock.LoadFn(func(data []byte) {
+		value = int32(binary.LittleEndian.Uint32(data[16:]))
+	}) {
+	}
+	return value
+}
+
+func (r TradeRegion) LoadSide() int8 {
+	var value int8
+	for !r.lock.LoadFn(func(data []byte) {
+		value = int8(data[20])
+	}) {
+	}
+	return value
+}
+
+// CheckLayout returns an error if the region was stored by a writer with a different layout, or never stored.
+func (r TradeRegion) CheckLayout() error {
+	var layoutHash uint64
+	for !r.lock.LoadFn(func(data []byte) { layoutHash = binary.LittleEndian.Uint64(data[0:]) }) {
+	}
+	if layoutHash == 0 {
+		return fmt.Errorf("Trade was never stored")
+	}
+	if layoutHash != TradeLayoutHash {
+		return fmt.Errorf("Trade has layout hash %#x instead of %#x", layoutHash, TradeLayoutHash)
+	}
+	return nil
+}
@@ -0,0 +1,157 @@
+package seqlock
+
+import (
+	"testing"
+)
+
+func TestQuoteRegionCrossLanguage(t *testing.T) {
+	const name = "/seqlock-schema-quote"
+
+	goLock, err := NewSeqLockNativeMultiShared(name, QuoteSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer goLock.Close()
+
+	cppLock, err := NewSeqLockFFIMultiShared(name, QuoteSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer cppLock.Close()
+
+	region, err := NewQuoteRegion(goLock)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if region.CheckLayout() == nil {
+		t.Fatal("CheckLayout should fail before the first store")
+	}
+
+	quote := Quote{Bid: 99.5, Ask: 100.25, BidSize: 10, AskSize: 20, Halted: true}
+	copy(quote.Venue[:], "XNAS")
+	for i := range quote.Depth {
+		quote.Depth[i] = int64(i) - 8
+	}
+	region.Store(&quote)
+	if err := region.CheckLayout(); err != nil {
+		t.Fatal(err)
+	}
+
+	var loaded Quote
+	region.Load(&loaded)
+	if loaded != quote {
+		t.Fatalf("loaded %+v instead of %+v", loaded, quote)
+	}
+
+	// The C++ reader sees the same bytes, so the layouts agree.
+	data := make([]byte, cppLock.Size())
+	if err := cppLock.Load(data); err != nil {
+		t.Fatal(err)
+	}
+	loaded = Quote{}
+	loaded.Decode(data)
+	if loaded != quote {
+		t.Fatalf("decoded %+v instead of %+v", loaded, quote)
+	}
+
+	// A load of some fields leaves the others untouched.
+	partial := Quote{BidSize: 1}
+	region.LoadFields(&partial, QuoteBid|QuoteDepth)
+	if partial.Bid != quote.Bid || partial.Depth != quote.Depth || partial.BidSize != 1 || partial.Ask != 0 {
+		t.Fatalf("LoadFields loaded %+v", partial)
+	}
+	if region.LoadAsk() != quote.Ask || region.LoadVenue() != quote.Venue || !region.LoadHalted() {
+		t.Fatal("the field loads should return the stored fields")
+	}
+
+	// A writer built from another schema is detected.
+	data[0]++
+	if err := cppLock.Store(data); err != nil {
+		t.Fatal(err)
+	}
+	if region.CheckLayout() == nil {
+		t.Fatal("CheckLayout should fail after a store with another layout hash")
+	}
+}
+
+func TestQuoteRegionCrossLanguageSingleWriter(t *testing.T) {
+	const name = "/seqlock-schema-quote-single"
+
+	goLock, err := NewSeqLockNativeRegionShared(name, QuoteSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer goLock.Close()
+	if goLock.DataOffset() != QuoteSingleWriterOffset {
+		t.Fatalf("the data is at offset %d instead of %d", goLock.DataOffset(), QuoteSingleWriterOffset)
+	}
+
+	// The C++ single-writer lock keeps its sequence number alone on the first cache line, like a `QuoteRegion`.
+	cppLock, err := NewSeqLockFFIShared(name, QuoteSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer cppLock.Close()
+
+	region, err := NewQuoteRegion(goLock)
+	if err != nil {
+		t.Fatal(err)
+	}
+	quote := Quote{Bid: 99.5, Ask: 100.25, BidSize: 10, AskSize: 20}
+	copy(quote.Venue[:], "XNYS")
+	for i := range quote.Depth {
+		quote.Depth[i] = int64(i) * 3
+	}
+	region.Store(&quote)
+
+	data := make([]byte, cppLock.Size())
+	if err := cppLock.Load(data); err != nil {
+		t.Fatal(err)
+	}
+	var loaded Quote
+	loaded.Decode(data)
+	if loaded != quote {
+		t.Fatalf("decoded %+v instead of %+v", loaded, quote)
+	}
+
+	quote.Halted = true
+	quote.Encode(data)
+	if err := cppLock.Store(data); err != nil {
+		t.Fatal(err)
+	}
+	if err := region.CheckLayout(); err != nil {
+		t.Fatal(err)
+	}
+	region.Load(&loaded)
+	if loaded != quote {
+		t.Fatalf("loaded %+v instead of %+v", loaded, quote)
+	}
+}
+
+type fixedSizeLock struct{ size, dataOffset int }
+
+func (l fixedSizeLock) LoadFn(fn func(data []byte)) bool { return true }
+func (l fixedSizeLock) StoreFn(fn func(data []byte))     {}
+func (l fixedSizeLock) Size() int                        { return l.size }
+func (l fixedSizeLock) DataOffset() int                  { return l.dataOffset }
+
+func TestRegionTooSmall(t *testing.T) {
+	if _, err := NewTradeRegion(fixedSizeLock{TradeSize - 1, TradeSingleWriterOffset}); err == nil {
+		t.Fatal("NewTradeRegion should fail when the lock cannot hold a Trade")
+	}
+	if _, err := NewTradeRegion(fixedSizeLock{TradeSize, TradeSingleWriterOffset}); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func TestRegionDataOffset(t *testing.T) {
+	// A Quote does not fit next to the sequence number, so a C++ single writer puts it on the next cache line.
+	if _, err := NewQuoteRegion(fixedSizeLock{QuoteSize, seqValueSize}); err == nil {
+		t.Fatal("NewQuoteRegion should fail when the data is not where the C++ QuoteRegion puts it")
+	}
+	for _, offset := range []int{QuoteSingleWriterOffset, QuoteMultiWriterOffset} {
+		if _, err := NewQuoteRegion(fixedSizeLock{QuoteSize, offset}); err != nil {
+			t.Fatal(err)
+		}
+	}
+}
@@ -1,7 +1,8 @@
 package seqlock
 
 // #cgo CXXFLAGS: -std=c++23
-// #cgo LDFLAGS: ${SRCDIR}/libseqlock.a -lstdc++
+// #cgo darwin LDFLAGS: ${SRCDIR}/libseqlock.a -lstdc++
+// #cgo linux,amd64 LDFLAGS: ${SRCDIR}/libseqlock_linux_amd64.a -lstdc++
 // #include <stdlib.h>
 // #include "ffi.h"
 import "C"
@@ -81,3 +82,63 @@ func (l *SeqLockFFI) Close() error {
 	_, err := C.seqlock_single_writer_destroy(l.ptr)
 	return err
 }
+
+// SeqLockFFIMulti wraps a C++ `SeqLock<mode::MultiWriter>` in shared memory. It can be shared with writers of
+// `SeqLockNativeMulti`.
+type SeqLockFFIMulti struct {
+	ptr  *C.struct_MultiWriterSeqLock
+	size int
+}
+
+func NewSeqLockFFIMultiShared(filename string, size int) (*SeqLockFFIMulti, error) {
+	cStr := C.CString(filename)
+	defer C.free(unsafe.Pointer(cStr))
+
+	ptr, err := C.seqlock_multi_writer_create_shared(cStr, (C.size_t)(size))
+	if err != nil {
+		return nil, err
+	}
+
+	return &SeqLockFFIMulti{
+		ptr:  ptr,
+		size: int(ptr.shared_data_size),
+	}, nil
+}
+
+func (l *SeqLockFFIMulti) Load(into []byte) error {
+	addr := (*C.char)(unsafe.Pointer(&into[0]))
+	var pinner runtime.Pinner
+	pinner.Pin(addr)
+	defer pinner.Unpin()
+
+	_, err := C.seqlock_multi_writer_load(l.ptr, addr, (C.size_t)(len(into)))
+	return err
+}
+
+func (l *SeqLockFFIMulti) Store(from []byte) error {
+	addr := (*C.char)(unsafe.Pointer(&from[0]))
+	var pinner runtime.Pinner
+	pinner.Pin(addr)
+	defer pinner.Unpin()
+
+	_, err := C.seqlock_multi_writer_store(l.ptr, addr, (C.size_t)(len(from)))
+	return err
+}
+
+func (l *SeqLockFFIMulti) TryStore(from []byte) bool {
+	addr := (*C.char)(unsafe.Pointer(&from[0]))
+	var pinner runtime.Pinner
+	pinner.Pin(addr)
+	defer pinner.Unpin()
+
+	return bool(C.seqlock_multi_writer_try_store(l.ptr, addr, (C.size_t)(len(from))))
+}
+
+func (l *SeqLockFFIMulti) Size() int {
+	return l.size
+}
+
+func (l *SeqLockFFIMulti) Close() error {
+	_, err := C.seqlock_multi_writer_destroy(l.ptr)
+	return err
+}
@@ -38,23 +38,29 @@ func mapExisting(fd int, name string, size int) ([]byte, error) {
 	return b, nil
 }
 
+// The size of the sequence number, which a C++ `SeqLock<mode::SingleWriter>` pads to seqSize.
+const seqValueSize = 8
+
 type memoryRegion struct {
 	whole []byte
 
 	seq  *uint64 // == whole[:8]
-	data []byte  // == whole[8:]
+	data []byte  // == whole[dataOffset:]
 }
 
 type SeqLockNative struct {
-	region    memoryRegion
-	isCreator bool
-	name      string
-	size      int
+	region     memoryRegion
+	isCreator  bool
+	name       string
+	size       int
+	dataOffset int
 }
 
-func NewSeqLockNativeShared(name string, size int) (*SeqLockNative, error) {
+// openShared opens or creates the memory-shared file `name` and maps `size` bytes of it. `size` must be rounded to
+// the page size. The returned bool is true if the file was created by this call.
+func openShared(name string, size int) ([]byte, bool, error) {
 	if len(name) <= 0 {
-		return nil, fmt.Errorf("Cannot create a file with an empty name.")
+		return nil, false, fmt.Errorf("Cannot create a file with an empty name.")
 	}
 	max_length := syscall.NAME_MAX
 	// TODO also modify the c++ code: on linux '/' is needed but not on macOS.
@@ -63,24 +69,11 @@ func NewSeqLockNativeShared(name string, size int) (*SeqLockNative, error) {
 	// 	max_length--
 	// }
 	if len(name) > max_length {
-		return nil, fmt.Errorf("Filename %s larger than %d.", name, max_length)
+		return nil, false, fmt.Errorf("Filename %s larger than %d.", name, max_length)
 	}
 
-	size += 8
-	if roundedSize, err := RoundToPageSize(size); err != nil {
-		return nil, err
-	} else {
-		size = roundedSize
-	}
-
-	fdptr, _, errno := syscall.Syscall(
-		syscall.SYS_SHM_OPEN,
-		uintptr(unsafe.Pointer(&name)),
-		syscall.O_CREAT|syscall.O_EXCL|syscall.O_RDWR,
-		syscall.S_IRUSR|syscall.S_IWUSR|syscall.S_IRGRP|syscall.S_IWGRP,
-	)
+	fd, errno := shmOpen(name, syscall.O_CREAT|syscall.O_EXCL|syscall.O_RDWR)
 	var (
-		fd               = int(fdptr)
 		isCreator        = false
 		b         []byte = nil
 		mapErr    error  = nil
@@ -92,48 +85,72 @@ func NewSeqLockNativeShared(name string, size int) (*SeqLockNative, error) {
 	} else if errno == syscall.EEXIST {
 		isCreator = false
 
-		errno = 0
-		fdptr, _, errno = syscall.Syscall(
-			syscall.SYS_SHM_OPEN,
-			uintptr(unsafe.Pointer(&name)),
-			syscall.O_RDWR,
-			syscall.S_IRUSR|syscall.S_IWUSR|syscall.S_IRGRP|syscall.S_IWGRP,
-		)
-		fd = int(fdptr)
+		fd, errno = shmOpen(name, syscall.O_RDWR)
 		if fd < 0 {
 			var err error
 			err = errno
-			return nil, err
+			return nil, false, err
 		}
 
 		b, mapErr = mapExisting(fd, name, size)
 	} else {
 		var err error
 		err = errno
-		return nil, err
+		return nil, false, err
 	}
 
 	syscall.Close(fd)
 	if mapErr != nil {
 		if isCreator {
-			syscall.Syscall(syscall.SYS_SHM_UNLINK, uintptr(unsafe.Pointer(&name)), 0, 0)
+			shmUnlink(name)
 		}
-		return nil, mapErr
+		return nil, false, mapErr
 	}
 
 	if len(b) != size {
-		return nil, fmt.Errorf("Mapped memory size = %d != %d = desired size", len(b), size)
+		return nil, false, fmt.Errorf("Mapped memory size = %d != %d = desired size", len(b), size)
+	}
+	return b, isCreator, nil
+}
+
+// NewSeqLockNativeShared maps a single-writer seqlock whose data directly follows the 8-byte sequence number.
+func NewSeqLockNativeShared(name string, size int) (*SeqLockNative, error) {
+	return newSeqLockNativeShared(name, size, seqValueSize)
+}
+
+// NewSeqLockNativeRegionShared is like NewSeqLockNativeShared but lays the data out like a C++
+// `GuardedRegion<mode::SingleWriter, size>`: next to the sequence number if both fit in a cache line, at offset 64
+// otherwise.
+func NewSeqLockNativeRegionShared(name string, size int) (*SeqLockNative, error) {
+	if seqValueSize+size <= seqSize {
+		return newSeqLockNativeShared(name, size, seqValueSize)
+	}
+	return newSeqLockNativeShared(name, size, seqSize)
+}
+
+func newSeqLockNativeShared(name string, size int, dataOffset int) (*SeqLockNative, error) {
+	size += dataOffset
+	if roundedSize, err := RoundToPageSize(size); err != nil {
+		return nil, err
+	} else {
+		size = roundedSize
+	}
+
+	b, isCreator, err := openShared(name, size)
+	if err != nil {
+		return nil, err
 	}
 
 	return &SeqLockNative{
 		region: memoryRegion{
 			whole: b,
 			seq:   (*uint64)(unsafe.Pointer(&b[0])),
-			data:  unsafe.Slice(&b[8], len(b)-8),
+			data:  unsafe.Slice(&b[dataOffset], len(b)-dataOffset),
 		},
-		isCreator: isCreator,
-		name:      name,
-		size:      size,
+		isCreator:  isCreator,
+		name:       name,
+		size:       size,
+		dataOffset: dataOffset,
 	}, nil
 }
 
@@ -143,7 +160,7 @@ func (s *SeqLockNative) Close() {
 		s.region.whole = nil
 
 		if s.isCreator {
-			syscall.Syscall(syscall.SYS_SHM_UNLINK, uintptr(unsafe.Pointer(&s.name)), 0, 0)
+			shmUnlink(s.name)
 		}
 	}
 }
@@ -164,12 +181,33 @@ func (s *SeqLockNative) Load(into []byte) bool {
 	return false
 }
 
+// LoadFn executes fn on the shared data in place, without copying it, and returns true if no write interfered. fn
+// might see a write in progress: it must not retain the slice, nor act on what it read unless LoadFn returns true.
+func (s *SeqLockNative) LoadFn(fn func(data []byte)) bool {
+	seqBefore := atomic.LoadUint64(s.region.seq)
+	if seqBefore%2 == 0 {
+		fn(s.region.data)
+		seqAfter := atomic.LoadUint64(s.region.seq)
+		return seqBefore == seqAfter
+	}
+	return false
+}
+
 func (s *SeqLockNative) Store(from []byte) {
 	s.StoreFn(func(data []byte) {
 		copy(data, from)
 	})
 }
 
+func (s *SeqLockNative) Sequence() uint64 {
+	return atomic.LoadUint64(s.region.seq)
+}
+
 func (s *SeqLockNative) Size() int {
-	return s.size - 8
+	return s.size - s.dataOffset
+}
+
+// DataOffset returns the offset of the data from the start of the shared memory.
+func (s *SeqLockNative) DataOffset() int {
+	return s.dataOffset
 }
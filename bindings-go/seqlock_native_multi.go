@@ -0,0 +1,187 @@
+package seqlock
+
+import (
+	"fmt"
+	"runtime"
+	"sync/atomic"
+	"syscall"
+	"unsafe"
+)
+
+// The layout of a `SeqLock<mode::MultiWriter>` in the C++ code: the 64-byte aligned sequence number followed by the
+// 64-byte aligned `SpinLock`, whose first byte is the `std::atomic_flag` held by the writer.
+const (
+	multiSeqSize     = 128
+	writerLockOffset = 64
+)
+
+type multiMemoryRegion struct {
+	whole []byte
+
+	seq  *uint64 // == whole[:8]
+	lock *uint32 // == whole[64:68], the lock is the first byte
+	data []byte  // == whole[128:]
+}
+
+// SeqLockNativeMulti is a multi-writer seqlock in shared memory, binary-compatible with a C++
+// `GuardedRegion<mode::MultiWriter, N>` or a region created with `seqlock_multi_writer_create_shared`. Go and C++
+// writers serialize through the same process-shared writer lock.
+//
+// Go has no 8-bit atomics, so the lock byte is set and cleared by CAS-ing the 32-bit word holding it. The other 3 bytes
+// of the word are padding which C++ never writes. Only little-endian platforms are supported.
+type SeqLockNativeMulti struct {
+	region    multiMemoryRegion
+	isCreator bool
+	name      string
+	size      int
+}
+
+func NewSeqLockNativeMultiShared(name string, size int) (*SeqLockNativeMulti, error) {
+	if !isLittleEndian() {
+		return nil, fmt.Errorf("SeqLockNativeMulti is only supported on little-endian platforms.")
+	}
+
+	size += multiSeqSize
+	if roundedSize, err := RoundToPageSize(size); err != nil {
+		return nil, err
+	} else {
+		size = roundedSize
+	}
+
+	b, isCreator, err := openShared(name, size)
+	if err != nil {
+		return nil, err
+	}
+
+	return &SeqLockNativeMulti{
+		region: multiMemoryRegion{
+			whole: b,
+			seq:   (*uint64)(unsafe.Pointer(&b[0])),
+			lock:  (*uint32)(unsafe.Pointer(&b[writerLockOffset])),
+			data:  unsafe.Slice(&b[multiSeqSize], len(b)-multiSeqSize),
+		},
+		isCreator: isCreator,
+		name:      name,
+		size:      size,
+	}, nil
+}
+
+func isLittleEndian() bool {
+	x := uint32(1)
+	return *(*byte)(unsafe.Pointer(&x)) == 1
+}
+
+func (s *SeqLockNativeMulti) Close() {
+	if s.region.whole != nil {
+		syscall.Munmap(s.region.whole)
+		s.region.whole = nil
+
+		if s.isCreator {
+			shmUnlink(s.name)
+		}
+	}
+}
+
+// WriterStalled returns true if a writer, Go or C++, holds the writer lock.
+func (s *SeqLockNativeMulti) WriterStalled() bool {
+	return atomic.LoadUint32(s.region.lock)&0xff != 0
+}
+
+func (s *SeqLockNativeMulti) tryAcquire() bool {
+	for {
+		word := atomic.LoadUint32(s.region.lock)
+		if word&0xff != 0 {
+			return false
+		}
+		if atomic.CompareAndSwapUint32(s.region.lock, word, word|1) {
+			return true
+		}
+		// The padding bytes never change, so the next iteration sees the lock taken.
+	}
+}
+
+func (s *SeqLockNativeMulti) release() {
+	for {
+		word := atomic.LoadUint32(s.region.lock)
+		if atomic.CompareAndSwapUint32(s.region.lock, word, word&^0xff) {
+			return
+		}
+	}
+}
+
+func (s *SeqLockNativeMulti) store(fn func(data []byte)) {
+	atomic.AddUint64(s.region.seq, 1)
+	fn(s.region.data)
+	atomic.AddUint64(s.region.seq, 1)
+	s.release()
+}
+
+// TryStoreFn executes fn if no other writer holds the writer lock and returns true. Otherwise, it returns false
+// without executing fn.
+func (s *SeqLockNativeMulti) TryStoreFn(fn func(data []byte)) bool {
+	if !s.tryAcquire() {
+		return false
+	}
+	s.store(fn)
+	return true
+}
+
+// StoreFn executes fn once it acquires the writer lock. Like the C++ `SpinLock`, it spins while the lock is held, but
+// yields the processor from time to time such that a writer goroutine holding the lock can make progress.
+func (s *SeqLockNativeMulti) StoreFn(fn func(data []byte)) {
+	for spins := 1; !s.tryAcquire(); spins++ {
+		for s.WriterStalled() {
+			if spins%1024 == 0 {
+				runtime.Gosched()
+			}
+			spins++
+		}
+	}
+	s.store(fn)
+}
+
+func (s *SeqLockNativeMulti) Load(into []byte) bool {
+	seqBefore := atomic.LoadUint64(s.region.seq)
+	if seqBefore%2 == 0 {
+		copy(into, s.region.data)
+		seqAfter := atomic.LoadUint64(s.region.seq)
+		return seqBefore == seqAfter
+	}
+	return false
+}
+
+// LoadFn executes fn on the shared data in place, like SeqLockNative.LoadFn.
+func (s *SeqLockNativeMulti) LoadFn(fn func(data []byte)) bool {
+	seqBefore := atomic.LoadUint64(s.region.seq)
+	if seqBefore%2 == 0 {
+		fn(s.region.data)
+		seqAfter := atomic.LoadUint64(s.region.seq)
+		return seqBefore == seqAfter
+	}
+	return false
+}
+
+func (s *SeqLockNativeMulti) TryStore(from []byte) bool {
+	return s.TryStoreFn(func(data []byte) {
+		copy(data, from)
+	})
+}
+
+func (s *SeqLockNativeMulti) Store(from []byte) {
+	s.StoreFn(func(data []byte) {
+		copy(data, from)
+	})
+}
+
+func (s *SeqLockNativeMulti) Sequence() uint64 {
+	return atomic.LoadUint64(s.region.seq)
+}
+
+func (s *SeqLockNativeMulti) Size() int {
+	return s.size - multiSeqSize
+}
+
+// DataOffset returns the offset of the data from the start of the shared memory.
+func (s *SeqLockNativeMulti) DataOffset() int {
+	return multiSeqSize
+}
@@ -0,0 +1,260 @@
+package seqlock
+
+import (
+	"os"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"testing"
+)
+
+func TestSeqLockNativeMultiSharedSize(t *testing.T) {
+	lock, err := NewSeqLockNativeMultiShared("/seqlock-native-multi-size", os.Getpagesize())
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer lock.Close()
+
+	if lock.Size() != 2*os.Getpagesize()-multiSeqSize {
+		t.Fatalf("invalid size, should be two pages instead of one")
+	}
+}
+
+func TestSeqLockNativeMultiTryStore(t *testing.T) {
+	const name = "/seqlock-native-multi-try"
+
+	goLock, err := NewSeqLockNativeMultiShared(name, os.Getpagesize()-multiSeqSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer goLock.Close()
+
+	cppLock, err := NewSeqLockFFIMultiShared(name, os.Getpagesize()-multiSeqSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer cppLock.Close()
+
+	from := make([]byte, goLock.Size())
+	for i := range from {
+		from[i] = 1
+	}
+	if !goLock.TryStore(from) {
+		t.Fatal("TryStore should succeed without contention")
+	}
+
+	// While a C++ writer is stalled in its store, Go writers cannot take the lock, and the other way around.
+	into := make([]byte, goLock.Size())
+	goLock.TryStoreFn(func(data []byte) {
+		if cppLock.TryStore(into) {
+			t.Error("C++ TryStore should fail while Go holds the lock")
+		}
+		if goLock.TryStore(into) {
+			t.Error("Go TryStore should fail while Go holds the lock")
+		}
+		if !goLock.WriterStalled() {
+			t.Error("the lock should be held")
+		}
+	})
+	if goLock.WriterStalled() {
+		t.Fatal("the lock should be released")
+	}
+
+	for i := range from {
+		from[i] = 2
+	}
+	if !cppLock.TryStore(from) {
+		t.Fatal("C++ TryStore should succeed once Go released the lock")
+	}
+	if !goLock.Load(into) || into[0] != 2 || into[len(into)-1] != 2 {
+		t.Fatal("Go should load the data stored by C++")
+	}
+	if goLock.Sequence() != 6 {
+		t.Fatalf("invalid sequence number %d, should be 6", goLock.Sequence())
+	}
+}
+
+func TestSeqLockNativeMultiCrossLanguageContention(t *testing.T) {
+	const (
+		name    = "/seqlock-native-multi-contention"
+		writers = 2 // per language
+		stores  = 10_000
+	)
+
+	reader, err := NewSeqLockNativeMultiShared(name, os.Getpagesize()-multiSeqSize)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer reader.Close()
+
+	var (
+		wg          sync.WaitGroup
+		writersDone int64 = 0
+		tryFailures int64 = 0
+	)
+
+	for w := 0; w < writers; w++ {
+		wg.Add(2)
+
+		go func(value byte) {
+			defer wg.Done()
+			defer atomic.AddInt64(&writersDone, 1)
+
+			lock, err := NewSeqLockNativeMultiShared(name, os.Getpagesize()-multiSeqSize)
+			if err != nil {
+				panic(err)
+			}
+			defer lock.Close()
+
+			from := make([]byte, lock.Size())
+			for i := range from {
+				from[i] = value
+			}
+			for i := 0; i < stores; i++ {
+				if i%2 == 0 {
+					lock.Store(from)
+				} else {
+					for !lock.TryStore(from) {
+						atomic.AddInt64(&tryFailures, 1)
+					}
+				}
+				if i%1000 == 0 {
+					// Lets the reader run between stores with a single CPU.
+					runtime.Gosched()
+				}
+			}
+		}(byte(2*w + 1))
+
+		go func(value byte) {
+			defer wg.Done()
+			defer atomic.AddInt64(&writersDone, 1)
+
+			lock, err := NewSeqLockFFIMultiShared(name, os.Getpagesize()-multiSeqSize)
+			if err != nil {
+				panic(err)
+			}
+			defer lock.Close()
+
+			from := make([]byte, lock.Size())
+			for i := range from {
+				from[i] = value
+			}
+			for i := 0; i < stores; i++ {
+				if i%2 == 0 {
+					lock.Store(from)
+				} else {
+					for !lock.TryStore(from) {
+						atomic.AddInt64(&tryFailures, 1)
+					}
+				}
+				if i%1000 == 0 {
+					// Lets the reader run between stores with a single CPU.
+					runtime.Gosched()
+				}
+			}
+		}(byte(2*w + 2))
+	}
+
+	seen := make(map[byte]bool)
+	into := make([]byte, reader.Size())
+	for atomic.LoadInt64(&writersDone) < 2*writers {
+		if !reader.Load(into) {
+			continue
+		}
+		for i := 0; i < len(into)-1; i++ {
+			if into[i] != into[i+1] {
+				t.Fatal("invalid load: writers overlapped")
+			}
+		}
+		seen[into[0]] = true
+		runtime.Gosched()
+	}
+	wg.Wait()
+
+	if reader.Sequence() != 2*2*writers*stores {
+		t.Fatalf("invalid sequence number %d, stores were lost", reader.Sequence())
+	}
+	if len(seen) < 2 {
+		t.Fatalf("the reader should see the stores of several writers, saw %v", seen)
+	}
+	t.Logf("TryStore failures under contention: %d", atomic.LoadInt64(&tryFailures))
+}
+
+func BenchmarkSeqLockNativeMultiStore(b *testing.B) {
+	lock, err := NewSeqLockNativeMultiShared("/seqlock-native-multi-bench", os.Getpagesize())
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer lock.Close()
+
+	buf := make([]byte, lock.Size())
+	for i := 0; i < b.N; i++ {
+		lock.Store(buf)
+	}
+}
+
+func BenchmarkSeqLockNativeMultiTryStore(b *testing.B) {
+	lock, err := NewSeqLockNativeMultiShared("/seqlock-native-multi-bench", os.Getpagesize())
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer lock.Close()
+
+	buf := make([]byte, lock.Size())
+	for i := 0; i < b.N; i++ {
+		lock.TryStore(buf)
+	}
+}
+
+// Go writers contend with each other and with a C++ writer storing in a loop.
+func BenchmarkSeqLockNativeMultiStoreContended(b *testing.B) {
+	const name = "/seqlock-native-multi-bench-contended"
+
+	cppLock, err := NewSeqLockFFIMultiShared(name, os.Getpagesize())
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer cppLock.Close()
+
+	var (
+		done int64 = 0
+		wg   sync.WaitGroup
+	)
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		buf := make([]byte, cppLock.Size())
+		for atomic.LoadInt64(&done) == 0 {
+			cppLock.Store(buf)
+		}
+	}()
+
+	b.RunParallel(func(pb *testing.PB) {
+		lock, err := NewSeqLockNativeMultiShared(name, os.Getpagesize())
+		if err != nil {
+			panic(err)
+		}
+		defer lock.Close()
+
+		buf := make([]byte, lock.Size())
+		for pb.Next() {
+			lock.Store(buf)
+		}
+	})
+
+	atomic.StoreInt64(&done, 1)
+	wg.Wait()
+}
+
+func BenchmarkSeqLockFFIMultiStore(b *testing.B) {
+	lock, err := NewSeqLockFFIMultiShared("/seqlock-ffi-multi-bench", os.Getpagesize())
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer lock.Close()
+
+	buf := make([]byte, lock.Size())
+	for i := 0; i < b.N; i++ {
+		lock.Store(buf)
+	}
+}
@@ -0,0 +1,24 @@
+package seqlock
+
+import (
+	"syscall"
+	"unsafe"
+)
+
+const shmMode = syscall.S_IRUSR | syscall.S_IWUSR | syscall.S_IRGRP | syscall.S_IWGRP
+
+// shmOpen opens the POSIX shared memory object `name` with `flags`. Returns a negative fd on failure.
+func shmOpen(name string, flags int) (int, syscall.Errno) {
+	namePtr, err := syscall.BytePtrFromString(name)
+	if err != nil {
+		return -1, syscall.EINVAL
+	}
+	fd, _, errno := syscall.Syscall(syscall.SYS_SHM_OPEN, uintptr(unsafe.Pointer(namePtr)), uintptr(flags), shmMode)
+	return int(fd), errno
+}
+
+func shmUnlink(name string) {
+	if namePtr, err := syscall.BytePtrFromString(name); err == nil {
+		syscall.Syscall(syscall.SYS_SHM_UNLINK, uintptr(unsafe.Pointer(namePtr)), 0, 0)
+	}
+}
@@ -0,0 +1,29 @@
+package seqlock
+
+import (
+	"strings"
+	"syscall"
+)
+
+const shmMode = syscall.S_IRUSR | syscall.S_IWUSR | syscall.S_IRGRP | syscall.S_IWGRP
+
+// Linux has no shm_open system call: glibc's shm_open, which the C++ code uses, opens the file under /dev/shm.
+func shmPath(name string) string {
+	return "/dev/shm/" + strings.TrimPrefix(name, "/")
+}
+
+// shmOpen opens the POSIX shared memory object `name` with `flags`. Returns a negative fd on failure.
+func shmOpen(name string, flags int) (int, syscall.Errno) {
+	fd, err := syscall.Open(shmPath(name), flags|syscall.O_CLOEXEC, shmMode)
+	if err != nil {
+		if errno, ok := err.(syscall.Errno); ok {
+			return -1, errno
+		}
+		return -1, syscall.EINVAL
+	}
+	return fd, 0
+}
+
+func shmUnlink(name string) {
+	syscall.Unlink(shmPath(name))
+}
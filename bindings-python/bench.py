@@ -0,0 +1,72 @@
+"""Measures loads per second from Python across payload sizes.
+
+Each size is loaded through `Region.load_into`, `Reader.load` and `Region.snapshot`, and compared with `bytes()` of a
+plain buffer of the same size, the cost of a copy without any FFI call or validation. Pass `--writer-rate` to store to
+the region from another thread while loading.
+"""
+
+import argparse
+import os
+import threading
+import time
+
+import seqlock
+
+SIZES = (64, 512, 4096, 65536, 1 << 20)
+
+
+def measure(fn, seconds: float) -> float:
+    """Returns the number of calls of `fn` per second, over about `seconds`."""
+    calls = 0
+    batch = 16
+    start = time.perf_counter()
+    while (elapsed := time.perf_counter() - start) < seconds:
+        for _ in range(batch):
+            fn()
+        calls += batch
+    return calls / elapsed
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--seconds", type=float, default=0.5, help="duration of each measurement")
+    parser.add_argument("--writer-rate", type=float, default=0, help="stores per second during loads")
+    args = parser.parse_args()
+
+    print(f"{'size':>8} {'load_into/s':>14} {'Reader.load/s':>14} {'snapshot/s':>14} {'bytes()/s':>14}")
+    for size in SIZES:
+        name = f"/bench-python-{size}"
+        if os.path.exists("/dev/shm" + name):
+            os.unlink("/dev/shm" + name)
+        with seqlock.SingleWriterRegion(name, size) as region:
+            region.store(b"\x01" * size)
+
+            done = threading.Event()
+            writer = None
+            if args.writer_rate > 0:
+
+                def write():
+                    data = b"\x02" * size
+                    while not done.wait(1 / args.writer_rate):
+                        region.store(data)
+
+                writer = threading.Thread(target=write)
+                writer.start()
+
+            buffer = bytearray(size)
+            reader = region.reader(size)
+            plain = bytearray(size)
+            rates = (
+                measure(lambda: region.load_into(buffer), args.seconds),
+                measure(reader.load, args.seconds),
+                measure(region.snapshot, args.seconds),
+                measure(lambda: bytes(plain), args.seconds),
+            )
+            done.set()
+            if writer is not None:
+                writer.join()
+        print(f"{size:>8} " + " ".join(f"{rate:>14,.0f}" for rate in rates))
+
+
+if __name__ == "__main__":
+    main()
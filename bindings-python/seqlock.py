@@ -0,0 +1,209 @@
+"""Python bindings for seqlock.cpp, over the C FFI of `ffi.h`.
+
+Regions live in shared memory created with `util::SharedMemory`, so Python readers attach to the same segments as C++
+and Go writers. Loads are validated against the sequence number like in C++, and copy the region straight into a
+caller-provided buffer: a `bytearray`, a writable `memoryview` or a NumPy array. No intermediate `bytes` is created.
+
+The shared library is `libseqlock_ffi.so`, built by the `seqlock_ffi` CMake target. It is looked up in the
+`SEQLOCK_FFI_LIBRARY` environment variable, next to this file, then in the system library paths.
+"""
+
+import ctypes
+import ctypes.util
+import os
+import sys
+from typing import NamedTuple, Optional
+
+__all__ = ["MultiWriterRegion", "Reader", "SingleWriterRegion", "Snapshot"]
+
+
+def _load_library() -> ctypes.CDLL:
+    if path := os.environ.get("SEQLOCK_FFI_LIBRARY"):
+        return ctypes.CDLL(path)
+    suffix = ".dylib" if sys.platform == "darwin" else ".so"
+    local = os.path.join(os.path.dirname(os.path.abspath(__file__)), "libseqlock_ffi" + suffix)
+    if os.path.exists(local):
+        return ctypes.CDLL(local)
+    if path := ctypes.util.find_library("seqlock_ffi"):
+        return ctypes.CDLL(path)
+    raise OSError("libseqlock_ffi not found, set SEQLOCK_FFI_LIBRARY to its path")
+
+
+class _SingleWriterSeqLock(ctypes.Structure):
+    _fields_ = [
+        ("lock", ctypes.c_void_p),
+        ("shm", ctypes.c_void_p),
+        ("shared_data", ctypes.c_void_p),
+        ("shared_data_size", ctypes.c_size_t),
+        ("shared", ctypes.c_bool),
+    ]
+
+
+class _MultiWriterSeqLock(ctypes.Structure):
+    _fields_ = [
+        ("lock", ctypes.c_void_p),
+        ("shm", ctypes.c_void_p),
+        ("shared_data", ctypes.c_void_p),
+        ("shared_data_size", ctypes.c_size_t),
+    ]
+
+
+_lib = _load_library()
+
+
+def _declare(prefix: str, struct: type) -> dict:
+    ptr = ctypes.POINTER(struct)
+    signatures = {
+        "create_shared": (ptr, [ctypes.c_char_p, ctypes.c_size_t]),
+        "destroy": (None, [ptr]),
+        "store": (None, [ptr, ctypes.c_void_p, ctypes.c_size_t]),
+        "try_load": (ctypes.c_bool, [ptr, ctypes.c_void_p, ctypes.c_size_t, ctypes.POINTER(ctypes.c_uint64)]),
+        "sequence": (ctypes.c_uint64, [ptr]),
+    }
+    functions = {}
+    for name, (restype, argtypes) in signatures.items():
+        function = getattr(_lib, f"{prefix}_{name}")
+        function.restype = restype
+        function.argtypes = argtypes
+        functions[name] = function
+    return functions
+
+
+def _address(buffer, writable: bool) -> tuple[int, int, object]:
+    """Returns the address and size of `buffer`'s memory, and an object which keeps the address valid while alive."""
+    view = memoryview(buffer)
+    if not view.c_contiguous:
+        raise ValueError("buffer must be C-contiguous")
+    if view.readonly:
+        if writable:
+            raise TypeError("buffer must be writable")
+        if isinstance(buffer, bytes):
+            return ctypes.cast(ctypes.c_char_p(buffer), ctypes.c_void_p).value or 0, len(buffer), buffer
+        view = memoryview(bytearray(view))
+    if view.nbytes == 0:
+        return 0, 0, view
+    pinned = ctypes.c_char.from_buffer(view.cast("B"))
+    return ctypes.addressof(pinned), view.nbytes, pinned
+
+
+class Snapshot(NamedTuple):
+    """A validated copy of a region: `data` is a read-only buffer of the region's bytes as of version `seq`."""
+
+    seq: int
+    data: memoryview
+
+
+class _Region:
+    _functions: dict
+    _struct: type
+
+    def __init__(self, name: str, size: int):
+        """Creates the shared memory segment `name` holding `size` bytes of data, or attaches to it if it exists."""
+        self._lock = self._functions["create_shared"](name.encode(), size)
+        if not self._lock:
+            raise OSError(f"could not create or attach to shared memory {name!r}")
+
+    def close(self) -> None:
+        """Unmaps the region. The segment itself is kept."""
+        if self._lock:
+            self._functions["destroy"](self._lock)
+            self._lock = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        self.close()
+
+    def __del__(self) -> None:
+        self.close()
+
+    @property
+    def size(self) -> int:
+        """The size of the region's data, in bytes, which is rounded up to whole pages."""
+        return self._lock.contents.shared_data_size
+
+    def sequence(self) -> int:
+        """Returns the current sequence number. It is odd while a write is in progress."""
+        return self._functions["sequence"](self._lock)
+
+    def store(self, data) -> None:
+        """Stores the bytes of `data`, a bytes-like object, at the start of the region."""
+        address, size, _keep = _address(data, writable=False)
+        self._functions["store"](self._lock, address, size)
+
+    def try_load_into(self, buffer) -> Optional[int]:
+        """Copies the region into `buffer` once. Returns the sequence number of the copied version, or None if a write
+        interfered."""
+        address, size, _keep = _address(buffer, writable=True)
+        return self._try_load(address, size)
+
+    def load_into(self, buffer) -> int:
+        """Copies the region into `buffer`, retrying until no write interferes, and returns the sequence number of the
+        copied version. Copies at most `len(buffer)` bytes."""
+        address, size, _keep = _address(buffer, writable=True)
+        while (seq := self._try_load(address, size)) is None:
+            pass
+        return seq
+
+    def snapshot(self) -> Snapshot:
+        """Returns a validated copy of the whole region in a new buffer."""
+        buffer = bytearray(self.size)
+        seq = self.load_into(buffer)
+        return Snapshot(seq, memoryview(buffer).toreadonly())
+
+    def reader(self, size: Optional[int] = None) -> "Reader":
+        """Returns a `Reader` with a preallocated buffer of `size` bytes, the whole region by default."""
+        return Reader(self, self.size if size is None else size)
+
+    def _try_load(self, address: int, size: int) -> Optional[int]:
+        seq = ctypes.c_uint64()
+        if self._functions["try_load"](self._lock, address, size, ctypes.byref(seq)):
+            return seq.value
+        return None
+
+
+class SingleWriterRegion(_Region):
+    """A region guarded by a `SeqLock<mode::SingleWriter>`, as created by `seqlock_single_writer_create_shared`. Only
+    one process may store to it."""
+
+    _functions = _declare("seqlock_single_writer", _SingleWriterSeqLock)
+
+
+class MultiWriterRegion(_Region):
+    """A region guarded by a `SeqLock<mode::MultiWriter>`, as created by `seqlock_multi_writer_create_shared`: the
+    sequence number is at offset 0, the writer lock at offset 64 and the data at offset 128. Any number of processes may
+    store to it."""
+
+    _functions = _declare("seqlock_multi_writer", _MultiWriterSeqLock)
+
+
+class Reader:
+    """A reader which repeatedly loads a region into the same preallocated buffer.
+
+    The buffer's address is resolved once, so a `load` costs a single FFI call. `refresh` skips the copy when the region
+    did not change. `data` is a read-only view of the buffer, whose content is replaced by each load: copy it, with
+    `bytes(reader.data)`, to keep a version.
+    """
+
+    def __init__(self, region: _Region, size: int):
+        self._region = region
+        self._buffer = bytearray(size)
+        self._address, self._size, self._pinned = _address(self._buffer, writable=True)
+        self.data = memoryview(self._buffer).toreadonly()
+        self.seq = 0
+
+    def load(self) -> memoryview:
+        """Loads the region into the buffer and returns `data`."""
+        while (seq := self._region._try_load(self._address, self._size)) is None:
+            pass
+        self.seq = seq
+        return self.data
+
+    def refresh(self) -> bool:
+        """Loads the region if its sequence number changed since the last load. Returns True if it did."""
+        seq = self._region.sequence()
+        if seq == self.seq or seq & 1:
+            return False
+        self.load()
+        return True
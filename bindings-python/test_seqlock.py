@@ -0,0 +1,101 @@
+import ctypes
+import os
+import threading
+import unittest
+
+import seqlock
+
+
+def _unlink(name: str) -> None:
+    try:
+        os.unlink("/dev/shm" + name)
+    except FileNotFoundError:
+        pass
+
+
+class SingleWriterRegionTest(unittest.TestCase):
+    name = "/test-python-single-writer"
+    region_type = seqlock.SingleWriterRegion
+
+    def setUp(self):
+        _unlink(self.name)
+        self.writer = self.region_type(self.name, 4096)
+        self.reader = self.region_type(self.name, 4096)
+
+    def tearDown(self):
+        self.reader.close()
+        self.writer.close()
+        _unlink(self.name)
+
+    def test_load_into(self):
+        self.assertGreaterEqual(self.reader.size, 4096)
+        self.writer.store(b"\x07" * 100)
+        buffer = bytearray(100)
+        self.assertEqual(self.reader.load_into(buffer), 2)
+        self.assertEqual(buffer, b"\x07" * 100)
+
+        # Writable views load in place, into a part of a larger buffer.
+        larger = bytearray(200)
+        self.assertEqual(self.reader.load_into(memoryview(larger)[50:150]), 2)
+        self.assertEqual(larger, b"\x00" * 50 + b"\x07" * 100 + b"\x00" * 50)
+
+        with self.assertRaises(TypeError):
+            self.reader.load_into(b"read-only")
+
+    def test_store_buffers(self):
+        for data in (b"abc", bytearray(b"abc"), memoryview(b"abc"), (ctypes.c_char * 3)(*b"abc")):
+            self.writer.store(data)
+            self.assertEqual(bytes(self.reader.snapshot().data[:3]), b"abc")
+
+    def test_try_load_during_write(self):
+        self.writer.store(b"x")
+        seq = ctypes.c_uint64.from_address(self.writer._lock.contents.lock)
+        seq.value += 1
+        self.assertIsNone(self.reader.try_load_into(bytearray(1)))
+        self.assertEqual(self.reader.sequence(), 3)
+        seq.value += 1
+        self.assertEqual(self.reader.try_load_into(bytearray(1)), 4)
+
+    def test_snapshot(self):
+        self.writer.store(b"snapshot")
+        snapshot = self.reader.snapshot()
+        self.assertEqual(snapshot.seq, 2)
+        self.assertEqual(len(snapshot.data), self.reader.size)
+        self.assertEqual(bytes(snapshot.data[:8]), b"snapshot")
+        self.assertTrue(snapshot.data.readonly)
+
+    def test_reader(self):
+        reader = self.reader.reader(8)
+        self.assertFalse(reader.refresh())
+        self.writer.store(b"12345678")
+        self.assertTrue(reader.refresh())
+        self.assertEqual(reader.seq, 2)
+        self.assertEqual(bytes(reader.data), b"12345678")
+        self.assertFalse(reader.refresh())
+
+    def test_consistent_under_writes(self):
+        size = 4096
+        done = threading.Event()
+
+        def write():
+            for i in range(1000):
+                self.writer.store(bytes([i % 256]) * size)
+            done.set()
+
+        writer = threading.Thread(target=write)
+        writer.start()
+        reader = self.reader.reader(size)
+        while not done.is_set():
+            data = reader.load()
+            self.assertEqual(data.tobytes(), data[:1].tobytes() * size)
+        writer.join()
+        self.assertEqual(self.reader.sequence(), 2000)
+
+
+class MultiWriterRegionTest(SingleWriterRegionTest):
+    name = "/test-python-multi-writer"
+    region_type = seqlock.MultiWriterRegion
+
+
+if __name__ == "__main__":
+    unittest.main()
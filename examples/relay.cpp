@@ -0,0 +1,60 @@
+// Relays memory-shared regions to processes that cannot map them, over a Unix domain socket.
+//
+//   relay <socket path> <shm file>...
+//
+// Each shm file holds a `GuardedRegion<mode::SingleWriter, 1024>`, like the one written by `shm`, and gets the id of
+// its position in the arguments, starting at 0. Subscribers connect with `RelaySubscriber::Connect`. Stops on SIGINT
+// or SIGTERM.
+
+#include <csignal>
+#include <iostream>
+#include <seqlock/relay.hpp>
+#include <seqlock/seqlock.hpp>
+#include <seqlock/util.hpp>
+#include <thread>
+#include <vector>
+
+using namespace seqlock;  // NOLINT
+
+using Region = seqlock::GuardedRegion<seqlock::mode::SingleWriter, 1024>;
+
+namespace {
+
+Relay* running_relay{nullptr};
+
+void HandleSignal(int) { running_relay->Stop(); }
+
+}  // namespace
+
+int main(int argc, char** argv) {  // NOLINT
+    if (argc < 3) {
+        std::cout << "usage: " << argv[0] << " <socket path> <shm file>..." << std::endl;
+        return 1;
+    }
+
+    auto relay = Relay::Listen(argv[1]);
+    if (not relay) {
+        std::cout << "could not start relay err=" << relay.error() << std::endl;
+        return 1;
+    }
+
+    std::vector<util::SharedMemory<Region>> segments;
+    for (int i = 2; i < argc; i++) {
+        auto shm = util::SharedMemory<Region>::Open(argv[i]);
+        if (not shm) {
+            std::cout << "could not map " << argv[i] << " err=" << shm.error() << std::endl;
+            return 1;
+        }
+        std::cout << "relaying " << argv[i] << " as region " << relay->Add(*shm->Get()) << std::endl;
+        segments.push_back(std::move(shm.value()));
+    }
+
+    // Busy-polls its core, see `util::PinThisThread`.
+    running_relay = &relay.value();
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    relay->Run();
+
+    std::cout << "relay done, sent " << relay->Sent() << " messages" << std::endl;
+    return 0;
+}
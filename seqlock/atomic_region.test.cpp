@@ -0,0 +1,70 @@
+#include "seqlock/atomic_region.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace seqlock;  // NOLINT
+
+TEST(AtomicRegion, StoreLoad) {
+    AtomicRegion<12> region;
+    ASSERT_EQ(sizeof(region), 16);
+
+    char into[12];
+    region.Load(into, sizeof(into));
+    for (char c : into) {
+        ASSERT_EQ(c, 0);
+    }
+
+    const char from[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    region.Store(from, sizeof(from));
+    region.Load(into, sizeof(into));
+    ASSERT_EQ(std::memcmp(from, into, sizeof(into)), 0);
+
+    // Sizes are clamped to the region size.
+    char large[32];
+    std::memset(large, 7, sizeof(large));
+    region.Load(large, sizeof(large));
+    ASSERT_EQ(std::memcmp(from, large, sizeof(from)), 0);
+    ASSERT_EQ(large[12], 7);
+}
+
+TEST(AtomicRegion, NoTornReads) {
+    AtomicRegion<16> region;
+    std::atomic<bool> done{false};
+
+    // Writers store values whose 16 bytes are equal, readers check they never see a mix of two values.
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; w++) {
+        writers.emplace_back([&, w] {
+            char from[16];
+            for (int i = 0; not done; i++) {
+                std::memset(from, 2 * (i & 63) + w, sizeof(from));
+                region.Store(from, sizeof(from));
+            }
+        });
+    }
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; r++) {
+        readers.emplace_back([&] {
+            char into[16];
+            for (int i = 0; i < 1'000'000; i++) {
+                region.Load(into, sizeof(into));
+                for (char c : into) {
+                    ASSERT_EQ(c, into[0]);
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    done = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+}
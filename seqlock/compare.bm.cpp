@@ -0,0 +1,276 @@
+// Runs the same workloads through `SeqLock` and through other reader-writer primitives: `std::shared_mutex`, a
+// process-shared `pthread_rwlock_t`, `std::atomic<std::shared_ptr>` and `RcuRegion`.
+//
+// A writer thread stores a payload of `N` bytes at a fixed rate while `state.threads()` readers copy it out as fast as
+// they can. Besides the reader throughput, each run reports the percentiles of the reader and writer latencies, in ns.
+// Reader percentiles are computed per reader over its last 64Ki loads, then averaged across readers.
+
+#include <benchmark/benchmark.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "seqlock/rcu.hpp"
+#include "seqlock/seqlock.hpp"
+#include "seqlock/util.hpp"
+
+namespace {
+
+template <size_t N>
+struct Payload {
+    char data[N];
+};
+
+/// The latencies of the last `kSamples` operations, in TSC ticks.
+class Latencies {
+   public:
+    static constexpr size_t kSamples = 1 << 16;
+
+    Latencies() : samples_(kSamples) {}
+
+    void Add(uint64_t ticks) noexcept { samples_[count_++ % kSamples] = ticks; }
+
+    /// `Report` sets the `<prefix>_p50`, `_p99` and `_p999` counters of `state`, in ns.
+    void Report(benchmark::State& state, const char* prefix, double ticks_per_ns,
+                benchmark::Counter::Flags flags = benchmark::Counter::kDefaults) {
+        samples_.resize(std::min(count_, kSamples));
+        if (samples_.empty()) {
+            return;
+        }
+        std::sort(samples_.begin(), samples_.end());
+        for (const auto& [suffix, percentile] : {std::pair{"_p50", 0.5}, {"_p99", 0.99}, {"_p999", 0.999}}) {
+            const auto ticks = samples_[static_cast<size_t>(percentile * static_cast<double>(samples_.size() - 1))];
+            state.counters[std::string{prefix} + suffix] =
+                benchmark::Counter(static_cast<double>(ticks) / ticks_per_ns, flags);
+        }
+    }
+
+   private:
+    std::vector<uint64_t> samples_;
+    size_t count_{0};
+};
+
+struct NoReader {};
+
+template <size_t N>
+class SeqLockPrimitive {
+   public:
+    using Reader = NoReader;
+
+    Reader Register(uint64_t) { return {}; }
+
+    void Load(Reader&, char* into) const noexcept {
+        lock_.Load([&] { std::memcpy(into, data_.data, N); });
+    }
+
+    void Store(const char* from) noexcept {
+        lock_.Store([&] { std::memcpy(data_.data, from, N); });
+    }
+
+   private:
+    seqlock::SeqLock<seqlock::mode::SingleWriter> lock_;
+    Payload<N> data_{};
+};
+
+template <size_t N>
+class SharedMutexPrimitive {
+   public:
+    using Reader = NoReader;
+
+    Reader Register(uint64_t) { return {}; }
+
+    void Load(Reader&, char* into) const {
+        std::shared_lock lock{mutex_};
+        std::memcpy(into, data_.data, N);
+    }
+
+    void Store(const char* from) {
+        std::unique_lock lock{mutex_};
+        std::memcpy(data_.data, from, N);
+    }
+
+   private:
+    mutable std::shared_mutex mutex_;
+    Payload<N> data_{};
+};
+
+// Process-shared, as it would be in shared memory next to the data.
+template <size_t N>
+class RwLockPrimitive {
+   public:
+    using Reader = NoReader;
+
+    RwLockPrimitive() {
+        pthread_rwlockattr_t attr;
+        pthread_rwlockattr_init(&attr);
+        pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_rwlock_init(&lock_, &attr);
+        pthread_rwlockattr_destroy(&attr);
+    }
+    ~RwLockPrimitive() { pthread_rwlock_destroy(&lock_); }
+
+    Reader Register(uint64_t) { return {}; }
+
+    void Load(Reader&, char* into) const {
+        pthread_rwlock_rdlock(&lock_);
+        std::memcpy(into, data_.data, N);
+        pthread_rwlock_unlock(&lock_);
+    }
+
+    void Store(const char* from) {
+        pthread_rwlock_wrlock(&lock_);
+        std::memcpy(data_.data, from, N);
+        pthread_rwlock_unlock(&lock_);
+    }
+
+   private:
+    mutable pthread_rwlock_t lock_;
+    Payload<N> data_{};
+};
+
+template <size_t N>
+class AtomicSharedPtrPrimitive {
+   public:
+    using Reader = NoReader;
+
+    AtomicSharedPtrPrimitive() : data_{std::make_shared<const Payload<N>>()} {}
+
+    Reader Register(uint64_t) { return {}; }
+
+    void Load(Reader&, char* into) const {
+        const auto data = data_.load(std::memory_order_acquire);
+        std::memcpy(into, data->data, N);
+    }
+
+    void Store(const char* from) {
+        auto data = std::make_shared<Payload<N>>();
+        std::memcpy(data->data, from, N);
+        data_.store(std::move(data), std::memory_order_release);
+    }
+
+   private:
+    std::atomic<std::shared_ptr<const Payload<N>>> data_;
+};
+
+template <size_t N>
+class RcuPrimitive {
+   private:
+    using Region = seqlock::RcuRegion<seqlock::mode::SingleWriter, Payload<N>, 4, 32>;
+
+   public:
+    using Reader = typename Region::Reader;
+
+    RcuPrimitive() : region_{std::make_unique<Region>()} {
+        region_->Update([](Payload<N>&) {});
+    }
+
+    Reader Register(uint64_t id) { return std::move(region_->Register(id).value()); }
+
+    void Load(Reader& reader, char* into) const {
+        const auto guard = reader.Read();
+        std::memcpy(into, guard->data, N);
+    }
+
+    void Store(const char* from) {
+        // Retry while readers hold every replaced version.
+        while (not region_->Update([&](Payload<N>& data) { std::memcpy(data.data, from, N); })) {
+            std::this_thread::yield();
+        }
+    }
+
+   private:
+    std::unique_ptr<Region> region_;
+};
+
+std::thread* writer{nullptr};
+std::atomic<bool> writer_done{false};
+Latencies writer_latencies;
+int64_t writer_stores{0};
+
+// Readers load from the primitive while a writer stores `state.range(0)` times per second.
+template <template <size_t> typename PrimitiveT, size_t N>
+void BM_Read(benchmark::State& state) {
+    using Primitive = PrimitiveT<N>;
+    static const double ticks_per_ns = seqlock::util::TscTicksPerNs();
+    // Created once and kept across runs, as readers register before the runs' threads synchronize.
+    static const auto primitive = std::make_unique<Primitive>();
+
+    if (state.thread_index() == 0) {
+        writer_done.store(false, std::memory_order_relaxed);
+        writer_latencies = Latencies{};
+        writer_stores = 0;
+        writer = new std::thread{[rate = state.range(0)] {
+            auto from = std::make_unique<Payload<N>>();
+            const auto period = static_cast<uint64_t>(1e9 / static_cast<double>(rate) * ticks_per_ns);
+            uint64_t next = seqlock::util::ReadTsc();
+            while (not writer_done.load(std::memory_order_relaxed)) {
+                next += period;
+                while (seqlock::util::ReadTsc() < next and not writer_done.load(std::memory_order_relaxed)) {
+                    std::this_thread::yield();
+                }
+                std::memset(from->data, static_cast<char>(writer_stores), N);
+                const uint64_t start = seqlock::util::ReadTsc();
+                primitive->Store(from->data);
+                writer_latencies.Add(seqlock::util::ReadTsc() - start);
+                writer_stores++;
+            }
+        }};
+    }
+
+    auto reader = primitive->Register(state.thread_index() + 1);
+    auto into = std::make_unique<Payload<N>>();
+    Latencies latencies;
+    for (auto _ : state) {
+        const uint64_t start = seqlock::util::ReadTsc();
+        primitive->Load(reader, into->data);
+        latencies.Add(seqlock::util::ReadTsc() - start);
+        benchmark::DoNotOptimize(into->data);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N));
+    latencies.Report(state, "read", ticks_per_ns, benchmark::Counter::kAvgThreads);
+
+    if (state.thread_index() == 0) {
+        writer_done.store(true, std::memory_order_relaxed);
+        writer->join();
+        delete writer;
+        writer = nullptr;
+        // Only the first reader reports the writer counters, so the sums across readers are the writer's values.
+        writer_latencies.Report(state, "write", ticks_per_ns);
+        state.counters["writes"] = benchmark::Counter(static_cast<double>(writer_stores), benchmark::Counter::kIsRate);
+    }
+}
+
+}  // namespace
+
+// Payload sizes from a price to a full-depth book or reference table, readers from 1 to 32, and writes/s.
+#define COMPARE_BENCHMARK(type, size) \
+    BENCHMARK(BM_Read<type, size>)    \
+        ->Arg(1'000)                  \
+        ->Arg(100'000)                \
+        ->ArgName("writes/s")         \
+        ->ThreadRange(1, 32)          \
+        ->UseRealTime()
+
+#define COMPARE_BENCHMARKS(type)    \
+    COMPARE_BENCHMARK(type, 8);     \
+    COMPARE_BENCHMARK(type, 64);    \
+    COMPARE_BENCHMARK(type, 512);   \
+    COMPARE_BENCHMARK(type, 4096);  \
+    COMPARE_BENCHMARK(type, 65536); \
+    COMPARE_BENCHMARK(type, 1048576)
+
+COMPARE_BENCHMARKS(SeqLockPrimitive);
+COMPARE_BENCHMARKS(SharedMutexPrimitive);
+COMPARE_BENCHMARKS(RwLockPrimitive);
+COMPARE_BENCHMARKS(AtomicSharedPtrPrimitive);
+COMPARE_BENCHMARKS(RcuPrimitive);
+
+BENCHMARK_MAIN();
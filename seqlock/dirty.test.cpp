@@ -0,0 +1,158 @@
+#include "seqlock/dirty.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+TEST(DirtyBitmap, CollectReportsMarkedOnce) {
+    DirtyBitmap<20'000> bitmap{};
+
+    ASSERT_FALSE(bitmap.Pending(0));
+    ASSERT_EQ(bitmap.Collect(0, [](size_t) { FAIL(); }), 0);
+
+    const std::vector<size_t> marked{0, 63, 64, 4095, 4096, 12'345, 19'999};
+    for (auto index : marked) {
+        bitmap.Mark(index);
+    }
+    bitmap.Mark(12'345);  // marking twice is reported once
+    ASSERT_TRUE(bitmap.Pending(0));
+
+    std::vector<size_t> collected;
+    ASSERT_EQ(bitmap.Collect(0, [&](size_t index) { collected.push_back(index); }), marked.size());
+    ASSERT_EQ(collected, marked);
+
+    ASSERT_FALSE(bitmap.Pending(0));
+    ASSERT_EQ(bitmap.Collect(0, [](size_t) { FAIL(); }), 0);
+}
+
+TEST(DirtyBitmap, ConsumersAreIndependent) {
+    DirtyBitmap<128, 2> bitmap{};
+
+    bitmap.Mark(7);
+    ASSERT_EQ(bitmap.Collect(0, [](size_t index) { ASSERT_EQ(index, 7); }), 1);
+    ASSERT_FALSE(bitmap.Pending(0));
+
+    ASSERT_TRUE(bitmap.Pending(1));
+    ASSERT_EQ(bitmap.Collect(1, [](size_t index) { ASSERT_EQ(index, 7); }), 1);
+    ASSERT_FALSE(bitmap.Pending(1));
+}
+
+TEST(DirtyBitmap, MultiThreadNoLostNotifications) {
+    constexpr size_t kRegions = 10'000;
+    DirtyBitmap<kRegions> bitmap{};
+
+    // The writer marks each region exactly once, the reader must see all of them.
+    std::atomic<bool> writer_done{false};
+    std::thread writer{[&] {
+        for (size_t i = 0; i < kRegions; i++) {
+            bitmap.Mark((i * 7919) % kRegions);
+        }
+        writer_done = true;
+    }};
+
+    std::vector<bool> seen(kRegions, false);
+    size_t unique{0};
+    while (not writer_done or bitmap.Pending(0)) {
+        bitmap.Collect(0, [&](size_t index) {
+            if (not seen[index]) {
+                seen[index] = true;
+                unique++;
+            }
+        });
+    }
+    writer.join();
+
+    ASSERT_EQ(unique, kRegions);
+}
+
+TEST(WatchedRegions, LoadChanged) {
+    using Regions = WatchedRegions<mode::SingleWriter, 64, 1024>;
+    auto regions = std::make_unique<Regions>();
+
+    char from[Regions::Size()];
+    memset(from, 3, sizeof(from));
+    regions->Store(10, from, sizeof(from));
+    memset(from, 4, sizeof(from));
+    regions->Store(1000, from, sizeof(from));
+
+    char into[Regions::Size()];
+    std::vector<size_t> changed;
+    const auto loaded = regions->LoadChanged(0, into, sizeof(into), [&](size_t index, const char* data) {
+        changed.push_back(index);
+        for (size_t i = 0; i < Regions::Size(); i++) {
+            ASSERT_EQ(data[i], index == 10 ? 3 : 4);
+        }
+    });
+    ASSERT_EQ(loaded, 2);
+    ASSERT_EQ(changed, (std::vector<size_t>{10, 1000}));
+
+    ASSERT_EQ(regions->LoadChanged(0, into, sizeof(into), [](size_t, const char*) { FAIL(); }), 0);
+}
+
+TEST(WatchedRegions, Shm) {
+    using Regions = WatchedRegions<mode::SingleWriter, 64, 20'000>;
+    constexpr int kStores = 1'000;
+
+    std::atomic<int> writer_state{0};  // 0: preparing 1: writing 2: done
+    std::atomic<bool> reader_ready{false};
+
+    std::thread writer{[&] {
+        auto shm = util::SharedMemory<Regions>::Create("/watchedregions", sizeof(Regions));
+        if (not shm) {
+            GTEST_FAIL() << "writer could not map memory err=" << shm.error();
+        }
+        auto* regions = shm->Get();
+
+        writer_state = 1;
+        while (not reader_ready) {
+        }
+
+        for (int i = 0; i < kStores; i++) {
+            char from[Regions::Size()];
+            memset(from, (i & 127) + 1, sizeof(from));
+            regions->Store(static_cast<size_t>(i * 13) % Regions::Regions(), from, sizeof(from));
+        }
+
+        writer_state = 2;
+        while (reader_ready) {
+        }
+    }};
+
+    std::thread reader{[&] {
+        while (writer_state == 0) {
+        }
+
+        auto shm = util::SharedMemory<Regions>::Create("/watchedregions", sizeof(Regions));
+        if (not shm) {
+            GTEST_FAIL() << "reader could not map memory err=" << shm.error();
+        }
+        auto* regions = shm->Get();
+        reader_ready = true;
+
+        size_t loaded{0};
+        char into[Regions::Size()];
+        auto check = [&](size_t, const char* data) {
+            for (size_t i = 0; i < Regions::Size() - 1; i++) {
+                ASSERT_EQ(data[i], data[i + 1]);
+            }
+            ASSERT_NE(data[0], 0);
+        };
+        while (writer_state == 1) {
+            loaded += regions->LoadChanged(0, into, sizeof(into), check);
+        }
+        loaded += regions->LoadChanged(0, into, sizeof(into), check);
+        reader_ready = false;
+        ASSERT_GT(loaded, 0);
+    }};
+
+    writer.join();
+    reader.join();
+}
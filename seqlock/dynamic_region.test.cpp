@@ -0,0 +1,114 @@
+#include "seqlock/dynamic_region.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+constexpr const char* kRegionFilename = "/dynamicregion";
+
+TEST(DynamicRegion, StoreLoad) {
+    ::shm_unlink(kRegionFilename);
+
+    auto writer = DynamicRegion<mode::SingleWriter>::Create(kRegionFilename, 100);
+    ASSERT_TRUE(writer.has_value()) << writer.error();
+    ASSERT_GE(writer->Capacity(), 100);
+    ASSERT_EQ(writer->Size(), 0);
+
+    std::vector<char> from(100, 7);
+    ASSERT_TRUE(writer->Store(from.data(), from.size()).has_value());
+    ASSERT_EQ(writer->Size(), 100);
+
+    auto reader = DynamicRegion<mode::SingleWriter>::Open(kRegionFilename);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    ASSERT_EQ(reader->Capacity(), writer->Capacity());
+
+    std::vector<char> into(200, 0);
+    auto load_result = reader->Load(into.data(), into.size());
+    ASSERT_TRUE(load_result.has_value()) << load_result.error();
+    ASSERT_EQ(load_result.value(), 100);
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(into[i], 7);
+    }
+    ASSERT_EQ(into[100], 0);
+
+    ASSERT_FALSE(DynamicRegion<mode::SingleWriter>::Open("/dynamicregion-missing").has_value());
+}
+
+TEST(DynamicRegion, ReaderRemapsAfterGrowth) {
+    ::shm_unlink(kRegionFilename);
+
+    auto writer = DynamicRegion<mode::SingleWriter>::Create(kRegionFilename, 64);
+    ASSERT_TRUE(writer.has_value()) << writer.error();
+    auto reader = DynamicRegion<mode::SingleWriter>::Open(kRegionFilename);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+
+    const size_t initial_capacity = writer->Capacity();
+    const uint64_t initial_generation = reader->Generation();
+
+    std::vector<char> from(initial_capacity * 3 + 1, 9);
+    ASSERT_TRUE(writer->Store(from.data(), from.size()).has_value());
+    ASSERT_GE(writer->Capacity(), from.size());
+    ASSERT_EQ(reader->Capacity(), initial_capacity);
+
+    std::vector<char> into(from.size(), 0);
+    auto load_result = reader->Load(into.data(), into.size());
+    ASSERT_TRUE(load_result.has_value()) << load_result.error();
+    ASSERT_EQ(load_result.value(), from.size());
+    ASSERT_EQ(into, from);
+    ASSERT_EQ(reader->Capacity(), writer->Capacity());
+    ASSERT_GT(reader->Generation(), initial_generation);
+
+    // Growing to a smaller capacity does nothing.
+    const size_t capacity = writer->Capacity();
+    ASSERT_TRUE(writer->Grow(1).has_value());
+    ASSERT_EQ(writer->Capacity(), capacity);
+}
+
+TEST(DynamicRegion, MultiThreadGrowWhileReading) {
+    ::shm_unlink(kRegionFilename);
+
+    auto writer = DynamicRegion<mode::SingleWriter>::Create(kRegionFilename, 64);
+    ASSERT_TRUE(writer.has_value()) << writer.error();
+
+    std::atomic<bool> writer_done{false};
+    std::thread reader_thread{[&] {
+        auto reader = DynamicRegion<mode::SingleWriter>::Open(kRegionFilename);
+        ASSERT_TRUE(reader.has_value()) << reader.error();
+
+        std::vector<char> into(1 << 20);
+        size_t max_size{0};
+        while (not writer_done) {
+            auto load_result = reader->Load(into.data(), into.size());
+            ASSERT_TRUE(load_result.has_value()) << load_result.error();
+
+            const size_t size = load_result.value();
+            for (size_t i = 0; i + 1 < size; i++) {
+                ASSERT_EQ(into[i], into[i + 1]);
+            }
+            // Every store writes as many bytes as the value of the bytes, times 4KiB.
+            if (size > 0) {
+                ASSERT_EQ(size, static_cast<size_t>(into[0]) * 4096);
+            }
+            max_size = std::max(max_size, size);
+        }
+        ASSERT_GT(max_size, 0);
+    }};
+
+    std::vector<char> from(1 << 20);
+    for (int round = 0; round < 100; round++) {
+        for (char value = 1; value <= 64; value++) {
+            const size_t size = static_cast<size_t>(value) * 4096;
+            std::fill(from.begin(), from.begin() + static_cast<ptrdiff_t>(size), value);
+            ASSERT_TRUE(writer->Store(from.data(), size).has_value());
+        }
+    }
+    writer_done = true;
+    reader_thread.join();
+}
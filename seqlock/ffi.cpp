@@ -5,6 +5,7 @@
 #include <cstring>
 #include <iostream>
 
+#include "seqlock/dynamic_region.hpp"
 #include "seqlock/seqlock.hpp"
 #include "seqlock/util.hpp"
 
@@ -82,6 +83,161 @@ void seqlock_single_writer_assign(struct SingleWriterSeqLock* wrapper_lock, int
     seqlock->Store([&] { ::memset(wrapper_lock->shared_data, value, wrapper_lock->shared_data_size); });
 }
 
+bool seqlock_single_writer_try_load(struct SingleWriterSeqLock* wrapper_lock, char* dst, size_t size, uint64_t* seq) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    assert(wrapper_lock->shared_data != nullptr);
+    auto* seqlock = static_cast<seqlock::SeqLock<seqlock::mode::SingleWriter>*>(wrapper_lock->lock);
+    uint64_t loaded_seq{0};
+    const bool ok = seqlock->TryLoad([&] {
+        loaded_seq = seqlock->Sequence();
+        ::memcpy(dst, wrapper_lock->shared_data, std::min(wrapper_lock->shared_data_size, size));
+    });
+    if (ok and seq != nullptr) {
+        *seq = loaded_seq;
+    }
+    return ok;
+}
+
+uint64_t seqlock_single_writer_sequence(struct SingleWriterSeqLock* wrapper_lock) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    return static_cast<seqlock::SeqLock<seqlock::mode::SingleWriter>*>(wrapper_lock->lock)->Sequence();
+}
+
+struct MultiWriterSeqLock* seqlock_multi_writer_create_shared(const char* filename, size_t size) {
+    using T = seqlock::SeqLock<seqlock::mode::MultiWriter>;
+
+    // The layout is shared with writers in other languages, see `ffi.h`.
+    static_assert(sizeof(T) == 128, "The data of a multi-writer region must start at offset 128.");
+    static_assert(sizeof(std::atomic_flag) == 1, "The writer lock must be a single byte.");
+
+    const size_t seqlock_size = sizeof(T);
+    size += seqlock_size;
+
+    auto shm_result = seqlock::util::SharedMemory<T>::Create(std::string{filename}, size);
+    if (not shm_result) {
+        std::cout << shm_result.error() << std::endl;
+        return nullptr;
+    }
+    auto* shm = new seqlock::util::SharedMemory<T>(std::move(shm_result.value()));
+
+    auto* wrapper_lock = new struct MultiWriterSeqLock;
+    wrapper_lock->lock = shm->GetRaw();
+    wrapper_lock->shm = static_cast<void*>(shm);
+    wrapper_lock->shared_data = static_cast<void*>(static_cast<std::byte*>(shm->GetRaw()) + seqlock_size);
+    wrapper_lock->shared_data_size = shm->Size() - seqlock_size;
+
+    return wrapper_lock;
+}
+
+void seqlock_multi_writer_destroy(struct MultiWriterSeqLock* wrapper_lock) {
+    using T = seqlock::SeqLock<seqlock::mode::MultiWriter>;
+
+    delete (seqlock::util::SharedMemory<T>*)(wrapper_lock->shm);
+    delete wrapper_lock;
+}
+
+void seqlock_multi_writer_load(struct MultiWriterSeqLock* wrapper_lock, char* dst, size_t size) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    assert(wrapper_lock->shared_data != nullptr);
+    auto* seqlock = static_cast<seqlock::SeqLock<seqlock::mode::MultiWriter>*>(wrapper_lock->lock);
+    seqlock->Load([&] { ::memcpy(dst, wrapper_lock->shared_data, std::min(wrapper_lock->shared_data_size, size)); });
+}
+
+void seqlock_multi_writer_store(struct MultiWriterSeqLock* wrapper_lock, char* src, size_t size) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    assert(wrapper_lock->shared_data != nullptr);
+    auto* seqlock = static_cast<seqlock::SeqLock<seqlock::mode::MultiWriter>*>(wrapper_lock->lock);
+    seqlock->Store([&] { ::memcpy(wrapper_lock->shared_data, src, std::min(wrapper_lock->shared_data_size, size)); });
+}
+
+bool seqlock_multi_writer_try_store(struct MultiWriterSeqLock* wrapper_lock, char* src, size_t size) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    assert(wrapper_lock->shared_data != nullptr);
+    auto* seqlock = static_cast<seqlock::SeqLock<seqlock::mode::MultiWriter>*>(wrapper_lock->lock);
+    return seqlock->TryStore(
+        [&] { ::memcpy(wrapper_lock->shared_data, src, std::min(wrapper_lock->shared_data_size, size)); });
+}
+
+bool seqlock_multi_writer_try_load(struct MultiWriterSeqLock* wrapper_lock, char* dst, size_t size, uint64_t* seq) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    assert(wrapper_lock->shared_data != nullptr);
+    auto* seqlock = static_cast<seqlock::SeqLock<seqlock::mode::MultiWriter>*>(wrapper_lock->lock);
+    uint64_t loaded_seq{0};
+    const bool ok = seqlock->TryLoad([&] {
+        loaded_seq = seqlock->Sequence();
+        ::memcpy(dst, wrapper_lock->shared_data, std::min(wrapper_lock->shared_data_size, size));
+    });
+    if (ok and seq != nullptr) {
+        *seq = loaded_seq;
+    }
+    return ok;
+}
+
+uint64_t seqlock_multi_writer_sequence(struct MultiWriterSeqLock* wrapper_lock) {
+    assert(wrapper_lock != nullptr);
+    assert(wrapper_lock->lock != nullptr);
+    return static_cast<seqlock::SeqLock<seqlock::mode::MultiWriter>*>(wrapper_lock->lock)->Sequence();
+}
+
+struct SingleWriterDynamicRegion {
+    seqlock::DynamicRegion<seqlock::mode::SingleWriter> region;
+};
+
+struct SingleWriterDynamicRegion* seqlock_dynamic_region_create(const char* filename, size_t capacity) {
+    auto region_result = seqlock::DynamicRegion<seqlock::mode::SingleWriter>::Create(std::string{filename}, capacity);
+    if (not region_result) {
+        std::cout << region_result.error() << std::endl;
+        return nullptr;
+    }
+    return new SingleWriterDynamicRegion{std::move(region_result.value())};
+}
+
+struct SingleWriterDynamicRegion* seqlock_dynamic_region_open(const char* filename) {
+    auto region_result = seqlock::DynamicRegion<seqlock::mode::SingleWriter>::Open(std::string{filename});
+    if (not region_result) {
+        std::cout << region_result.error() << std::endl;
+        return nullptr;
+    }
+    return new SingleWriterDynamicRegion{std::move(region_result.value())};
+}
+
+void seqlock_dynamic_region_destroy(struct SingleWriterDynamicRegion* region) { delete region; }
+
+bool seqlock_dynamic_region_load(struct SingleWriterDynamicRegion* region, char* dst, size_t size,
+                                 size_t* region_size) {
+    assert(region != nullptr);
+    auto load_result = region->region.Load(dst, size);
+    if (not load_result) {
+        std::cout << load_result.error() << std::endl;
+        return false;
+    }
+    if (region_size != nullptr) {
+        *region_size = load_result.value();
+    }
+    return true;
+}
+
+bool seqlock_dynamic_region_store(struct SingleWriterDynamicRegion* region, const char* src, size_t size) {
+    assert(region != nullptr);
+    auto store_result = region->region.Store(src, size);
+    if (not store_result) {
+        std::cout << store_result.error() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t seqlock_dynamic_region_capacity(struct SingleWriterDynamicRegion* region) {
+    assert(region != nullptr);
+    return region->region.Capacity();
+}
+
 #ifdef __cplusplus
 }
 #endif
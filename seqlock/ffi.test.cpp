@@ -6,6 +6,7 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "seqlock/seqlock.hpp"
 #include "seqlock/util.hpp"
@@ -144,3 +145,120 @@ TEST(FFI, SingleWriterShared) {
     reader.join();
     writer.join();
 }
+
+TEST(FFI, DynamicRegion) {
+    const char* filename = "/test-dynamic-region";
+    ::shm_unlink(filename);
+
+    auto* writer = seqlock_dynamic_region_create(filename, 16);
+    ASSERT_NE(writer, nullptr);
+    auto* reader = seqlock_dynamic_region_open(filename);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(seqlock_dynamic_region_capacity(reader), seqlock_dynamic_region_capacity(writer));
+
+    // Store more than the initial capacity, the reader remaps on load.
+    const size_t size = seqlock_dynamic_region_capacity(writer) * 2;
+    std::vector<char> from(size, 5);
+    ASSERT_TRUE(seqlock_dynamic_region_store(writer, from.data(), from.size()));
+
+    std::vector<char> into(size, 0);
+    size_t region_size{0};
+    ASSERT_TRUE(seqlock_dynamic_region_load(reader, into.data(), into.size(), &region_size));
+    ASSERT_EQ(region_size, size);
+    ASSERT_EQ(into, from);
+    ASSERT_GE(seqlock_dynamic_region_capacity(reader), size);
+
+    seqlock_dynamic_region_destroy(reader);
+    seqlock_dynamic_region_destroy(writer);
+
+    ASSERT_EQ(seqlock_dynamic_region_open(filename), nullptr);
+}
+
+TEST(FFI, MultiWriterShared) {
+    const char* filename = "/test-multi-writer";
+    ::shm_unlink(filename);
+
+    constexpr size_t kDataSize = 4096 - 128;
+    auto* creator = seqlock_multi_writer_create_shared(filename, kDataSize);
+    ASSERT_NE(creator, nullptr);
+    ASSERT_EQ(creator->shared_data_size, kDataSize);
+
+    // Writers in other languages take the lock by setting the byte at offset 64.
+    auto* lock_byte = static_cast<std::atomic<char>*>(static_cast<void*>(static_cast<char*>(creator->lock) + 64));
+    std::vector<char> from(kDataSize, 1);
+    ASSERT_TRUE(seqlock_multi_writer_try_store(creator, from.data(), from.size()));
+    lock_byte->store(1);
+    ASSERT_FALSE(seqlock_multi_writer_try_store(creator, from.data(), from.size()));
+    lock_byte->store(0);
+    ASSERT_TRUE(seqlock_multi_writer_try_store(creator, from.data(), from.size()));
+
+    // The layout matches a `GuardedRegion` of the same size.
+    using Region = seqlock::GuardedRegion<seqlock::mode::MultiWriter, kDataSize>;
+    auto region_shm = seqlock::util::SharedMemory<Region>::Create(filename, sizeof(Region));
+    ASSERT_TRUE(region_shm.has_value()) << region_shm.error();
+    std::vector<char> into(kDataSize, 0);
+    ASSERT_EQ(region_shm->Get()->Load(into.data(), into.size()), 4);
+    ASSERT_EQ(into, from);
+
+    std::vector<std::thread> writers;
+    for (int w = 1; w <= 4; w++) {
+        writers.emplace_back([&, w] {
+            auto* writer = seqlock_multi_writer_create_shared(filename, kDataSize);
+            ASSERT_NE(writer, nullptr);
+            std::vector<char> buf(kDataSize, static_cast<char>(w));
+            for (int i = 0; i < 10'000; i++) {
+                seqlock_multi_writer_store(writer, buf.data(), buf.size());
+            }
+            seqlock_multi_writer_destroy(writer);
+        });
+    }
+
+    while (region_shm->Get()->Sequence() < 4 + 2 * 40'000) {
+        seqlock_multi_writer_load(creator, into.data(), into.size());
+        for (size_t i = 0; i + 1 < into.size(); i++) {
+            ASSERT_EQ(into[i], into[i + 1]);
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(region_shm->Get()->Sequence(), 4 + 2 * 40'000);
+
+    seqlock_multi_writer_destroy(creator);
+}
+
+TEST(FFI, TryLoad) {
+    const char* filename = "/test-try-load";
+    ::shm_unlink(filename);
+
+    auto* single = seqlock_single_writer_create_shared(filename, kBufferSize);
+    ASSERT_NE(single, nullptr);
+    std::vector<char> from(kBufferSize, 3);
+    std::vector<char> into(kBufferSize, 0);
+    uint64_t seq{1};
+    ASSERT_TRUE(seqlock_single_writer_try_load(single, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 0);
+    seqlock_single_writer_store(single, from.data(), from.size());
+    ASSERT_EQ(seqlock_single_writer_sequence(single), 2);
+    ASSERT_TRUE(seqlock_single_writer_try_load(single, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 2);
+    ASSERT_EQ(into, from);
+
+    // A write in progress makes the load fail.
+    auto* seq_ptr = static_cast<std::atomic<uint64_t>*>(single->lock);
+    seq_ptr->store(3);
+    ASSERT_FALSE(seqlock_single_writer_try_load(single, into.data(), into.size(), nullptr));
+    seq_ptr->store(4);
+    seqlock_single_writer_destroy(single);
+    ::shm_unlink(filename);
+
+    auto* multi = seqlock_multi_writer_create_shared(filename, kBufferSize);
+    ASSERT_NE(multi, nullptr);
+    seqlock_multi_writer_store(multi, from.data(), from.size());
+    ASSERT_EQ(seqlock_multi_writer_sequence(multi), 2);
+    ASSERT_TRUE(seqlock_multi_writer_try_load(multi, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 2);
+    ASSERT_EQ(into, from);
+    seqlock_multi_writer_destroy(multi);
+    ::shm_unlink(filename);
+}
@@ -0,0 +1,89 @@
+#include "seqlock/hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using seqlock::SharedHashMap;
+
+constexpr size_t kCapacity = 1 << 16;
+
+using Map = SharedHashMap<seqlock::mode::SingleWriter, uint64_t, uint64_t, kCapacity>;
+
+std::unique_ptr<Map> map{nullptr};
+std::thread* writer{nullptr};
+std::atomic<bool> writer_done{false};
+
+// Fills the map up to `state.range(0)` percent of its capacity. If `state.range(1)` is non-zero, a writer updates the
+// values of existing keys in a loop while the readers look them up.
+static void BM_SharedHashMapFind(benchmark::State& state) {
+    const auto keys = static_cast<uint64_t>(Map::MaxSize() * state.range(0) / 100);
+
+    if (state.thread_index() == 0) {
+        map = std::make_unique<Map>();
+        for (uint64_t i = 0; i < keys; i++) {
+            map->Upsert(i, i);
+        }
+
+        writer_done.store(false, std::memory_order_relaxed);
+        if (state.range(1) != 0) {
+            writer = new std::thread{[keys] {
+                uint64_t i{0};
+                while (not writer_done.load(std::memory_order_relaxed)) {
+                    map->Upsert(i, i);
+                    i = i + 1 == keys ? 0 : i + 1;
+                }
+            }};
+        }
+    }
+
+    // Look up present keys in a scattered order.
+    uint64_t key = static_cast<uint64_t>(state.thread_index()) * 7919;
+    uint64_t value{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map->Find(key % keys, value));
+        key += 40503;
+    }
+
+    if (state.thread_index() == 0) {
+        if (writer != nullptr) {
+            writer_done.store(true, std::memory_order_relaxed);
+            writer->join();
+            delete writer;
+            writer = nullptr;
+        }
+        map.reset();
+    }
+}
+
+static void BM_SharedHashMapFindMissing(benchmark::State& state) {
+    const auto keys = static_cast<uint64_t>(Map::MaxSize() * state.range(0) / 100);
+
+    if (state.thread_index() == 0) {
+        map = std::make_unique<Map>();
+        for (uint64_t i = 0; i < keys; i++) {
+            map->Upsert(i, i);
+        }
+    }
+
+    uint64_t key = keys;
+    uint64_t value{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map->Find(key++, value));
+    }
+
+    if (state.thread_index() == 0) {
+        map.reset();
+    }
+}
+
+BENCHMARK(BM_SharedHashMapFind)
+    ->ArgsProduct({{10, 25, 50, 75, 90}, {0, 1}})
+    ->ArgNames({"load%", "writer"})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(BM_SharedHashMapFindMissing)->ArgsProduct({{10, 25, 50, 75, 90}})->ArgNames({"load%"})->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,165 @@
+#include "seqlock/hash_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+using Symbol = std::array<char, 16>;
+
+static Symbol MakeSymbol(uint64_t i) {
+    Symbol symbol{};
+    std::snprintf(symbol.data(), symbol.size(), "SYM%llu", static_cast<unsigned long long>(i));  // NOLINT
+    return symbol;
+}
+
+struct Quote {
+    uint64_t id;
+    int64_t bid;
+    int64_t ask;
+};
+
+TEST(SharedHashMap, UpsertFindErase) {
+    auto map = std::make_unique<SharedHashMap<mode::SingleWriter, Symbol, Quote, 64>>();
+    ASSERT_EQ(map->Size(), 0);
+    ASSERT_FALSE(map->Contains(MakeSymbol(1)));
+
+    ASSERT_TRUE(map->Upsert(MakeSymbol(1), Quote{1, 100, 101}));
+    ASSERT_TRUE(map->Upsert(MakeSymbol(2), Quote{2, 200, 201}));
+    ASSERT_EQ(map->Size(), 2);
+
+    Quote quote{};
+    ASSERT_TRUE(map->Find(MakeSymbol(1), quote));
+    ASSERT_EQ(quote.bid, 100);
+
+    ASSERT_TRUE(map->Upsert(MakeSymbol(1), Quote{1, 102, 103}));
+    ASSERT_EQ(map->Size(), 2);
+    ASSERT_TRUE(map->Find(MakeSymbol(1), quote));
+    ASSERT_EQ(quote.bid, 102);
+
+    ASSERT_TRUE(map->Erase(MakeSymbol(1)));
+    ASSERT_FALSE(map->Erase(MakeSymbol(1)));
+    ASSERT_FALSE(map->Contains(MakeSymbol(1)));
+    ASSERT_TRUE(map->Contains(MakeSymbol(2)));
+    ASSERT_EQ(map->Size(), 1);
+}
+
+TEST(SharedHashMap, FullAndTombstoneReuse) {
+    using Map = SharedHashMap<mode::SingleWriter, uint64_t, uint64_t, 16>;
+    auto map = std::make_unique<Map>();
+
+    for (uint64_t i = 0; i < Map::MaxSize(); i++) {
+        ASSERT_TRUE(map->Upsert(i, i * 10));
+    }
+    ASSERT_FALSE(map->Upsert(Map::MaxSize(), 0));
+    ASSERT_FALSE(map->Contains(Map::MaxSize()));
+
+    // Every key is still reachable when the table is full of keys and tombstones.
+    ASSERT_TRUE(map->Erase(3));
+    ASSERT_TRUE(map->Upsert(100, 1000));
+    for (uint64_t i = 0; i < Map::MaxSize(); i++) {
+        uint64_t value{0};
+        if (i == 3) {
+            ASSERT_FALSE(map->Find(i, value));
+        } else {
+            ASSERT_TRUE(map->Find(i, value));
+            ASSERT_EQ(value, i * 10);
+        }
+    }
+    ASSERT_TRUE(map->Contains(100));
+}
+
+TEST(SharedHashMap, MultiThreadReadersSingleWriter) {
+    constexpr uint64_t kKeys = 512;
+    using Map = SharedHashMap<mode::SingleWriter, Symbol, Quote, 1024>;
+    auto map = std::make_unique<Map>();
+
+    std::atomic<bool> writer_done{false};
+    std::thread writer{[&] {
+        for (int round = 0; round < 200; round++) {
+            for (uint64_t i = 0; i < kKeys; i++) {
+                if (round % 3 == 2 and i % 2 == 0) {
+                    map->Erase(MakeSymbol(i));
+                } else {
+                    const auto v = static_cast<int64_t>(i) * 1000 + round;
+                    map->Upsert(MakeSymbol(i), Quote{i, v, v + 1});
+                }
+            }
+        }
+        writer_done = true;
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            size_t found{0};
+            while (not writer_done) {
+                for (uint64_t i = 0; i < kKeys; i++) {
+                    Quote quote{};
+                    if (map->Find(MakeSymbol(i), quote)) {
+                        ASSERT_EQ(quote.id, i);
+                        ASSERT_EQ(quote.ask, quote.bid + 1);
+                        ASSERT_EQ(quote.bid / 1000, static_cast<int64_t>(i));
+                        found++;
+                    }
+                }
+            }
+            ASSERT_GT(found, 0);
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(SharedHashMap, MultiWriter) {
+    constexpr uint64_t kKeysPerWriter = 100;
+    constexpr uint64_t kWriters = 4;
+    using Map = SharedHashMap<mode::MultiWriter, uint64_t, uint64_t, 1024>;
+    auto map = std::make_unique<Map>();
+
+    std::vector<std::thread> writers;
+    for (uint64_t w = 0; w < kWriters; w++) {
+        writers.emplace_back([&, w] {
+            for (uint64_t i = 0; i < kKeysPerWriter; i++) {
+                ASSERT_TRUE(map->Upsert(w * kKeysPerWriter + i, w));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_EQ(map->Size(), kWriters * kKeysPerWriter);
+    for (uint64_t key = 0; key < kWriters * kKeysPerWriter; key++) {
+        uint64_t value{0};
+        ASSERT_TRUE(map->Find(key, value));
+        ASSERT_EQ(value, key / kKeysPerWriter);
+    }
+}
+
+TEST(SharedHashMap, Shm) {
+    using Map = SharedHashMap<mode::SingleWriter, Symbol, Quote, 256>;
+
+    auto writer_shm = util::SharedMemory<Map>::Create("/sharedhashmap", sizeof(Map));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    ASSERT_TRUE(writer_shm->Get()->Upsert(MakeSymbol(42), Quote{42, 1, 2}));
+
+    auto reader_shm = util::SharedMemory<Map>::Create("/sharedhashmap", sizeof(Map));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+
+    Quote quote{};
+    ASSERT_TRUE(reader_shm->Get()->Find(MakeSymbol(42), quote));
+    ASSERT_EQ(quote.id, 42);
+    ASSERT_FALSE(reader_shm->Get()->Contains(MakeSymbol(43)));
+}
@@ -0,0 +1,133 @@
+#include "seqlock/history.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+TEST(VersionedRegion, LoadLatest) {
+    using Region = VersionedRegion<mode::SingleWriter, 64, 4>;
+    auto region = std::make_unique<Region>();
+
+    char into[Region::Size()];
+    ASSERT_EQ(region->Load(into, sizeof(into)), 0);
+
+    for (int i = 1; i <= 10; i++) {
+        region->Set(i);
+        ASSERT_EQ(region->Sequence(), 2 * i);
+        ASSERT_EQ(region->Load(into, sizeof(into)), 2 * i);
+        for (size_t j = 0; j < sizeof(into); j++) {
+            ASSERT_EQ(into[j], i);
+        }
+    }
+}
+
+TEST(VersionedRegion, LoadAsOf) {
+    using Region = VersionedRegion<mode::SingleWriter, 64, 4>;
+    auto region = std::make_unique<Region>();
+
+    char from[Region::Size()];
+    for (int i = 1; i <= 10; i++) {
+        memset(from, i, sizeof(from));
+        region->Store(from, sizeof(from), 1000 * i);
+    }
+
+    char into[Region::Size()];
+    // Versions 7 to 10 are retained.
+    ASSERT_EQ(region->LoadAsOf(14, into, sizeof(into)), 14);
+    ASSERT_EQ(into[0], 7);
+    ASSERT_EQ(region->LoadAsOf(17, into, sizeof(into)), 16);
+    ASSERT_EQ(into[0], 8);
+    ASSERT_EQ(region->LoadAsOf(100, into, sizeof(into)), 20);
+    ASSERT_EQ(into[0], 10);
+    ASSERT_EQ(region->LoadAsOf(12, into, sizeof(into)), 0);
+
+    ASSERT_EQ(region->LoadAsOfTime(9500, into, sizeof(into)), 18);
+    ASSERT_EQ(into[0], 9);
+    ASSERT_EQ(region->LoadAsOfTime(7000, into, sizeof(into)), 14);
+    ASSERT_EQ(into[0], 7);
+    ASSERT_EQ(region->LoadAsOfTime(6999, into, sizeof(into)), 0);
+
+    ASSERT_EQ(region->Timestamp(16), 8000);
+    ASSERT_EQ(region->Timestamp(2), 0);
+}
+
+TEST(VersionedRegion, SlowReaderFastWriter) {
+    constexpr size_t kSize = 64 * 1024;
+    using Region = VersionedRegion<mode::SingleWriter, kSize, 8>;
+    auto region = std::make_unique<Region>();
+    region->Set(1);
+
+    std::atomic<bool> reader_done{false};
+    std::thread writer{[&] {
+        int i{0};
+        while (not reader_done) {
+            region->Set(i++ & 127);
+        }
+    }};
+
+    // Each load copies a version while the writer keeps committing new ones. Loads complete without retrying on every
+    // commit, and always return consistent data.
+    auto into = std::make_unique<char[]>(kSize);
+    uint64_t last_seq{0};
+    for (int i = 0; i < 1000; i++) {
+        const uint64_t seq = region->Load(into.get(), kSize);
+        ASSERT_GE(seq, last_seq);
+        last_seq = seq;
+        for (size_t j = 0; j < kSize - 1; j++) {
+            ASSERT_EQ(into[j], into[j + 1]);
+        }
+    }
+    reader_done = true;
+    writer.join();
+}
+
+TEST(VersionedRegion, MultiWriter) {
+    using Region = VersionedRegion<mode::MultiWriter, 128, 4>;
+    auto region = std::make_unique<Region>();
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; w++) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < 10'000; i++) {
+                region->Set(w);
+            }
+        });
+    }
+
+    char into[Region::Size()];
+    while (region->Sequence() < 2 * 40'000) {
+        if (region->Load(into, sizeof(into)) > 0) {
+            for (size_t j = 0; j < sizeof(into) - 1; j++) {
+                ASSERT_EQ(into[j], into[j + 1]);
+            }
+        }
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(region->Sequence(), 2 * 40'000);
+}
+
+TEST(VersionedRegion, Shm) {
+    using Region = VersionedRegion<mode::SingleWriter, 128, 4>;
+
+    auto writer_shm = util::SharedMemory<Region>::Create("/versionedregion", sizeof(Region));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    writer_shm->Get()->Set(7);
+
+    auto reader_shm = util::SharedMemory<Region>::Create("/versionedregion", sizeof(Region));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+
+    char into[Region::Size()];
+    ASSERT_EQ(reader_shm->Get()->Load(into, sizeof(into)), 2);
+    ASSERT_EQ(into[0], 7);
+}
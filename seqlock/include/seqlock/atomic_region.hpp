@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace seqlock {
+
+/// `AtomicRegion` holds up to 16 bytes, like a best bid and ask or a last price, which are loaded and stored with a
+/// single 16-byte memory access. There is no sequence number and no retry loop: a load always returns a whole version,
+/// and there can be any number of writers, the last store winning. It is meant to be placed in shared memory.
+///
+/// On x86-64, aligned 16-byte SSE loads and stores are guaranteed to be atomic by CPUs supporting AVX, which is checked
+/// once at runtime. Older CPUs fall back to `lock cmpxchg16b`, which is atomic too but makes loads contend with each
+/// other. On AArch64, loads and stores are exclusive pair loops (`ldaxp`/`stxp` and `ldxp`/`stlxp`), which all ARMv8
+/// CPUs support. Other architectures are not supported: the compiler's 16-byte atomics may be implemented with locks
+/// private to each process, which do not protect a region in shared memory.
+template <size_t N>
+class alignas(16) AtomicRegion {
+   private:
+    static_assert(N > 0 and N <= 16, "AtomicRegion holds up to 16 bytes.");
+
+   public:
+    AtomicRegion() = default;
+    ~AtomicRegion() = default;
+
+    // Copy.
+    AtomicRegion(const AtomicRegion&) = delete;
+    AtomicRegion& operator=(const AtomicRegion&) = delete;
+
+    // Move.
+    AtomicRegion(AtomicRegion&&) = delete;
+    AtomicRegion& operator=(AtomicRegion&&) = delete;
+
+    void Store(const char* from, size_t size) noexcept {
+        alignas(16) char value[16]{};
+        std::memcpy(value, from, std::min(size, N));
+        Store16(value);
+    }
+
+    void Load(char* into, size_t size) const noexcept {
+        alignas(16) char value[16];
+        Load16(value);
+        std::memcpy(into, value, std::min(size, N));
+    }
+
+    /// `IsVectorAtomic` returns true if loads and stores are plain vector instructions, which do not contend with each
+    /// other, rather than locked instructions.
+    static bool IsVectorAtomic() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+        static const bool avx = __builtin_cpu_supports("avx");
+        return avx;
+#else
+        return false;
+#endif
+    }
+
+    static constexpr size_t Size() noexcept { return N; }
+
+   private:
+    alignas(16) char data_[16]{};
+
+#if defined(__x86_64__) || defined(_M_X64)
+    void Store16(const char* value) noexcept {
+        const __m128i desired = _mm_load_si128(reinterpret_cast<const __m128i*>(value));
+        if (IsVectorAtomic()) {
+            // Written in assembly, since the compiler may split an intrinsic store into two 8-byte stores. The memory
+            // clobber keeps earlier stores before it.
+            asm volatile("movdqa %1, %0" : "=m"(*reinterpret_cast<__m128i*>(data_)) : "x"(desired) : "memory");
+            return;
+        }
+        uint64_t lo{0};
+        uint64_t hi{0};
+        std::memcpy(&lo, value, 8);
+        std::memcpy(&hi, value + 8, 8);
+        uint64_t expected_lo{0};
+        uint64_t expected_hi{0};
+        while (not CompareExchange16(expected_lo, expected_hi, lo, hi)) {
+        }
+    }
+
+    void Load16(char* value) const noexcept {
+        if (IsVectorAtomic()) {
+            // See `Store16`. The memory clobber keeps later loads after it.
+            __m128i loaded;
+            asm volatile("movdqa %1, %0" : "=x"(loaded) : "m"(*reinterpret_cast<const __m128i*>(data_)) : "memory");
+            _mm_store_si128(reinterpret_cast<__m128i*>(value), loaded);
+            return;
+        }
+        // A failed exchange loads the current value, and a successful one stores the value that was already there.
+        uint64_t lo{0};
+        uint64_t hi{0};
+        const_cast<AtomicRegion*>(this)->CompareExchange16(lo, hi, lo, hi);
+        std::memcpy(value, &lo, 8);
+        std::memcpy(value + 8, &hi, 8);
+    }
+
+    bool CompareExchange16(uint64_t& expected_lo, uint64_t& expected_hi, uint64_t desired_lo,
+                           uint64_t desired_hi) noexcept {
+        bool exchanged{false};
+        asm volatile("lock cmpxchg16b %1"
+                     : "=@ccz"(exchanged), "+m"(data_), "+a"(expected_lo), "+d"(expected_hi)
+                     : "b"(desired_lo), "c"(desired_hi)
+                     : "memory");
+        return exchanged;
+    }
+#elif defined(__aarch64__)
+    void Store16(const char* value) noexcept {
+        uint64_t lo{0};
+        uint64_t hi{0};
+        std::memcpy(&lo, value, 8);
+        std::memcpy(&hi, value + 8, 8);
+        auto& data = *reinterpret_cast<unsigned __int128*>(data_);
+        uint64_t old_lo{0};
+        uint64_t old_hi{0};
+        uint32_t failed{0};
+        do {
+            asm volatile("ldxp %0, %1, %3\n\tstlxp %w2, %4, %5, %3"
+                         : "=&r"(old_lo), "=&r"(old_hi), "=&r"(failed), "+Q"(data)
+                         : "r"(lo), "r"(hi)
+                         : "memory");
+        } while (failed != 0);
+    }
+
+    void Load16(char* value) const noexcept {
+        // A pair load is only single-copy atomic if the exclusive store of the same value back succeeds.
+        auto& data = *reinterpret_cast<unsigned __int128*>(const_cast<char*>(data_));
+        uint64_t lo{0};
+        uint64_t hi{0};
+        uint32_t failed{0};
+        do {
+            asm volatile("ldaxp %0, %1, %3\n\tstxp %w2, %0, %1, %3"
+                         : "=&r"(lo), "=&r"(hi), "=&r"(failed), "+Q"(data)
+                         :
+                         : "memory");
+        } while (failed != 0);
+        std::memcpy(value, &lo, 8);
+        std::memcpy(value + 8, &hi, 8);
+    }
+#else
+    static_assert(N == 0, "AtomicRegion supports x86-64 and AArch64 only.");
+#endif
+};
+
+}  // namespace seqlock
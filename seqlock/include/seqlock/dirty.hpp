@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `DirtyBitmap` tracks which of `Bits` regions changed since a consumer last looked. Writers call `Mark` after they
+/// commit a region. Each of the `Consumers` consumers owns a private copy of the bitmap, so consumers never steal
+/// each other's notifications and `Collect` can clear what it consumed.
+///
+/// Each consumer's bitmap has two levels: one bit per region and one summary bit per 64-bit word of region bits.
+/// `Collect` only visits words whose summary bit is set, so finding the few changed regions out of 20k costs a handful
+/// of loads instead of one sequence load per region.
+///
+/// A notification is never lost: a `Mark` racing with a `Collect` is either reported by that `Collect` or by the next
+/// one. A region might be reported twice (once spuriously) in that case, so consumers should treat a notification as
+/// "something might have changed".
+///
+/// Like `SeqLock`, `DirtyBitmap` can be placed in shared memory.
+template <size_t Bits, size_t Consumers = 1>
+class DirtyBitmap {
+   private:
+    static_assert(Bits > 0, "DirtyBitmap must track at least one region.");
+    static_assert(Consumers > 0, "DirtyBitmap must have at least one consumer.");
+
+    using WordT = std::atomic<uint64_t>;
+
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t kWords = (Bits + kWordBits - 1) / kWordBits;
+    static constexpr size_t kSummaryWords = (kWords + kWordBits - 1) / kWordBits;
+
+   public:
+    DirtyBitmap() { static_assert(WordT::is_always_lock_free, "Bitmap word type must be lock-free."); }
+    ~DirtyBitmap() = default;
+
+    DirtyBitmap(const DirtyBitmap&) = delete;
+    DirtyBitmap& operator=(const DirtyBitmap&) = delete;
+
+    DirtyBitmap(DirtyBitmap&&) = delete;
+    DirtyBitmap& operator=(DirtyBitmap&&) = delete;
+
+    /// `Mark` flags the region at `index` as changed for all consumers. Writers must call `Mark` after the store to the
+    /// region has committed, such that a consumer that sees the flag also sees the new version of the region.
+    void Mark(size_t index) noexcept {
+        assert(index < Bits);
+
+        const size_t word = index / kWordBits;
+        const uint64_t bit = 1ULL << (index % kWordBits);
+        const uint64_t summary_bit = 1ULL << (word % kWordBits);
+        for (auto& consumer : consumers_) {
+            // The region bit must be visible before the summary bit, see `Collect`. Both are set unconditionally:
+            // skipping a bit that looks set might race with a `Collect` clearing it and lose the notification.
+            consumer.words[word].fetch_or(bit, std::memory_order_release);
+            consumer.summary[word / kWordBits].fetch_or(summary_bit, std::memory_order_release);
+        }
+    }
+
+    /// `Collect` calls `fn(index)` for every region marked since the last `Collect` of `consumer`, in increasing index
+    /// order, and clears the marks it reported. Returns the number of reported regions.
+    ///
+    /// Only one thread may call `Collect` for a given consumer at a time.
+    template <typename FnT>
+    size_t Collect(size_t consumer, FnT&& fn) noexcept {
+        assert(consumer < Consumers);
+
+        auto& bitmap = consumers_[consumer];
+        size_t collected{0};
+        for (size_t i = 0; i < kSummaryWords; i++) {
+            if (bitmap.summary[i].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+
+            // The summary bit is cleared before the region bits. A `Mark` that lands in between sets the summary bit
+            // again, so it is reported by the next `Collect` at the latest.
+            uint64_t summary = bitmap.summary[i].exchange(0, std::memory_order_acquire);
+            while (summary != 0) {
+                const size_t word = i * kWordBits + static_cast<size_t>(std::countr_zero(summary));
+                summary &= summary - 1;
+
+                uint64_t bits = bitmap.words[word].exchange(0, std::memory_order_acquire);
+                while (bits != 0) {
+                    fn(word * kWordBits + static_cast<size_t>(std::countr_zero(bits)));
+                    bits &= bits - 1;
+                    collected++;
+                }
+            }
+        }
+        return collected;
+    }
+
+    /// `Pending` returns true if `consumer` has at least one region to `Collect`. It might return a false positive if
+    /// it races with `Collect`.
+    bool Pending(size_t consumer) const noexcept {
+        assert(consumer < Consumers);
+
+        for (const auto& word : consumers_[consumer].summary) {
+            if (word.load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr size_t Size() noexcept { return Bits; }
+
+   private:
+    // Each consumer's bitmap starts on its own cache line such that consumers clearing their marks do not contend.
+    struct alignas(64) Consumer {
+        WordT summary[kSummaryWords]{};
+        WordT words[kWords]{};
+    };
+
+    Consumer consumers_[Consumers]{};
+};
+
+/// `WatchedRegions` is an array of `Count` regions of N bytes, each guarded by its own `SeqLock`, paired with a
+/// `DirtyBitmap` that is marked on every store. A consumer that monitors thousands of regions calls `LoadChanged` to
+/// get consistent loads of only the regions that changed since its last call.
+template <mode::Mode ModeT, size_t N, size_t Count, size_t Consumers = 1>
+class WatchedRegions {
+   public:
+    WatchedRegions() = default;
+    ~WatchedRegions() = default;
+
+    // Copy.
+    WatchedRegions(const WatchedRegions&) = delete;
+    WatchedRegions& operator=(const WatchedRegions&) = delete;
+
+    // Move.
+    WatchedRegions(WatchedRegions&&) = delete;
+    WatchedRegions& operator=(WatchedRegions&&) = delete;
+
+    void Set(size_t index, int v) {
+        regions_[index].Set(v);
+        dirty_.Mark(index);
+    }
+
+    void Store(size_t index, const char* from, size_t size) {
+        regions_[index].Store(from, size);
+        dirty_.Mark(index);
+    }
+
+    /// `Load` copies the region at `index` into `into` and returns the sequence number of the copied version.
+    uint64_t Load(size_t index, char* into, size_t size) const { return regions_[index].Load(into, size); }
+
+    /// `LoadChanged` loads every region that changed since the last `LoadChanged` of `consumer` into `into` and calls
+    /// `fn(index, into)` after each load, or `fn(index, into, seq)` to also get the sequence number of the loaded
+    /// version. Returns the number of loaded regions.
+    template <typename FnT>
+    size_t LoadChanged(size_t consumer, char* into, size_t size, FnT&& fn) {
+        return dirty_.Collect(consumer, [&](size_t index) {
+            const uint64_t seq = regions_[index].Load(into, size);
+            if constexpr (std::invocable<FnT&, size_t, const char*, uint64_t>) {
+                fn(index, static_cast<const char*>(into), seq);
+            } else {
+                fn(index, static_cast<const char*>(into));
+            }
+        });
+    }
+
+    const DirtyBitmap<Count, Consumers>& Dirty() const noexcept { return dirty_; }
+    DirtyBitmap<Count, Consumers>& Dirty() noexcept { return dirty_; }
+
+    static constexpr size_t Size() noexcept { return N; }
+    static constexpr size_t Regions() noexcept { return Count; }
+
+   private:
+    GuardedRegion<ModeT, N> regions_[Count];
+    DirtyBitmap<Count, Consumers> dirty_;
+};
+
+}  // namespace seqlock
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <string>
+#include <utility>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/util.hpp"
+
+namespace seqlock {
+
+/// The header of a `DynamicRegion`, placed at the start of its memory-shared file. The data follows the header.
+template <mode::Mode ModeT>
+struct DynamicRegionHeader {
+    explicit DynamicRegionHeader(uint64_t initial_capacity) : capacity{initial_capacity} {}
+
+    SeqLock<ModeT> lock;
+
+    // The number of data bytes available in the file. Only grows.
+    std::atomic<uint64_t> capacity;
+
+    // Bumped every time `capacity` grows, telling readers to remap.
+    std::atomic<uint64_t> generation{0};
+
+    // The number of data bytes held by the region, guarded by `lock`.
+    uint64_t size{0};
+};
+
+/// `DynamicRegion` is a memory-shared region whose size is set at runtime and which can grow while readers are
+/// attached, unlike `GuardedRegion` whose size is a template parameter.
+///
+/// When a writer stores more bytes than the region can hold, it grows the memory-shared file, remaps it and publishes
+/// the new capacity by bumping the generation number in the header. Readers notice the new generation on their next
+/// `Load` and transparently remap the file. The file only ever grows, so the mappings of readers that did not remap
+/// yet stay valid for the bytes they know of.
+///
+/// Unlike the other types in this library, `DynamicRegion` is a per-process handle that owns its mapping and is not
+/// placed in shared memory itself. It is movable but not thread-safe: each thread needs its own handle.
+template <mode::Mode ModeT>
+class DynamicRegion {
+   private:
+    using Header = DynamicRegionHeader<ModeT>;
+    using Shm = util::SharedMemory<Header, uint64_t>;
+
+    static_assert(sizeof(Header) % 64 == 0, "The data must start on a new cache line.");
+
+   public:
+    /// `Create` creates a region in a new memory-shared file that holds up to `capacity` bytes before growing. The
+    /// capacity is rounded up to the page size. Use `Open` to attach to an existing region.
+    static std::expected<DynamicRegion, std::string> Create(const std::string& filename, size_t capacity) {
+        const auto page_size_result = util::RoundToPageSize(sizeof(Header) + capacity);
+        if (not page_size_result) {
+            return std::unexpected(page_size_result.error());
+        }
+        const size_t size = page_size_result.value();
+
+        auto shm_result = Shm::Create(filename, size, size - sizeof(Header));
+        if (not shm_result) {
+            return std::unexpected(shm_result.error());
+        }
+        return DynamicRegion{std::move(shm_result.value())};
+    }
+
+    /// `Open` attaches to an existing region, whatever its current capacity.
+    static std::expected<DynamicRegion, std::string> Open(const std::string& filename) {
+        auto shm_result = Shm::Open(filename);
+        if (not shm_result) {
+            return std::unexpected(shm_result.error());
+        }
+
+        DynamicRegion region{std::move(shm_result.value())};
+        if (auto remap_result = region.Refresh(); not remap_result) {
+            return std::unexpected(remap_result.error());
+        }
+        return region;
+    }
+
+    ~DynamicRegion() = default;
+
+    // Copy.
+    DynamicRegion(const DynamicRegion&) = delete;
+    DynamicRegion& operator=(const DynamicRegion&) = delete;
+
+    // Move.
+    DynamicRegion(DynamicRegion&&) noexcept = default;
+    DynamicRegion& operator=(DynamicRegion&&) = delete;
+
+    /// `Store` copies `size` bytes from `from` into the region. If the region cannot hold `size` bytes, it first grows
+    /// to at least twice its capacity.
+    std::expected<void, std::string> Store(const char* from, size_t size) {
+        if (auto refresh_result = Refresh(); not refresh_result) {
+            return refresh_result;
+        }
+        if (size > capacity_) {
+            if (auto grow_result = Grow(std::max(size, 2 * capacity_)); not grow_result) {
+                return grow_result;
+            }
+        }
+
+        Header* header = shm_.Get();
+        char* data = Data();
+        header->lock.Store([&] {
+            std::memcpy(data, from, size);
+            header->size = size;
+        });
+        return {};
+    }
+
+    /// `Load` copies the region into `into`, up to `size` bytes, and returns the number of bytes held by the region.
+    /// If the region grew since the last call, the file is remapped first.
+    std::expected<size_t, std::string> Load(char* into, size_t size) {
+        while (true) {
+            if (auto refresh_result = Refresh(); not refresh_result) {
+                return std::unexpected(refresh_result.error());
+            }
+
+            const Header* header = shm_.Get();
+            const char* data = Data();
+            size_t region_size{0};
+            bool stale{false};
+            const bool ok = header->lock.TryLoad([&] {
+                region_size = header->size;
+                // The writer grew the region after the generation check above, so the data is not all mapped here.
+                stale = region_size > capacity_;
+                if (not stale) {
+                    std::memcpy(into, data, std::min(size, region_size));
+                }
+            });
+            if (ok and not stale) {
+                return region_size;
+            }
+        }
+    }
+
+    /// `Grow` grows the region such that it holds at least `capacity` bytes. Does nothing if the region is already
+    /// large enough.
+    std::expected<void, std::string> Grow(size_t capacity) {
+        if (auto refresh_result = Refresh(); not refresh_result) {
+            return refresh_result;
+        }
+        if (capacity <= capacity_) {
+            return {};
+        }
+
+        if (auto resize_result = shm_.Resize(sizeof(Header) + capacity); not resize_result) {
+            return resize_result;
+        }
+        capacity_ = shm_.Size() - sizeof(Header);
+
+        // Publish the capacity before the generation, such that readers seeing the new generation remap to at least
+        // this capacity. Concurrent writers in other processes might grow the file further, so keep the maximum.
+        Header* header = shm_.Get();
+        uint64_t published = header->capacity.load(std::memory_order_relaxed);
+        while (published < capacity_ and
+               not header->capacity.compare_exchange_weak(published, capacity_, std::memory_order_relaxed)) {
+        }
+        header->generation.fetch_add(1, std::memory_order_release);
+        generation_ = header->generation.load(std::memory_order_relaxed);
+        return {};
+    }
+
+    /// `Size` returns the number of bytes held by the region. The returned value might be stale if there is a
+    /// concurrent `Store`.
+    size_t Size() const noexcept {
+        uint64_t size{0};
+        shm_.Get()->lock.Load([&] { size = shm_.Get()->size; });
+        return size;
+    }
+
+    /// `Capacity` returns the number of bytes the region can hold as mapped by this handle.
+    size_t Capacity() const noexcept { return capacity_; }
+
+    uint64_t Generation() const noexcept { return generation_; }
+
+    uint64_t Sequence() const noexcept { return shm_.Get()->lock.Sequence(); }
+
+   private:
+    Shm shm_;
+    size_t capacity_;
+    uint64_t generation_;
+
+    explicit DynamicRegion(Shm&& shm)
+        : shm_{std::move(shm)},
+          capacity_{shm_.Size() - sizeof(Header)},
+          generation_{shm_.Get()->generation.load(std::memory_order_acquire)} {}
+
+    char* Data() noexcept { return static_cast<char*>(shm_.GetRaw()) + sizeof(Header); }
+    const char* Data() const noexcept { return static_cast<const char*>(shm_.GetRaw()) + sizeof(Header); }
+
+    // Remaps the file if another handle grew it since the last call.
+    std::expected<void, std::string> Refresh() {
+        const Header* header = shm_.Get();
+        const uint64_t generation = header->generation.load(std::memory_order_acquire);
+        const uint64_t capacity = header->capacity.load(std::memory_order_relaxed);
+        if (generation == generation_ and capacity <= capacity_) {
+            return {};
+        }
+
+        if (capacity > capacity_) {
+            if (auto resize_result = shm_.Resize(sizeof(Header) + capacity); not resize_result) {
+                return resize_result;
+            }
+            capacity_ = shm_.Size() - sizeof(Header);
+        }
+        generation_ = generation;
+        return {};
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/spinlock.hpp"
+
+namespace seqlock {
+
+/// `BytesHash` hashes the object representation of `T` with 64-bit FNV-1a. Unlike `std::hash`, the result only depends
+/// on the bytes of the key, so all processes sharing a map agree on where a key lives.
+template <typename T>
+struct BytesHash {
+    static_assert(std::has_unique_object_representations_v<T>, "Key type must not have padding bytes.");
+
+    uint64_t operator()(const T& key) const noexcept {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&key);  // NOLINT
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
+/// `SharedHashMap` is a fixed-capacity open-addressing hash map meant to live in shared memory, for example to look up
+/// regions by symbol across processes. Readers in any process do lock-free `Find`s which retry if they race with a
+/// writer. Writers are synchronized as in `SeqLock`: a single writer is wait-free, and multiple writers
+/// (`mode::MultiWriter`) take turns through a map-wide spin-lock.
+///
+/// Slots are grouped by 8. Each group is guarded by its own `SeqLock` sequence, so a `Find` only retries if the writer
+/// touches one of the groups it probes, and a write only invalidates readers of one group. Groups are probed linearly.
+/// `Erase` leaves a tombstone which is reused by later inserts, such that probe chains are never broken for concurrent
+/// readers.
+///
+/// Keys and values must be trivially copyable, and keys are compared byte-wise: the map is placed in shared memory
+/// and both are copied with `memcpy`.
+template <mode::Mode ModeT, typename KeyT, typename ValueT, size_t Capacity, typename HashT = BytesHash<KeyT>>
+class SharedHashMap {
+   private:
+    static_assert(std::is_trivially_copyable_v<KeyT>, "Key type must be trivially copyable.");
+    static_assert(std::is_trivially_copyable_v<ValueT>, "Value type must be trivially copyable.");
+    static_assert(Capacity > 0, "SharedHashMap must have a non-zero capacity.");
+
+    static constexpr size_t kGroupSize = 8;
+    static constexpr size_t kGroups = (Capacity + kGroupSize - 1) / kGroupSize;
+
+    enum SlotState : uint8_t { kEmpty = 0, kFull = 1, kTombstone = 2 };
+
+    struct Group {
+        SeqLock<mode::SingleWriter> lock;
+        uint8_t states[kGroupSize]{};
+        KeyT keys[kGroupSize];
+        ValueT values[kGroupSize];
+    };
+
+    enum class Probe { kFound, kAbsent, kNext };
+
+   public:
+    SharedHashMap() = default;
+    ~SharedHashMap() = default;
+
+    // Copy.
+    SharedHashMap(const SharedHashMap&) = delete;
+    SharedHashMap& operator=(const SharedHashMap&) = delete;
+
+    // Move.
+    SharedHashMap(SharedHashMap&&) = delete;
+    SharedHashMap& operator=(SharedHashMap&&) = delete;
+
+    /// `Find` copies the value of `key` into `value` and returns true if `key` is in the map. Otherwise, `value` is
+    /// left untouched and false is returned.
+    bool Find(const KeyT& key, ValueT& value) const noexcept {
+        size_t group = HashT{}(key) % kGroups;
+        for (size_t probes = 0; probes < kGroups; probes++) {
+            Probe probe{Probe::kNext};
+            ValueT found;
+            groups_[group].lock.Load([&] {
+                probe = Probe::kNext;
+                for (size_t i = 0; i < kGroupSize; i++) {
+                    const uint8_t state = groups_[group].states[i];
+                    if (state == kEmpty) {
+                        probe = Probe::kAbsent;
+                        return;
+                    }
+                    if (state == kFull and std::memcmp(&groups_[group].keys[i], &key, sizeof(KeyT)) == 0) {
+                        std::memcpy(&found, &groups_[group].values[i], sizeof(ValueT));
+                        probe = Probe::kFound;
+                        return;
+                    }
+                }
+            });
+
+            if (probe == Probe::kFound) {
+                value = found;
+                return true;
+            }
+            if (probe == Probe::kAbsent) {
+                return false;
+            }
+            group = group + 1 == kGroups ? 0 : group + 1;
+        }
+        return false;
+    }
+
+    bool Contains(const KeyT& key) const noexcept {
+        ValueT value;
+        return Find(key, value);
+    }
+
+    /// `Upsert` inserts `key` with `value` or updates the value of `key` if it is already in the map. Returns false if
+    /// the map is full and `key` is not in the map.
+    bool Upsert(const KeyT& key, const ValueT& value) noexcept {
+        return Exclusive([&] {
+            const auto [group, slot, found] = Locate(key);
+            if (group == kGroups) {
+                return false;
+            }
+
+            auto& g = groups_[group];
+            g.lock.Store([&] {
+                std::memcpy(&g.values[slot], &value, sizeof(ValueT));
+                if (not found) {
+                    std::memcpy(&g.keys[slot], &key, sizeof(KeyT));
+                    g.states[slot] = kFull;
+                }
+            });
+            if (not found) {
+                size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            return true;
+        });
+    }
+
+    /// `Erase` removes `key` from the map. Returns false if `key` is not in the map.
+    bool Erase(const KeyT& key) noexcept {
+        return Exclusive([&] {
+            const auto [group, slot, found] = Locate(key);
+            if (not found) {
+                return false;
+            }
+
+            auto& g = groups_[group];
+            g.lock.Store([&] { g.states[slot] = kTombstone; });
+            size_.store(size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    /// `Size` returns the number of keys in the map.
+    size_t Size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t MaxSize() noexcept { return kGroups * kGroupSize; }
+
+   private:
+    Group groups_[kGroups];
+    std::atomic<size_t> size_{0};
+
+    // Define the `SpinLock` only if there can be multiple writers. Otherwise, it occupies 0 bytes as in `SeqLock`.
+    [[no_unique_address]] std::conditional_t<not std::is_same_v<ModeT, mode::SingleWriter>, SpinLock, std::monostate>
+        writer_lock_{};
+
+    template <typename FnT>
+    bool Exclusive(FnT&& fn) noexcept {
+        if constexpr (not std::is_same_v<ModeT, mode::SingleWriter>) {
+            bool result{false};
+            writer_lock_([&] { result = fn(); });
+            return result;
+        } else {
+            return fn();
+        }
+    }
+
+    struct Location {
+        size_t group;
+        size_t slot;
+        bool found;
+    };
+
+    // Returns the slot holding `key` or, if `key` is absent, the first free slot on its probe chain. `group` is
+    // `kGroups` if the map is full. Only called by the writer holding exclusive access, so the groups are stable.
+    Location Locate(const KeyT& key) const noexcept {
+        Location free{kGroups, 0, false};
+        size_t group = HashT{}(key) % kGroups;
+        for (size_t probes = 0; probes < kGroups; probes++) {
+            const auto& g = groups_[group];
+            for (size_t i = 0; i < kGroupSize; i++) {
+                if (g.states[i] == kFull) {
+                    if (std::memcmp(&g.keys[i], &key, sizeof(KeyT)) == 0) {
+                        return {group, i, true};
+                    }
+                    continue;
+                }
+
+                if (free.group == kGroups) {
+                    free = {group, i, false};
+                }
+                if (g.states[i] == kEmpty) {
+                    return free;
+                }
+            }
+            group = group + 1 == kGroups ? 0 : group + 1;
+        }
+        return free;
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `VersionedRegion` is a `GuardedRegion` that keeps the last K committed versions of its N bytes in a ring, each
+/// tagged with its commit sequence number and a wall-clock timestamp. Like `GuardedRegion`, it can be placed in shared
+/// memory.
+///
+/// A reader of a `GuardedRegion` retries whenever a write lands during its copy, so a slow reader can livelock under a
+/// fast writer. A reader of a `VersionedRegion` copies the version it targeted, which is only overwritten K - 1 commits
+/// later. Readers can also ask for the value as of a given sequence number or point in time, as long as it is one of
+/// the last K versions.
+///
+/// Sequence numbers are those of a `SeqLock`: the n-th commit has the sequence number 2n, and 0 means no version was
+/// committed yet.
+template <mode::Mode ModeT, size_t N, size_t K>
+class VersionedRegion {
+   private:
+    static_assert(K >= 2, "VersionedRegion must keep at least 2 versions.");
+
+    struct Version {
+        SeqLock<mode::SingleWriter> lock;
+        uint64_t seq{0};
+        int64_t timestamp_ns{0};
+        char data[N]{};
+    };
+
+   public:
+    VersionedRegion() = default;
+    ~VersionedRegion() = default;
+
+    // Copy.
+    VersionedRegion(const VersionedRegion&) = delete;
+    VersionedRegion& operator=(const VersionedRegion&) = delete;
+
+    // Move.
+    VersionedRegion(VersionedRegion&&) = delete;
+    VersionedRegion& operator=(VersionedRegion&&) = delete;
+
+    void Set(int v) {
+        Commit(Now(), [&](char* data) { std::memset(data, v, N); });
+    }
+
+    /// `Store` commits a new version holding the first `size` bytes of `from`, timestamped with the current time.
+    void Store(char* from, size_t size) { Store(from, size, Now()); }
+
+    /// `Store` commits a new version holding the first `size` bytes of `from`, timestamped with `timestamp_ns`
+    /// nanoseconds since the epoch. Timestamps must not decrease from one version to the next.
+    void Store(char* from, size_t size, int64_t timestamp_ns) {
+        Commit(timestamp_ns, [&](char* data) { std::memcpy(data, from, std::min(size, N)); });
+    }
+
+    /// `Load` copies the latest version into `into` and returns its sequence number, or returns 0 if there is no
+    /// version yet.
+    uint64_t Load(char* into, size_t size) const {
+        while (true) {
+            const uint64_t seq = LatestSequence();
+            if (seq == 0) {
+                return 0;
+            }
+            // Fails only if the version was overwritten during the copy, in which case a newer one is available.
+            if (TryLoadVersion(seq, into, size)) {
+                return seq;
+            }
+        }
+    }
+
+    /// `LoadAsOf` copies the version that was current when the sequence number was `seq`, that is the latest version
+    /// with a sequence number <= `seq`. Returns the sequence number of the copied version, or 0 if that version is not
+    /// retained anymore or does not exist.
+    uint64_t LoadAsOf(uint64_t seq, char* into, size_t size) const {
+        seq &= ~1ULL;
+        if (seq >= LatestSequence()) {
+            return Load(into, size);
+        }
+        return TryLoadVersion(seq, into, size) ? seq : 0;
+    }
+
+    /// `LoadAsOfTime` copies the latest version with a timestamp <= `timestamp_ns`. Returns the sequence number of the
+    /// copied version, or 0 if no retained version is old enough.
+    uint64_t LoadAsOfTime(int64_t timestamp_ns, char* into, size_t size) const {
+        const uint64_t latest = LatestSequence();
+        const uint64_t oldest = latest > 2 * (K - 1) ? latest - 2 * (K - 1) : 2;
+        for (uint64_t seq = latest; seq >= oldest and seq > 0; seq -= 2) {
+            const auto& version = At(seq);
+
+            bool match{false};
+            const bool ok = version.lock.TryLoad([&] {
+                match = version.seq == seq and version.timestamp_ns <= timestamp_ns;
+                if (match) {
+                    std::memcpy(into, version.data, std::min(size, N));
+                }
+            });
+            if (not ok) {
+                // Only the oldest versions are overwritten, so everything older than this one is gone as well.
+                return 0;
+            }
+            if (match) {
+                return seq;
+            }
+        }
+        return 0;
+    }
+
+    /// `Timestamp` returns the timestamp of the version with sequence number `seq`, or 0 if it is not retained.
+    int64_t Timestamp(uint64_t seq) const {
+        int64_t timestamp_ns{0};
+        const auto& version = At(seq);
+        version.lock.Load([&] { timestamp_ns = version.seq == seq ? version.timestamp_ns : 0; });
+        return timestamp_ns;
+    }
+
+    /// `Sequence` returns the sequence number of the latest committed version, or of the version being committed.
+    uint64_t Sequence() const noexcept { return lock_.Sequence(); }
+
+    /// `NextUpdate` returns an awaitable which completes once a version newer than `last_seq` is committed. See
+    /// `SeqLock::NextUpdate`.
+    UpdateAwaiter NextUpdate(uint64_t last_seq) const noexcept { return lock_.NextUpdate(last_seq); }
+
+    static constexpr size_t Size() noexcept { return N; }
+    static constexpr size_t Versions() noexcept { return K; }
+
+   private:
+    // Writers are serialized through `lock_` as in a `GuardedRegion`. Its sequence number is the sequence number of the
+    // version being written. Readers never retry on `lock_`, only on the lock of the version they copy.
+    SeqLock<ModeT> lock_;
+    Version versions_[K];
+
+    static int64_t Now() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    const Version& At(uint64_t seq) const noexcept { return versions_[(seq / 2) % K]; }
+
+    uint64_t LatestSequence() const noexcept { return lock_.Sequence() & ~1ULL; }
+
+    template <typename StoreFnT>
+    void Commit(int64_t timestamp_ns, StoreFnT&& store_fn) {
+        lock_.Store([&] {
+            const uint64_t seq = lock_.Sequence() + 1;
+            auto& version = versions_[(seq / 2) % K];
+            version.lock.Store([&] {
+                version.seq = seq;
+                version.timestamp_ns = timestamp_ns;
+                store_fn(version.data);
+            });
+        });
+    }
+
+    bool TryLoadVersion(uint64_t seq, char* into, size_t size) const {
+        const auto& version = At(seq);
+
+        bool match{false};
+        const bool ok = version.lock.TryLoad([&] {
+            match = version.seq == seq;
+            if (match) {
+                std::memcpy(into, version.data, std::min(size, N));
+            }
+        });
+        return ok and match;
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `LaneRegion` holds one `T` per writer, for state that is naturally per producer like per-gateway fill counters or
+/// per-venue quotes. Each writer owns a lane: a cache-line aligned `GuardedRegion` with its own single-writer sequence
+/// number. Writers thus never contend with each other, unlike writers funnelled through a `SeqLock<mode::MultiWriter>`.
+/// Like `GuardedRegion`, it can be placed in shared memory.
+///
+/// Readers merge the lanes with `Fold`. Each lane is read consistently, but lanes are independent of each other: a
+/// merged view might combine versions of different lanes that were never current at the same time. A `LaneView` only
+/// reloads the lanes that changed since its last refresh.
+///
+/// Lanes that were never stored to are skipped. `T` must be trivially copyable, as it is shared between processes.
+template <typename T, size_t Lanes>
+class LaneRegion {
+   private:
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    struct alignas(64) Lane {
+        GuardedRegion<mode::SingleWriter, sizeof(T)> region;
+    };
+
+   public:
+    LaneRegion() = default;
+    ~LaneRegion() = default;
+
+    // Copy.
+    LaneRegion(const LaneRegion&) = delete;
+    LaneRegion& operator=(const LaneRegion&) = delete;
+
+    // Move.
+    LaneRegion(LaneRegion&&) = delete;
+    LaneRegion& operator=(LaneRegion&&) = delete;
+
+    /// `Store` stores `value` in `lane`. Only the owner of the lane may store to it.
+    void Store(size_t lane, const T& value) noexcept {
+        lanes_[lane].region.Store(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /// `Update` stores `fn(value)` in `lane`, where `value` starts as the current value of the lane, or
+    /// value-initialized if there is none. Only the owner of the lane may update it: as the lane's only writer, its
+    /// loads never retry.
+    template <typename FnT>
+    void Update(size_t lane, FnT&& fn) noexcept {
+        T value{};
+        if (Sequence(lane) != 0) {
+            Load(lane, value);
+        }
+        fn(value);
+        Store(lane, value);
+    }
+
+    /// `Load` copies the value of `lane` into `into` and returns its sequence number, 0 if the lane was never stored
+    /// to.
+    uint64_t Load(size_t lane, T& into) const noexcept {
+        return lanes_[lane].region.Load(reinterpret_cast<char*>(&into), sizeof(T));
+    }
+
+    /// `Fold` loads every lane that was stored to and returns `fn(...fn(fn(init, value_0), value_1)..., value_n)`.
+    template <typename AccT, typename FnT>
+    AccT Fold(AccT init, FnT&& fn) const {
+        AccT acc = std::move(init);
+        T value;
+        for (size_t lane = 0; lane < Lanes; lane++) {
+            if (Load(lane, value) != 0) {
+                acc = fn(std::move(acc), value);
+            }
+        }
+        return acc;
+    }
+
+    /// `Sequence` returns the current sequence number of `lane`.
+    uint64_t Sequence(size_t lane) const noexcept { return lanes_[lane].region.Sequence(); }
+
+    static constexpr size_t Size() noexcept { return Lanes; }
+
+   private:
+    Lane lanes_[Lanes];
+};
+
+/// `LaneView` is a reader's process-local copy of a `LaneRegion`. `Refresh` reloads only the lanes whose sequence
+/// number changed, so a reader pays for the lanes that were updated rather than for all of them.
+template <typename T, size_t Lanes>
+class LaneView {
+   public:
+    explicit LaneView(const LaneRegion<T, Lanes>& region) : region_{region} {}
+    ~LaneView() = default;
+
+    // Copy.
+    LaneView(const LaneView&) = delete;
+    LaneView& operator=(const LaneView&) = delete;
+
+    // Move.
+    LaneView(LaneView&&) = delete;
+    LaneView& operator=(LaneView&&) = delete;
+
+    /// `Refresh` reloads the lanes that changed since the last refresh, and returns their number.
+    size_t Refresh() noexcept {
+        size_t changed{0};
+        for (size_t lane = 0; lane < Lanes; lane++) {
+            if (const uint64_t seq = region_.Sequence(lane); seq != seqs_[lane] and (seq & 1) == 0) {
+                seqs_[lane] = region_.Load(lane, values_[lane]);
+                changed++;
+            }
+        }
+        return changed;
+    }
+
+    /// `Fold` folds the copied lanes, like `LaneRegion::Fold`, without loading anything from the region.
+    template <typename AccT, typename FnT>
+    AccT Fold(AccT init, FnT&& fn) const {
+        AccT acc = std::move(init);
+        for (size_t lane = 0; lane < Lanes; lane++) {
+            if (seqs_[lane] != 0) {
+                acc = fn(std::move(acc), values_[lane]);
+            }
+        }
+        return acc;
+    }
+
+    /// `Get` returns the copy of `lane` as of the last refresh.
+    const T& Get(size_t lane) const noexcept { return values_[lane]; }
+
+    /// `Sequence` returns the sequence number of the copy of `lane`, 0 if the lane was never stored to.
+    uint64_t Sequence(size_t lane) const noexcept { return seqs_[lane]; }
+
+   private:
+    const LaneRegion<T, Lanes>& region_;
+    uint64_t seqs_[Lanes]{};
+    T values_[Lanes]{};
+};
+
+}  // namespace seqlock
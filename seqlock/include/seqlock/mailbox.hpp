@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `MailboxRegion` is a single-writer `GuardedRegion` whose readers cannot be starved by a fast writer. A reader that
+/// fails to copy the region within its retry budget posts a request in its mailbox slot, and the writer copies the
+/// current version into the slot between two stores. The reader then copies the slot, which the writer no longer
+/// touches, so its load completes whatever the write rate.
+///
+/// The writer serves at most `budget` requests per `Store`, which bounds the extra work of a store to `budget` copies
+/// of the region. Requests left over are served by the next stores, in round-robin order, or by `Serve`.
+///
+/// Each reader uses its own slot, from 0 to `Slots - 1`. Like `GuardedRegion`, it can be placed in shared memory.
+template <size_t N, size_t Slots = 8>
+class MailboxRegion {
+   private:
+    static_assert(Slots > 0 and Slots <= 64, "MailboxRegion has between 1 and 64 slots.");
+
+    struct alignas(64) Slot {
+        // Written by the reader: the ticket of its last request.
+        std::atomic<uint64_t> requested{0};
+        // Written by the writer: the ticket of the last request whose copy is complete.
+        alignas(64) std::atomic<uint64_t> served{0};
+        uint64_t seq{0};
+        char data[N];
+    };
+
+   public:
+    MailboxRegion() = default;
+    ~MailboxRegion() = default;
+
+    // Copy.
+    MailboxRegion(const MailboxRegion&) = delete;
+    MailboxRegion& operator=(const MailboxRegion&) = delete;
+
+    // Move.
+    MailboxRegion(MailboxRegion&&) = delete;
+    MailboxRegion& operator=(MailboxRegion&&) = delete;
+
+    /// `Store` stores the first `size` bytes of `from`, then serves up to `budget` pending requests.
+    void Store(const char* from, size_t size, size_t budget = 1) {
+        region_.Store(from, size);
+        Serve(budget);
+    }
+
+    /// `Serve` copies the current version into up to `budget` slots with a pending request and returns their number.
+    /// Only the writer may call it, for example while it has nothing to store.
+    size_t Serve(size_t budget) {
+        uint64_t pending = pending_.load(std::memory_order_acquire);
+        size_t served{0};
+        while (pending != 0 and served < budget) {
+            // Round-robin from the slot after the last one served, so no reader waits behind the others forever.
+            const uint64_t rotated = std::rotr(pending, static_cast<int>(next_slot_));
+            const size_t index = (next_slot_ + static_cast<size_t>(std::countr_zero(rotated))) % 64;
+            const uint64_t bit = uint64_t{1} << index;
+            pending &= ~bit;
+            next_slot_ = (index + 1) % Slots;
+
+            // Cleared before the copy: a request posted from now on sets the bit again and is served by a later call.
+            pending_.fetch_and(~bit, std::memory_order_acq_rel);
+            Slot& slot = slots_[index];
+            const uint64_t ticket = slot.requested.load(std::memory_order_relaxed);
+            if (ticket == slot.served.load(std::memory_order_relaxed)) {
+                // Already served, the bit was set again by the same request.
+                continue;
+            }
+            // As the only writer, nothing interferes with this load.
+            slot.seq = region_.Load(slot.data, N);
+            slot.served.store(ticket, std::memory_order_release);
+            served++;
+        }
+        return served;
+    }
+
+    /// `Load` copies the region into `into` and returns the sequence number of the copied version. If `retries` direct
+    /// copies fail, it requests a copy from the writer in `slot` and returns whichever completes first: a direct copy
+    /// or the writer's. Sets `assisted`, if given, to whether the writer's copy was used.
+    uint64_t Load(size_t slot, char* into, size_t size, size_t retries, bool* assisted = nullptr) {
+        uint64_t seq{0};
+        for (size_t i = 0; i < retries; i++) {
+            if (region_.TryLoad(into, size, &seq)) {
+                SetAssisted(assisted, false);
+                return seq;
+            }
+        }
+        Request(slot);
+        while (true) {
+            if (TryCollect(slot, into, size, &seq)) {
+                SetAssisted(assisted, true);
+                return seq;
+            }
+            if (region_.TryLoad(into, size, &seq)) {
+                SetAssisted(assisted, false);
+                return seq;
+            }
+        }
+    }
+
+    /// `Request` posts a request for a copy in `slot`, replacing any request still pending there. For readers that do
+    /// not block in `Load` and collect the copy later with `TryCollect`.
+    void Request(size_t slot) noexcept {
+        Slot& s = slots_[slot];
+        s.requested.store(s.requested.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        pending_.fetch_or(uint64_t{1} << slot, std::memory_order_release);
+    }
+
+    /// `TryCollect` copies the writer's copy from `slot` into `into` and returns true, if the writer served the last
+    /// request of the slot. Sets `seq`, if given, to the sequence number of the copied version.
+    bool TryCollect(size_t slot, char* into, size_t size, uint64_t* seq = nullptr) const noexcept {
+        const Slot& s = slots_[slot];
+        const uint64_t ticket = s.requested.load(std::memory_order_relaxed);
+        if (ticket == 0 or s.served.load(std::memory_order_acquire) != ticket) {
+            return false;
+        }
+        std::memcpy(into, s.data, std::min(size, N));
+        if (seq != nullptr) {
+            *seq = s.seq;
+        }
+        return true;
+    }
+
+    /// `Pending` returns the number of requests the writer did not serve yet.
+    size_t Pending() const noexcept { return std::popcount(pending_.load(std::memory_order_relaxed)); }
+
+    /// `Sequence` returns the current sequence number of the region.
+    uint64_t Sequence() const noexcept { return region_.Sequence(); }
+
+    static constexpr size_t Size() noexcept { return N; }
+
+   private:
+    GuardedRegion<mode::SingleWriter, N> region_;
+
+    // One bit per slot with a request posted since the writer last looked at it.
+    alignas(64) std::atomic<uint64_t> pending_{0};
+    // The writer's round-robin position.
+    size_t next_slot_{0};
+
+    Slot slots_[Slots];
+
+    static void SetAssisted(bool* assisted, bool value) noexcept {
+        if (assisted != nullptr) {
+            *assisted = value;
+        }
+    }
+};
+
+}  // namespace seqlock
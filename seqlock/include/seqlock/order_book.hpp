@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// A price level of an order book. A level with a zero `quantity` is empty.
+struct Level {
+    int64_t price;
+    int64_t quantity;
+};
+
+enum class Side : uint8_t { kBid, kAsk };
+
+/// The actions of an incremental price-level feed. Levels are addressed by their 0-based depth: 0 is the best level.
+/// `kAdd` inserts a level and shifts the worse levels down, `kModify` replaces a level in place and `kDelete` removes a
+/// level and shifts the worse levels up.
+enum class Action : uint8_t { kAdd, kModify, kDelete };
+
+struct LevelUpdate {
+    Side side;
+    Action action;
+    uint16_t depth;
+    Level level;
+};
+
+struct TopOfBook {
+    Level bid;
+    Level ask;
+};
+
+/// A consistent copy of all levels of an `OrderBook`. Unused levels are empty.
+template <size_t Depth>
+struct BookSnapshot {
+    Level bids[Depth];
+    Level asks[Depth];
+};
+
+/// `OrderBook` is a fixed-depth price-level book guarded by a `SeqLock`, meant to be placed in shared memory. The
+/// writer applies incremental level updates in place, readers get a consistent top-of-book, top-N or full snapshot.
+///
+/// Bid and ask levels of the same depth are interleaved, 2 depths per cache line. Reading the top of the book touches a
+/// single cache line besides the sequence number, and modifying a level dirties only the cache line holding it. Adding
+/// or deleting a level dirties only the cache lines from its depth to the last used depth.
+template <mode::Mode ModeT, size_t Depth>
+class OrderBook {
+   private:
+    static_assert(Depth > 0, "OrderBook must have at least one level.");
+
+    struct alignas(32) LevelPair {
+        Level bid;
+        Level ask;
+    };
+
+   public:
+    OrderBook() { std::memset(static_cast<void*>(levels_), 0, sizeof(levels_)); }
+    ~OrderBook() = default;
+
+    // Copy.
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    // Move.
+    OrderBook(OrderBook&&) = delete;
+    OrderBook& operator=(OrderBook&&) = delete;
+
+    /// `Apply` applies a single update. Returns false and leaves the book untouched if the update's depth is out of
+    /// bounds.
+    bool Apply(const LevelUpdate& update) noexcept {
+        if (update.depth >= Depth) {
+            return false;
+        }
+        lock_.Store([&] { ApplyUnsynchronized(update); });
+        return true;
+    }
+
+    /// `Apply` applies a batch of updates atomically: readers see either none or all of them. Updates with an
+    /// out-of-bounds depth are skipped. Returns the number of applied updates.
+    size_t Apply(std::span<const LevelUpdate> updates) noexcept {
+        size_t applied{0};
+        lock_.Store([&] {
+            for (const auto& update : updates) {
+                if (update.depth < Depth) {
+                    ApplyUnsynchronized(update);
+                    applied++;
+                }
+            }
+        });
+        return applied;
+    }
+
+    /// `Clear` empties all levels.
+    void Clear() noexcept {
+        lock_.Store([&] {
+            std::memset(static_cast<void*>(levels_), 0, sizeof(levels_));
+            counts_[0] = 0;
+            counts_[1] = 0;
+        });
+    }
+
+    /// `Top` returns the best bid and ask.
+    TopOfBook Top() const noexcept {
+        TopOfBook top;
+        lock_.Load([&] { std::memcpy(&top, &levels_[0], sizeof(top)); });
+        return top;
+    }
+
+    /// `Top` copies the best `n` bid and ask levels into `bids` and `asks`, which must hold at least `n` levels. `n` is
+    /// capped at `Depth`. Returns the number of copied levels per side.
+    size_t Top(size_t n, Level* bids, Level* asks) const noexcept {
+        n = std::min(n, Depth);
+        lock_.Load([&] {
+            for (size_t i = 0; i < n; i++) {
+                bids[i] = levels_[i].bid;
+                asks[i] = levels_[i].ask;
+            }
+        });
+        return n;
+    }
+
+    /// `Snapshot` copies all levels into `into`.
+    void Snapshot(BookSnapshot<Depth>& into) const noexcept { Top(Depth, into.bids, into.asks); }
+
+    uint64_t Sequence() const noexcept { return lock_.Sequence(); }
+
+    static constexpr size_t MaxDepth() noexcept { return Depth; }
+
+   private:
+    SeqLock<ModeT> lock_;
+    LevelPair levels_[Depth];
+
+    // Used levels per side, indexed by `Side`. Only accessed by writers.
+    uint16_t counts_[2]{0, 0};
+
+    Level& At(Side side, size_t depth) noexcept {
+        return side == Side::kBid ? levels_[depth].bid : levels_[depth].ask;
+    }
+
+    void ApplyUnsynchronized(const LevelUpdate& update) noexcept {
+        auto& count = counts_[static_cast<size_t>(update.side)];
+        const size_t depth = update.depth;
+
+        switch (update.action) {
+            case Action::kAdd: {
+                // Shift the worse levels down, dropping the worst one if the book is full.
+                const size_t last = std::min<size_t>(count, Depth - 1);
+                for (size_t i = last; i > depth; i--) {
+                    At(update.side, i) = At(update.side, i - 1);
+                }
+                At(update.side, depth) = update.level;
+                count = static_cast<uint16_t>(std::min<size_t>(std::max<size_t>(count, depth) + 1, Depth));
+                break;
+            }
+            case Action::kModify: {
+                At(update.side, depth) = update.level;
+                count = static_cast<uint16_t>(std::max<size_t>(count, depth + 1));
+                break;
+            }
+            case Action::kDelete: {
+                if (depth >= count) {
+                    break;
+                }
+                for (size_t i = depth; i + 1 < count; i++) {
+                    At(update.side, i) = At(update.side, i + 1);
+                }
+                At(update.side, count - 1) = Level{0, 0};
+                count--;
+                break;
+            }
+        }
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `ParallelCopier` splits the copy of a large region across the calling thread and a pool of helper threads, so that
+/// a multi-megabyte snapshot completes between two writes instead of being invalidated by nearly every one of them.
+///
+/// The whole copy runs between the two sequence number loads of a single `TryLoad`: the caller hands a chunk to each
+/// helper, copies the first chunk itself, and waits for the helpers before checking the sequence number. The snapshot
+/// is thus validated as a whole, as with a single-threaded copy.
+///
+/// Helpers spin for `spins` iterations waiting for work, yielding the CPU now and then, then sleep until the next copy.
+/// A copier serves one caller at a time.
+class ParallelCopier {
+   public:
+    /// The number of parallel copies `Load` attempts before copying on the calling thread alone. Helpers that cannot
+    /// run alongside the caller, on a single CPU or a loaded machine, may otherwise keep every copy from completing
+    /// between two writes.
+    static constexpr int kParallelAttempts = 4;
+
+   private:
+    struct alignas(64) Helper {
+        // The generation of the last copy the helper completed.
+        std::atomic<uint64_t> done{0};
+        std::thread thread;
+    };
+
+   public:
+    explicit ParallelCopier(size_t helpers, uint64_t spins = 1 << 16) : spins_{spins} {
+        for (size_t i = 0; i < helpers; i++) {
+            helpers_.push_back(std::make_unique<Helper>());
+        }
+        for (size_t i = 0; i < helpers; i++) {
+            helpers_[i]->thread = std::thread{[this, i] { Run(i); }};
+        }
+    }
+
+    ~ParallelCopier() {
+        stop_.store(true, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+        for (auto& helper : helpers_) {
+            helper->thread.join();
+        }
+    }
+
+    // Copy.
+    ParallelCopier(const ParallelCopier&) = delete;
+    ParallelCopier& operator=(const ParallelCopier&) = delete;
+
+    // Move.
+    ParallelCopier(ParallelCopier&&) = delete;
+    ParallelCopier& operator=(ParallelCopier&&) = delete;
+
+    /// `Copy` copies `size` bytes from `from` into `into` with all the threads.
+    void Copy(char* into, const char* from, size_t size) noexcept {
+        into_ = into;
+        from_ = from;
+        size_ = size;
+        const uint64_t generation = generation_.fetch_add(1, std::memory_order_release) + 1;
+        generation_.notify_all();
+
+        CopyChunk(0);
+
+        for (const auto& helper : helpers_) {
+            for (uint64_t spins = 1; helper->done.load(std::memory_order_acquire) != generation; spins++) {
+                if (spins % 1024 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    /// `TryLoad` tries to copy `region` into `into` once, like `GuardedRegion::TryLoad`.
+    template <mode::Mode ModeT, size_t N>
+    bool TryLoad(const GuardedRegion<ModeT, N>& region, char* into, size_t size, uint64_t* seq = nullptr) noexcept {
+        return region.TryLoadWith([&](const char* data) { Copy(into, data, std::min(size, N)); }, seq);
+    }
+
+    /// `Load` copies `region` into `into` and returns the sequence number of the copied version, like
+    /// `GuardedRegion::Load`. After `kParallelAttempts` failed attempts, it copies on the calling thread alone.
+    template <mode::Mode ModeT, size_t N>
+    uint64_t Load(const GuardedRegion<ModeT, N>& region, char* into, size_t size) noexcept {
+        uint64_t seq{0};
+        for (int attempt = 0; attempt < kParallelAttempts; attempt++) {
+            if (TryLoad(region, into, size, &seq)) {
+                return seq;
+            }
+        }
+        while (not region.TryLoad(into, size, &seq)) {
+        }
+        return seq;
+    }
+
+    /// `Threads` returns the number of threads sharing a copy, including the caller.
+    size_t Threads() const noexcept { return helpers_.size() + 1; }
+
+   private:
+    std::vector<std::unique_ptr<Helper>> helpers_;
+    uint64_t spins_;
+
+    // The copy in progress, published to the helpers by incrementing `generation_`.
+    alignas(64) std::atomic<uint64_t> generation_{0};
+    std::atomic<bool> stop_{false};
+    char* into_{nullptr};
+    const char* from_{nullptr};
+    size_t size_{0};
+
+    void Run(size_t index) {
+        Helper& helper = *helpers_[index];
+        uint64_t last{0};
+        while (true) {
+            uint64_t generation = generation_.load(std::memory_order_acquire);
+            for (uint64_t spins = 1; generation == last; spins++) {
+                if (spins >= spins_) {
+                    generation_.wait(last, std::memory_order_acquire);
+                } else if (spins % 1024 == 0) {
+                    // Lets the caller run when the threads share CPUs.
+                    std::this_thread::yield();
+                }
+                generation = generation_.load(std::memory_order_acquire);
+            }
+            if (stop_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            last = generation;
+            CopyChunk(index + 1);
+            helper.done.store(generation, std::memory_order_release);
+        }
+    }
+
+    void CopyChunk(size_t chunk) const noexcept {
+        // Chunks are cache-line aligned so that threads do not share lines of `into`.
+        const size_t chunk_size = (size_ / Threads() + 64) / 64 * 64;
+        const size_t begin = std::min(chunk * chunk_size, size_);
+        const size_t end = std::min(begin + chunk_size, size_);
+        std::memcpy(into_ + begin, from_ + begin, end - begin);
+    }
+};
+
+}  // namespace seqlock
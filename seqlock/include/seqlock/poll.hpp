@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+class PollScheduler;
+
+/// `PollTask` is the return type of coroutines run by a `PollScheduler`. A `PollTask` is lazy: its body starts
+/// executing only after it is handed to `PollScheduler::Spawn`, which then owns the coroutine.
+///
+/// Since the body starts late, the sequence number to wait from must be taken before spawning the task: taken in the
+/// body, it would miss the updates committed in between. For example:
+///
+/// ```cpp
+/// PollTask Consume(const GuardedRegion<mode::SingleWriter, 64>& region, uint64_t seq) {
+///     while (true) {
+///         seq = co_await region.NextUpdate(seq);
+///         // ... region.Load(...)
+///     }
+/// }
+///
+/// scheduler.Spawn(Consume(region, region.Sequence()));
+/// ```
+class PollTask {
+   public:
+    class promise_type {
+       public:
+        PollTask get_return_object() noexcept {
+            return PollTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+        /// Called by `UpdateAwaiter` when the coroutine suspends waiting for an update.
+        void Park(UpdateAwaiter& awaiter, std::coroutine_handle<> handle) noexcept;
+
+       private:
+        friend class PollScheduler;
+
+        PollScheduler* scheduler_{nullptr};
+    };
+
+    PollTask() = delete;
+    ~PollTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Copy.
+    PollTask(const PollTask&) = delete;
+    PollTask& operator=(const PollTask&) = delete;
+
+    // Move.
+    PollTask(PollTask&& other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+    PollTask& operator=(PollTask&&) = delete;
+
+   private:
+    friend class PollScheduler;
+
+    explicit PollTask(std::coroutine_handle<promise_type> handle) noexcept : handle_{handle} {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/// `PollScheduler` is a single-threaded busy-poll executor for `PollTask` coroutines waiting on `SeqLock` or
+/// `GuardedRegion` updates through `NextUpdate`. It replaces one spinning reader thread per region with one thread
+/// that checks the sequence numbers of all awaited regions in a tight loop and resumes only the coroutines whose
+/// region changed.
+///
+/// All coroutines run on the thread that calls `Run` or `RunOnce`. For the lowest latency, pin that thread to an
+/// isolated core, see `util::PinThisThread`. Only `Stop` may be called from other threads.
+class PollScheduler {
+   public:
+    PollScheduler() = default;
+    ~PollScheduler() {
+        for (auto handle : ready_) {
+            handle.destroy();
+        }
+        for (auto& parked : parked_) {
+            parked.handle.destroy();
+        }
+    }
+
+    // Copy.
+    PollScheduler(const PollScheduler&) = delete;
+    PollScheduler& operator=(const PollScheduler&) = delete;
+
+    // Move.
+    PollScheduler(PollScheduler&&) = delete;
+    PollScheduler& operator=(PollScheduler&&) = delete;
+
+    /// `Spawn` takes ownership of `task`. The task starts running on the next `Run` or `RunOnce`.
+    void Spawn(PollTask task) {
+        auto handle = std::exchange(task.handle_, nullptr);
+        handle.promise().scheduler_ = this;
+        ready_.push_back(handle);
+    }
+
+    /// `RunOnce` resumes all runnable coroutines once, then checks every parked coroutine and makes the ones whose
+    /// update arrived runnable. Returns the number of resumed coroutines.
+    size_t RunOnce() {
+        const size_t resumed = ready_.size();
+
+        // Coroutines resumed below might park themselves again, and become ready on the next pass.
+        running_.swap(ready_);
+        for (auto handle : running_) {
+            handle.resume();
+            if (handle.done()) {
+                handle.destroy();
+            }
+        }
+        running_.clear();
+
+        for (size_t i = 0; i < parked_.size();) {
+            if (parked_[i].awaiter->Ready()) {
+                ready_.push_back(parked_[i].handle);
+                parked_[i] = parked_.back();
+                parked_.pop_back();
+            } else {
+                i++;
+            }
+        }
+
+        return resumed;
+    }
+
+    /// `Run` calls `RunOnce` until all spawned coroutines are done or `Stop` is called.
+    void Run() {
+        while (Pending() > 0 and not stop_.load(std::memory_order_relaxed)) {
+            RunOnce();
+        }
+    }
+
+    /// `Stop` makes `Run` return after its current pass. Coroutines that did not finish stay parked and are destroyed
+    /// with the scheduler.
+    void Stop() noexcept { stop_.store(true, std::memory_order_relaxed); }
+
+    /// `Pending` returns the number of coroutines that did not finish yet.
+    size_t Pending() const noexcept { return ready_.size() + parked_.size(); }
+
+   private:
+    friend class PollTask::promise_type;
+
+    struct Parked {
+        UpdateAwaiter* awaiter;
+        std::coroutine_handle<> handle;
+    };
+
+    std::vector<std::coroutine_handle<>> ready_;
+    std::vector<std::coroutine_handle<>> running_;
+    std::vector<Parked> parked_;
+    std::atomic<bool> stop_{false};
+};
+
+inline void PollTask::promise_type::Park(UpdateAwaiter& awaiter, std::coroutine_handle<> handle) noexcept {
+    scheduler_->parked_.push_back({&awaiter, handle});
+}
+
+}  // namespace seqlock
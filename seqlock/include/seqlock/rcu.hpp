@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/spinlock.hpp"
+
+namespace seqlock {
+
+/// `OffsetPtr` points to an object in an `Arena` by its offset from the start of the arena's blocks. Unlike a raw
+/// pointer, the offset is the same in every process that maps the arena, so it can be stored in shared memory.
+template <typename T>
+class OffsetPtr {
+   public:
+    static constexpr uint64_t kNull = UINT64_MAX;
+
+    OffsetPtr() = default;
+    explicit OffsetPtr(uint64_t offset) : offset_{offset} {}
+
+    bool IsNull() const noexcept { return offset_ == kNull; }
+    uint64_t Offset() const noexcept { return offset_; }
+
+    template <typename ArenaT>
+    T* Get(ArenaT& arena) const noexcept {
+        return IsNull() ? nullptr : static_cast<T*>(arena.At(offset_));
+    }
+
+    template <typename ArenaT>
+    const T* Get(const ArenaT& arena) const noexcept {
+        return IsNull() ? nullptr : static_cast<const T*>(arena.At(offset_));
+    }
+
+    bool operator==(const OffsetPtr&) const = default;
+
+   private:
+    uint64_t offset_{kNull};
+};
+
+/// `Arena` is a fixed-capacity pool of `Blocks` blocks of at least `BlockSize` bytes, meant to be placed in shared
+/// memory. Blocks are cache-line aligned and addressed through `OffsetPtr`s. `Arena` is not thread-safe: callers must
+/// serialize `Allocate` and `Free`.
+template <size_t BlockSize, size_t Blocks>
+class Arena {
+   private:
+    static constexpr size_t kBlockSize = (BlockSize + 63) / 64 * 64;
+    static constexpr uint32_t kEnd = UINT32_MAX;
+
+    static_assert(Blocks > 0 and Blocks < kEnd, "Arena must have between 1 and 2^32 - 1 blocks.");
+
+   public:
+    Arena() {
+        for (size_t i = 0; i < Blocks; i++) {
+            next_[i] = i + 1 < Blocks ? static_cast<uint32_t>(i + 1) : kEnd;
+        }
+    }
+    ~Arena() = default;
+
+    // Copy.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Move.
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    /// `Allocate` returns a free block for a `T`, or a null pointer if all blocks are in use. The block is not
+    /// initialized.
+    template <typename T>
+    OffsetPtr<T> Allocate() noexcept {
+        static_assert(sizeof(T) <= kBlockSize and alignof(T) <= 64, "T does not fit in a block.");
+        if (free_head_ == kEnd) {
+            return {};
+        }
+        const uint32_t block = free_head_;
+        free_head_ = next_[block];
+        available_--;
+        return OffsetPtr<T>{block * kBlockSize};
+    }
+
+    template <typename T>
+    void Free(OffsetPtr<T> ptr) noexcept {
+        const auto block = static_cast<uint32_t>(ptr.Offset() / kBlockSize);
+        next_[block] = free_head_;
+        free_head_ = block;
+        available_++;
+    }
+
+    void* At(uint64_t offset) noexcept { return &blocks_[offset]; }
+    const void* At(uint64_t offset) const noexcept { return &blocks_[offset]; }
+
+    size_t Available() const noexcept { return available_; }
+
+    static constexpr size_t Capacity() noexcept { return Blocks; }
+
+   private:
+    alignas(64) std::byte blocks_[Blocks * kBlockSize];
+    uint32_t next_[Blocks];
+    uint32_t free_head_{0};
+    size_t available_{Blocks};
+};
+
+/// `RcuRegion` publishes immutable versions of a `T` too large to be copied on every read, like a full-depth book or a
+/// reference data table. It is meant to be placed in shared memory.
+///
+/// Versions live in an `Arena` of `Versions` blocks. A writer builds the next version in a free block, then swaps the
+/// publication cell, guarded by a `SeqLock`, to point to it. Readers access the current version in place, without
+/// copying it, for as long as they hold a `ReadGuard`. Epoch-based reclamation returns a replaced version to the arena
+/// once no reader can still reference it.
+///
+/// Each reader registers to get one of `MaxReaders` slots, where it announces the epoch at which it started reading.
+/// A reader that holds a guard for long keeps every version replaced since from being reclaimed, so the writer might
+/// run out of blocks: `Update` then returns false until the reader releases its guard.
+///
+/// `T` must be trivially copyable, as it is shared between processes.
+template <mode::Mode ModeT, typename T, size_t Versions, size_t MaxReaders>
+class RcuRegion {
+   private:
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+    static_assert(Versions >= 2, "RcuRegion must have room for at least 2 versions.");
+
+    struct Cell {
+        OffsetPtr<T> current;
+        uint64_t version{0};
+    };
+
+    struct alignas(64) Slot {
+        // 0 if the slot is free, the id of the owner otherwise.
+        std::atomic<uint64_t> id{0};
+
+        // The epoch at which the owner started reading, or 0 if it is not reading.
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    struct Retired {
+        OffsetPtr<T> ptr;
+        uint64_t epoch;
+    };
+
+   public:
+    /// `ReadGuard` gives access to the version that was current when it was created. The version is not reclaimed
+    /// before the guard is destroyed.
+    class ReadGuard {
+       public:
+        ~ReadGuard() noexcept {
+            if (slot_ != nullptr) {
+                slot_->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        // Copy.
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        // Move.
+        ReadGuard(ReadGuard&& other) noexcept
+            : slot_{std::exchange(other.slot_, nullptr)}, value_{other.value_}, version_{other.version_} {}
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        /// `Get` returns the version, or nullptr if no version was published yet.
+        const T* Get() const noexcept { return value_; }
+        const T* operator->() const noexcept { return value_; }
+        const T& operator*() const noexcept { return *value_; }
+
+        /// `Version` returns the number of the version, 1 for the first published version and 0 if there is none.
+        uint64_t Version() const noexcept { return version_; }
+
+       private:
+        friend class RcuRegion;
+
+        Slot* slot_;
+        const T* value_;
+        uint64_t version_;
+
+        ReadGuard(Slot* slot, const T* value, uint64_t version) : slot_{slot}, value_{value}, version_{version} {}
+    };
+
+    /// `Reader` is a reader's handle on its slot. The slot is released when the handle is destroyed. A reader holds at
+    /// most one `ReadGuard` at a time.
+    class Reader {
+       public:
+        ~Reader() noexcept {
+            if (region_ != nullptr) {
+                region_->slots_[slot_].id.store(0, std::memory_order_release);
+            }
+        }
+
+        // Copy.
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        // Move.
+        Reader(Reader&& other) noexcept : region_{std::exchange(other.region_, nullptr)}, slot_{other.slot_} {}
+        Reader& operator=(Reader&&) = delete;
+
+        /// `Read` returns a guard on the current version.
+        ReadGuard Read() const noexcept { return region_->Read(slot_); }
+
+       private:
+        friend class RcuRegion;
+
+        const RcuRegion* region_;
+        size_t slot_;
+
+        Reader(const RcuRegion* region, size_t slot) : region_{region}, slot_{slot} {}
+    };
+
+    RcuRegion() = default;
+    ~RcuRegion() = default;
+
+    // Copy.
+    RcuRegion(const RcuRegion&) = delete;
+    RcuRegion& operator=(const RcuRegion&) = delete;
+
+    // Move.
+    RcuRegion(RcuRegion&&) = delete;
+    RcuRegion& operator=(RcuRegion&&) = delete;
+
+    /// `Register` claims a free reader slot for the reader `id`, which must not be 0.
+    std::expected<Reader, std::string> Register(uint64_t id) const noexcept {
+        if (id == 0) {
+            return std::unexpected("Reader id must not be 0.");
+        }
+        for (size_t i = 0; i < MaxReaders; i++) {
+            uint64_t free{0};
+            if (slots_[i].id.compare_exchange_strong(free, id, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return Reader{this, i};
+            }
+        }
+        return std::unexpected(std::format("All {} reader slots are taken.", MaxReaders));
+    }
+
+    /// `Update` publishes a new version built by `fn(next)`, where `next` starts as a copy of the current version, or
+    /// value-initialized if there is none. Returns false, without calling `fn`, if there is no free block even after
+    /// reclaiming the versions no reader references anymore.
+    template <typename FnT>
+    bool Update(FnT&& fn) {
+        return Exclusive([&] {
+            OffsetPtr<T> next = AllocateLocked();
+            if (next.IsNull()) {
+                return false;
+            }
+
+            const Cell cell = cell_;
+            T* value = next.Get(arena_);
+            if (cell.current.IsNull()) {
+                new (value) T{};
+            } else {
+                new (value) T{*cell.current.Get(arena_)};
+            }
+            fn(*value);
+
+            PublishLocked(next, cell);
+            return true;
+        });
+    }
+
+    /// `Publish` publishes a copy of `value` as the new version. Returns false if there is no free block.
+    bool Publish(const T& value) {
+        return Exclusive([&] {
+            OffsetPtr<T> next = AllocateLocked();
+            if (next.IsNull()) {
+                return false;
+            }
+            new (next.Get(arena_)) T{value};
+            PublishLocked(next, cell_);
+            return true;
+        });
+    }
+
+    /// `Reclaim` returns the replaced versions that no reader references anymore to the arena, and returns their
+    /// number. Writers reclaim by themselves when they run out of blocks.
+    size_t Reclaim() {
+        size_t reclaimed{0};
+        Exclusive([&] {
+            reclaimed = ReclaimLocked();
+            return true;
+        });
+        return reclaimed;
+    }
+
+    /// `Version` returns the number of published versions.
+    uint64_t Version() const noexcept {
+        uint64_t version{0};
+        lock_.Load([&] { version = cell_.version; });
+        return version;
+    }
+
+    /// `FreeVersions` returns the number of versions that can be published before reclaiming.
+    size_t FreeVersions() const noexcept { return arena_.Available(); }
+
+    static constexpr size_t MaxVersions() noexcept { return Versions; }
+
+   private:
+    // Only written by writers, under `writer_lock_` if there are several of them. Readers only read `cell_` through
+    // `lock_`.
+    SeqLock<mode::SingleWriter> lock_;
+    Cell cell_;
+
+    alignas(64) std::atomic<uint64_t> epoch_{1};
+    mutable Slot slots_[MaxReaders];
+
+    Arena<sizeof(T), Versions> arena_;
+    Retired retired_[Versions];
+    size_t retired_count_{0};
+
+    // Define the `SpinLock` only if there can be multiple writers, as in `SharedHashMap`.
+    [[no_unique_address]] std::conditional_t<not std::is_same_v<ModeT, mode::SingleWriter>, SpinLock, std::monostate>
+        writer_lock_{};
+
+    template <typename FnT>
+    bool Exclusive(FnT&& fn) {
+        if constexpr (not std::is_same_v<ModeT, mode::SingleWriter>) {
+            bool result{false};
+            writer_lock_([&] { result = fn(); });
+            return result;
+        } else {
+            return fn();
+        }
+    }
+
+    ReadGuard Read(size_t index) const noexcept {
+        Slot& slot = slots_[index];
+
+        // Announce the epoch before loading the cell. The fence pairs with the one in `ReclaimLocked`: either the
+        // writer sees this epoch, or this reader sees the cell the writer published before reclaiming.
+        slot.epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        Cell cell;
+        lock_.Load([&] { cell = cell_; });
+        return ReadGuard{&slot, cell.current.Get(arena_), cell.version};
+    }
+
+    OffsetPtr<T> AllocateLocked() {
+        OffsetPtr<T> next = arena_.template Allocate<T>();
+        if (next.IsNull() and ReclaimLocked() > 0) {
+            next = arena_.template Allocate<T>();
+        }
+        return next;
+    }
+
+    void PublishLocked(OffsetPtr<T> next, const Cell& previous) {
+        lock_.Store([&] { cell_ = Cell{next, previous.version + 1}; });
+
+        // Readers that announce this epoch or a later one load the new cell, so the previous version can be reclaimed
+        // once every reader is either not reading or reading at this epoch or later.
+        const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (not previous.current.IsNull()) {
+            retired_[retired_count_++] = Retired{previous.current, epoch};
+        }
+    }
+
+    size_t ReclaimLocked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // The oldest epoch at which a reader is still reading.
+        uint64_t min_epoch{UINT64_MAX};
+        for (const auto& slot : slots_) {
+            if (const uint64_t epoch = slot.epoch.load(std::memory_order_acquire); epoch != 0) {
+                min_epoch = std::min(min_epoch, epoch);
+            }
+        }
+
+        size_t reclaimed{0};
+        for (size_t i = 0; i < retired_count_;) {
+            if (retired_[i].epoch <= min_epoch) {
+                arena_.Free(retired_[i].ptr);
+                retired_[i] = retired_[--retired_count_];
+                reclaimed++;
+            } else {
+                i++;
+            }
+        }
+        return reclaimed;
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "seqlock/dirty.hpp"
+#include "seqlock/seqlock.hpp"
+#include "seqlock/util.hpp"
+
+namespace seqlock {
+
+/// A record of an `UpdateLog`: one committed version of a region. It is followed by `size` bytes of data, padded to 8
+/// bytes.
+struct UpdateRecord {
+    // The sequence number of the version in the recorded region.
+    uint64_t seq;
+
+    // The value of `util::ReadTsc` when the version was observed.
+    uint64_t tsc;
+
+    // The index of the region in a `WatchedRegions`, 0 for a `GuardedRegion`.
+    uint32_t index;
+
+    uint32_t size;
+};
+
+/// `UpdateLog` is an append-only log of `UpdateRecord`s in a memory-mapped file. Logs are written by a `Recorder` and
+/// read by a `Replayer`, possibly on another machine: the log stores the rate of the timestamp counter of the machine
+/// that recorded it.
+///
+/// The file grows as records are appended and is truncated to its used size when the log is destroyed. Records are
+/// visible to readers that open the file after the log is destroyed.
+class UpdateLog {
+   private:
+    struct Header {
+        uint64_t magic;
+        uint64_t records;
+
+        // The file offset past the last record.
+        uint64_t end;
+        double tsc_ticks_per_ns;
+    };
+
+    static constexpr uint64_t kMagic{0x31474f4c51455300};  // "\0SEQLOG1"
+    static constexpr size_t kHeaderSize{64};
+    static constexpr size_t kAlignment{8};
+
+    static_assert(sizeof(Header) <= kHeaderSize);
+    static_assert(sizeof(UpdateRecord) % kAlignment == 0);
+
+   public:
+    /// `Create` creates a new log at `path`, replacing any existing file. `capacity` is the initial size of the file,
+    /// which doubles whenever it is full.
+    static std::expected<UpdateLog, std::string> Create(const std::string& path, size_t capacity = 1 << 20) {
+        const int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP);
+        if (fd < 0) {
+            return std::unexpected(std::format("Cannot create log {} err={}.", path, std::strerror(errno)));
+        }
+
+        UpdateLog log{fd, path, true};
+        if (auto map_result = log.Map(std::max(capacity, kHeaderSize)); not map_result) {
+            return std::unexpected(map_result.error());
+        }
+        *log.GetHeader() = Header{kMagic, 0, kHeaderSize, util::TscTicksPerNs()};
+        return log;
+    }
+
+    /// `Open` opens an existing log at `path` for reading.
+    static std::expected<UpdateLog, std::string> Open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return std::unexpected(std::format("Cannot open log {} err={}.", path, std::strerror(errno)));
+        }
+
+        UpdateLog log{fd, path, false};
+        const auto file_size_result = util::GetFileSize(fd);
+        if (not file_size_result) {
+            return std::unexpected(std::format("Log {} err={}", path, file_size_result.error()));
+        }
+        if (file_size_result.value() < kHeaderSize) {
+            return std::unexpected(std::format("Log {} of size {} is too small.", path, file_size_result.value()));
+        }
+        if (auto map_result = log.Map(file_size_result.value()); not map_result) {
+            return std::unexpected(map_result.error());
+        }
+
+        const Header* header = log.GetHeader();
+        if (header->magic != kMagic) {
+            return std::unexpected(std::format("File {} is not a log.", path));
+        }
+        if (header->end > log.size_) {
+            return std::unexpected(std::format("Log {} is truncated: {} < {}.", path, log.size_, header->end));
+        }
+        return log;
+    }
+
+    ~UpdateLog() noexcept {
+        if (fd_ < 0) {
+            return;
+        }
+        if (base_ != nullptr) {
+            const uint64_t end = GetHeader()->end;
+            ::munmap(base_, size_);
+            if (writable_) {
+                [[maybe_unused]] const int err = ::ftruncate(fd_, static_cast<off_t>(end));
+            }
+        }
+        ::close(fd_);
+    }
+
+    // Copy.
+    UpdateLog(const UpdateLog&) = delete;
+    UpdateLog& operator=(const UpdateLog&) = delete;
+
+    // Move.
+    UpdateLog(UpdateLog&& other) noexcept
+        : fd_{std::exchange(other.fd_, -1)},
+          path_{std::move(other.path_)},
+          writable_{other.writable_},
+          base_{std::exchange(other.base_, nullptr)},
+          size_{other.size_} {}
+    UpdateLog& operator=(UpdateLog&&) = delete;
+
+    /// `Append` appends a record holding `size` bytes of `data`.
+    std::expected<void, std::string> Append(uint64_t seq, uint64_t tsc, uint32_t index, const char* data,
+                                            size_t size) {
+        if (not writable_) {
+            return std::unexpected(std::format("Log {} is read-only.", path_));
+        }
+        if (size > UINT32_MAX) {
+            return std::unexpected(std::format("Record of {} bytes is too large.", size));
+        }
+
+        const size_t record_size = RecordSize(size);
+        const uint64_t end = GetHeader()->end;
+        if (end + record_size > size_) {
+            if (auto map_result = Map(std::max(2 * size_, end + record_size)); not map_result) {
+                return map_result;
+            }
+        }
+
+        char* at = base_ + end;
+        const UpdateRecord record{seq, tsc, index, static_cast<uint32_t>(size)};
+        std::memcpy(at, &record, sizeof(record));
+        std::memcpy(at + sizeof(record), data, size);
+
+        Header* header = GetHeader();
+        header->records++;
+        header->end = end + record_size;
+        return {};
+    }
+
+    /// `ForEach` calls `fn(record, data)` for every record, in the order they were appended.
+    template <typename FnT>
+    void ForEach(FnT&& fn) const {
+        const uint64_t end = GetHeader()->end;
+        for (uint64_t offset = kHeaderSize; offset < end;) {
+            UpdateRecord record;
+            std::memcpy(&record, base_ + offset, sizeof(record));
+            fn(static_cast<const UpdateRecord&>(record), static_cast<const char*>(base_ + offset + sizeof(record)));
+            offset += RecordSize(record.size);
+        }
+    }
+
+    size_t Records() const noexcept { return GetHeader()->records; }
+
+    /// `TscTicksPerNs` returns the rate of the timestamp counter of the machine that recorded the log.
+    double TscTicksPerNs() const noexcept { return GetHeader()->tsc_ticks_per_ns; }
+
+   private:
+    int fd_;
+    std::string path_;
+    bool writable_;
+    char* base_{nullptr};
+    size_t size_{0};
+
+    UpdateLog(int fd, const std::string& path, bool writable) : fd_{fd}, path_{path}, writable_{writable} {}
+
+    Header* GetHeader() noexcept { return reinterpret_cast<Header*>(base_); }
+    const Header* GetHeader() const noexcept { return reinterpret_cast<const Header*>(base_); }
+
+    static size_t RecordSize(size_t size) noexcept {
+        return sizeof(UpdateRecord) + (size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    // Grows the file to `size` bytes if writable, then maps it in place of the current mapping.
+    std::expected<void, std::string> Map(size_t size) {
+        if (writable_ and ::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            return std::unexpected(
+                std::format("Cannot truncate log {} to {} err={}.", path_, size, std::strerror(errno)));
+        }
+
+        const int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* ptr = ::mmap(nullptr, size, prot, MAP_SHARED, fd_, 0);
+        if (ptr == MAP_FAILED) {
+            return std::unexpected(std::format("Cannot mmap log {} err={}.", path_, std::strerror(errno)));
+        }
+
+        if (base_ != nullptr) {
+            ::munmap(base_, size_);
+        }
+        base_ = static_cast<char*>(ptr);
+        size_ = size;
+        return {};
+    }
+};
+
+/// `Recorder` follows a region and appends every version it observes to an `UpdateLog`, tagged with its sequence
+/// number and the timestamp counter at which it was observed.
+///
+/// A seqlock only holds the latest version, so versions committed between two `Poll` calls are not recorded. Gaps in
+/// the recorded sequence numbers tell how many versions were missed. Poll from a dedicated thread to miss as few as
+/// possible.
+class Recorder {
+   public:
+    explicit Recorder(UpdateLog& log) : log_{log} {}
+
+    /// `Poll` records the latest version of `region` if it was not recorded yet. Returns true if a version was
+    /// recorded.
+    template <mode::Mode ModeT, size_t N>
+    std::expected<bool, std::string> Poll(const GuardedRegion<ModeT, N>& region) {
+        if (region.Sequence() == last_seq_) {
+            return false;
+        }
+
+        buffer_.resize(N);
+        const uint64_t seq = region.Load(buffer_.data(), N);
+        const uint64_t tsc = util::ReadTsc();
+        if (seq == last_seq_) {
+            return false;
+        }
+        last_seq_ = seq;
+
+        if (auto append_result = log_.Append(seq, tsc, 0, buffer_.data(), N); not append_result) {
+            return std::unexpected(append_result.error());
+        }
+        return true;
+    }
+
+    /// `Poll` records the latest version of every region of `regions` that changed since the last `LoadChanged` of
+    /// `consumer`. Returns the number of recorded versions.
+    template <mode::Mode ModeT, size_t N, size_t Count, size_t Consumers>
+    std::expected<size_t, std::string> Poll(WatchedRegions<ModeT, N, Count, Consumers>& regions, size_t consumer) {
+        buffer_.resize(N);
+        std::expected<void, std::string> append_result{};
+        const size_t loaded =
+            regions.LoadChanged(consumer, buffer_.data(), N, [&](size_t index, const char* data, uint64_t seq) {
+                if (append_result) {
+                    append_result = log_.Append(seq, util::ReadTsc(), static_cast<uint32_t>(index), data, N);
+                }
+            });
+        if (not append_result) {
+            return std::unexpected(append_result.error());
+        }
+        return loaded;
+    }
+
+   private:
+    UpdateLog& log_;
+    uint64_t last_seq_{0};
+    std::vector<char> buffer_;
+};
+
+/// `Replayer` drives a writer from an `UpdateLog`, storing the recorded versions in the recorded order. Replays are
+/// deterministic: the same log always produces the same sequence of stores.
+///
+/// Stores are spaced as they were recorded, divided by `speed`: 1 replays at the original speed, 10 ten times faster.
+/// A `speed` of 0 replays as fast as possible. Pacing uses the steady clock and the timestamp counter rate stored in
+/// the log, so logs can be replayed on other machines.
+class Replayer {
+   public:
+    explicit Replayer(const UpdateLog& log, double speed = 1.0) : log_{log}, speed_{speed} {}
+
+    /// `Run` calls `store_fn(record, data)` for every record, on time. If `store_fn` returns a `bool`, returning false
+    /// stops the replay. Returns the number of replayed records.
+    template <typename StoreFnT>
+    size_t Run(StoreFnT&& store_fn) const {
+        using ResultT = std::invoke_result_t<StoreFnT&, const UpdateRecord&, const char*>;
+
+        const double ticks_per_ns = log_.TscTicksPerNs() * speed_;
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t first_tsc{0};
+        size_t replayed{0};
+        bool stopped{false};
+
+        log_.ForEach([&](const UpdateRecord& record, const char* data) {
+            if (stopped) {
+                return;
+            }
+            if (replayed == 0) {
+                first_tsc = record.tsc;
+            }
+            if (speed_ > 0 and ticks_per_ns > 0) {
+                const auto offset = static_cast<int64_t>(static_cast<double>(record.tsc - first_tsc) / ticks_per_ns);
+                WaitUntil(start + std::chrono::nanoseconds{offset});
+            }
+
+            if constexpr (std::same_as<ResultT, bool>) {
+                stopped = not store_fn(record, data);
+            } else {
+                store_fn(record, data);
+            }
+            replayed++;
+        });
+        return replayed;
+    }
+
+    /// `Run` stores every record into `region`.
+    template <mode::Mode ModeT, size_t N>
+    size_t Run(GuardedRegion<ModeT, N>& region) const {
+        return Run([&](const UpdateRecord& record, const char* data) { region.Store(data, record.size); });
+    }
+
+    /// `Run` stores every record into the region of `regions` at the recorded index. Records with an out-of-bounds
+    /// index are skipped.
+    template <mode::Mode ModeT, size_t N, size_t Count, size_t Consumers>
+    size_t Run(WatchedRegions<ModeT, N, Count, Consumers>& regions) const {
+        return Run([&](const UpdateRecord& record, const char* data) {
+            if (record.index < Count) {
+                regions.Store(record.index, data, record.size);
+            }
+        });
+    }
+
+   private:
+    const UpdateLog& log_;
+    double speed_;
+
+    // Sleeps while the deadline is far away, then spins to hit it precisely.
+    static void WaitUntil(std::chrono::steady_clock::time_point deadline) {
+        constexpr auto kSpinThreshold = std::chrono::microseconds{100};
+        for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now()) {
+            if (deadline - now > kSpinThreshold) {
+                std::this_thread::sleep_for(deadline - now - kSpinThreshold);
+            }
+        }
+    }
+};
+
+}  // namespace seqlock
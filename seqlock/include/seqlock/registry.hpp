@@ -0,0 +1,209 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <string>
+#include <utility>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// A copy of the counters published by a reader registered in a `ReaderRegistry`.
+struct ReaderStats {
+    size_t slot;
+    uint64_t id;
+
+    // The sequence number of the last version the reader consumed.
+    uint64_t last_seq;
+
+    // The number of successful loads, and of failed attempts that had to be retried because a write interfered.
+    uint64_t loads;
+    uint64_t retries;
+
+    /// `Lag` returns the number of versions the reader is behind, given the writer's current sequence number.
+    uint64_t Lag(uint64_t writer_seq) const noexcept {
+        return writer_seq > last_seq ? (writer_seq & ~1ULL) / 2 - last_seq / 2 : 0;
+    }
+};
+
+template <size_t MaxReaders>
+class ReaderRegistry;
+
+/// `ReaderSlot` is a reader's handle on its slot of a `ReaderRegistry`. The slot is released when the handle is
+/// destroyed. Readers load through the handle, which publishes what they consumed to the registry. Once the slot is
+/// evicted, the handle publishes nothing anymore.
+template <size_t MaxReaders>
+class ReaderSlot {
+   public:
+    ~ReaderSlot() noexcept {
+        if (registry_ != nullptr) {
+            registry_->Unregister(slot_, id_);
+        }
+    }
+
+    // Copy.
+    ReaderSlot(const ReaderSlot&) = delete;
+    ReaderSlot& operator=(const ReaderSlot&) = delete;
+
+    // Move.
+    ReaderSlot(ReaderSlot&& other) noexcept
+        : registry_{std::exchange(other.registry_, nullptr)}, slot_{other.slot_}, id_{other.id_} {}
+    ReaderSlot& operator=(ReaderSlot&&) = delete;
+
+    /// `Load` copies `region` into `into`, publishes the sequence number of the copied version and the number of
+    /// retries it took, and returns the sequence number.
+    template <mode::Mode ModeT, size_t N>
+    uint64_t Load(const GuardedRegion<ModeT, N>& region, char* into, size_t size) noexcept {
+        uint64_t seq{0};
+        uint64_t retries{0};
+        while (not region.TryLoad(into, size, &seq)) {
+            retries++;
+        }
+        Publish(seq, retries);
+        return seq;
+    }
+
+    /// `Load` executes `load_fn` through `lock` like `SeqLock::Load`, publishes the sequence number of the loaded
+    /// version and the number of retries it took, and returns the sequence number.
+    template <mode::Mode ModeT, typename LoadFnT>
+    uint64_t Load(const SeqLock<ModeT>& lock, LoadFnT&& load_fn) noexcept {
+        uint64_t seq{0};
+        uint64_t retries{0};
+        while (not lock.TryLoad([&] {
+            seq = lock.Sequence();
+            load_fn();
+        })) {
+            retries++;
+        }
+        Publish(seq, retries);
+        return seq;
+    }
+
+    /// `Publish` publishes a successful load of the version `seq` which took `retries` retries, for readers that load
+    /// through their own loop.
+    void Publish(uint64_t seq, uint64_t retries) noexcept { registry_->Publish(slot_, id_, seq, retries); }
+
+    size_t Slot() const noexcept { return slot_; }
+
+   private:
+    friend class ReaderRegistry<MaxReaders>;
+
+    ReaderRegistry<MaxReaders>* registry_;
+    size_t slot_;
+    uint64_t id_;
+
+    ReaderSlot(ReaderRegistry<MaxReaders>* registry, size_t slot, uint64_t id)
+        : registry_{registry}, slot_{slot}, id_{id} {}
+};
+
+/// `ReaderRegistry` is a table of up to `MaxReaders` reader slots, meant to be placed in shared memory next to the
+/// regions it monitors. Each registered reader owns a cache-line sized slot where it publishes the sequence number of
+/// the last version it consumed and how many times it had to retry. Writers and monitoring tools read the slots to find
+/// consumers that fall behind or livelock.
+///
+/// Readers only write to their own slot and writers never touch the registry, so the registry costs nothing to the
+/// writer's `Store` and does not add contention between readers.
+template <size_t MaxReaders>
+class ReaderRegistry {
+   private:
+    struct alignas(64) Slot {
+        // 0 if the slot is free, the id of the owner otherwise.
+        std::atomic<uint64_t> id{0};
+
+        // Only written by the owner.
+        std::atomic<uint64_t> last_seq{0};
+        std::atomic<uint64_t> loads{0};
+        std::atomic<uint64_t> retries{0};
+    };
+
+   public:
+    ReaderRegistry() = default;
+    ~ReaderRegistry() = default;
+
+    // Copy.
+    ReaderRegistry(const ReaderRegistry&) = delete;
+    ReaderRegistry& operator=(const ReaderRegistry&) = delete;
+
+    // Move.
+    ReaderRegistry(ReaderRegistry&&) = delete;
+    ReaderRegistry& operator=(ReaderRegistry&&) = delete;
+
+    /// `Register` claims a free slot for the reader `id`, which must not be 0 and should be unique among the registered
+    /// readers. The process id is a good choice for readers in different processes. The counters of the slot are
+    /// reset.
+    std::expected<ReaderSlot<MaxReaders>, std::string> Register(uint64_t id) noexcept {
+        if (id == 0) {
+            return std::unexpected("Reader id must not be 0.");
+        }
+        for (size_t i = 0; i < MaxReaders; i++) {
+            auto& slot = slots_[i];
+            uint64_t free{0};
+            if (slot.id.load(std::memory_order_relaxed) == 0 and
+                slot.id.compare_exchange_strong(free, id, std::memory_order_acquire, std::memory_order_relaxed)) {
+                slot.last_seq.store(0, std::memory_order_relaxed);
+                slot.loads.store(0, std::memory_order_relaxed);
+                slot.retries.store(0, std::memory_order_relaxed);
+                return ReaderSlot<MaxReaders>{this, i, id};
+            }
+        }
+        return std::unexpected(std::format("All {} reader slots are taken.", MaxReaders));
+    }
+
+    /// `Evict` frees the slot of a reader that exited without releasing it, like a crashed process. `slot` and `id` are
+    /// the ones reported by `ForEach`. Returns false if the reader `id` does not hold the slot anymore, so a slot that
+    /// was released and claimed by another reader in the meantime is left alone.
+    bool Evict(size_t slot, uint64_t id) noexcept { return Unregister(slot, id); }
+
+    /// `ForEach` calls `fn(stats)` for every registered reader. Each reader's counters are read without
+    /// synchronization with the reader, so they might be one load apart from each other.
+    template <typename FnT>
+    void ForEach(FnT&& fn) const {
+        for (size_t i = 0; i < MaxReaders; i++) {
+            const auto& slot = slots_[i];
+            const uint64_t id = slot.id.load(std::memory_order_acquire);
+            if (id == 0) {
+                continue;
+            }
+            fn(ReaderStats{i, id, slot.last_seq.load(std::memory_order_relaxed),
+                           slot.loads.load(std::memory_order_relaxed), slot.retries.load(std::memory_order_relaxed)});
+        }
+    }
+
+    /// `Readers` returns the number of registered readers.
+    size_t Readers() const noexcept {
+        size_t readers{0};
+        ForEach([&](const ReaderStats&) { readers++; });
+        return readers;
+    }
+
+    static constexpr size_t MaxSize() noexcept { return MaxReaders; }
+
+   private:
+    friend class ReaderSlot<MaxReaders>;
+
+    Slot slots_[MaxReaders];
+
+    bool Unregister(size_t slot, uint64_t id) noexcept {
+        return slots_[slot].id.compare_exchange_strong(id, 0, std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    void Publish(size_t index, uint64_t id, uint64_t seq, uint64_t retries) noexcept {
+        // A reader is the only writer of its slot, so plain stores are enough and no read-modify-write is needed. The
+        // updates of an evicted reader are dropped, except for one racing with the eviction itself.
+        auto& slot = slots_[index];
+        if (slot.id.load(std::memory_order_relaxed) != id) {
+            return;
+        }
+        slot.last_seq.store(seq, std::memory_order_relaxed);
+        slot.loads.store(slot.loads.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (retries > 0) {
+            slot.retries.store(slot.retries.load(std::memory_order_relaxed) + retries, std::memory_order_relaxed);
+        }
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `RelayHeader` precedes the data of a region in every message sent by a `Relay`.
+struct RelayHeader {
+    // The id returned by `Relay::Add`.
+    uint32_t region;
+    // The number of data bytes following the header.
+    uint32_t size;
+    // The sequence number of the sent version.
+    uint64_t seq;
+};
+
+/// `RelaySubscriber` is the client side of a `Relay`, for processes that cannot map the shared memory segments.
+///
+/// It is movable but not thread-safe.
+class RelaySubscriber {
+   public:
+    /// Subscribes to every region added to the relay before it processes the subscription.
+    static constexpr uint32_t kAllRegions = UINT32_MAX;
+
+    /// `Connect` connects to the relay listening on `path` and subscribes to `regions`, ids returned by `Relay::Add`.
+    /// The relay sends the current version of each region once it processes the subscription, then every version it
+    /// sees, unless a newer one replaces it before this subscriber has room to receive it.
+    static std::expected<RelaySubscriber, std::string> Connect(const std::string& path,
+                                                               std::span<const uint32_t> regions) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return std::unexpected(std::format("Socket path {} is too long.", path));
+        }
+        if (regions.empty()) {
+            return std::unexpected("Subscribe to at least one region, or to kAllRegions.");
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+        RelaySubscriber subscriber{::socket(AF_UNIX, SOCK_SEQPACKET, 0)};
+        if (subscriber.fd_ < 0) {
+            return std::unexpected(std::format("Could not create socket err={}.", std::strerror(errno)));
+        }
+        if (::connect(subscriber.fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            return std::unexpected(std::format("Could not connect to relay {} err={}.", path, std::strerror(errno)));
+        }
+        if (::send(subscriber.fd_, regions.data(), regions.size_bytes(), 0) < 0) {
+            return std::unexpected(std::format("Could not subscribe to relay {} err={}.", path, std::strerror(errno)));
+        }
+        return subscriber;
+    }
+
+    ~RelaySubscriber() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    // Copy.
+    RelaySubscriber(const RelaySubscriber&) = delete;
+    RelaySubscriber& operator=(const RelaySubscriber&) = delete;
+
+    // Move.
+    RelaySubscriber(RelaySubscriber&& other) noexcept : fd_{std::exchange(other.fd_, -1)} {}
+    RelaySubscriber& operator=(RelaySubscriber&&) = delete;
+
+    /// `Receive` receives the next version of a subscribed region into `into`, which must hold the whole region, and
+    /// returns its header. If `wait` is false and no version is pending, returns `std::nullopt` right away.
+    std::expected<std::optional<RelayHeader>, std::string> Receive(char* into, size_t size, bool wait = true) {
+        RelayHeader header{};
+        iovec iov[2]{{&header, sizeof(header)}, {into, size}};
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        const ssize_t received = ::recvmsg(fd_, &msg, wait ? 0 : MSG_DONTWAIT);
+        if (received < 0) {
+            if (errno == EAGAIN or errno == EWOULDBLOCK) {
+                return std::nullopt;
+            }
+            return std::unexpected(std::format("Could not receive from relay err={}.", std::strerror(errno)));
+        }
+        if (received == 0) {
+            return std::unexpected("Relay closed the connection.");
+        }
+        if ((msg.msg_flags & MSG_TRUNC) != 0 or static_cast<size_t>(received) < sizeof(header)) {
+            return std::unexpected(
+                std::format("Region {} of {} bytes does not fit into {} bytes.", header.region, header.size, size));
+        }
+        return header;
+    }
+
+    /// `Fd` returns the socket, to wait for versions with `poll` or `epoll` along with other events.
+    int Fd() const noexcept { return fd_; }
+
+   private:
+    explicit RelaySubscriber(int fd) noexcept : fd_{fd} {}
+
+    int fd_;
+};
+
+/// `Relay` serves `GuardedRegion`s to processes that cannot map their shared memory segments, like sandboxed processes
+/// or containers without access to `/dev/shm`, over a Unix domain socket. Each version of a region is sent as one
+/// `SOCK_SEQPACKET` message: a `RelayHeader` followed by the region's data.
+///
+/// Updates are conflated per subscriber. The relay loads each updated region once per pass, then sends the latest
+/// version to every subscriber that did not receive it yet. A subscriber whose socket buffer is full is skipped, and
+/// gets whatever version is current once it drained some messages: a slow subscriber never delays the relay or the
+/// other subscribers, and never receives stale versions queued behind newer ones.
+///
+/// All the versions pending for a subscriber are sent with a single `sendmmsg` call, each message gathering the header
+/// and the region's data without copying them. A message must fit into the subscriber's socket buffer, see
+/// `send_buffer` in `Listen`; subscribers which cannot receive a region are disconnected.
+///
+/// All regions and subscribers are served by the thread calling `Run` or `RunOnce`. Only `Stop` may be called from
+/// other threads. Linux only: other platforms lack `SOCK_SEQPACKET` Unix domain sockets or `sendmmsg`.
+class Relay {
+   private:
+    struct Source {
+        const void* region;
+        uint64_t (*sequence)(const void* region);
+        bool (*try_load)(const void* region, char* into, uint64_t* seq);
+        RelayHeader header;
+        // The version sent to the subscribers, which `header.seq` describes.
+        std::vector<char> data;
+        // Where the region is loaded before replacing `data`, so a torn copy never reaches the subscribers.
+        std::vector<char> scratch;
+    };
+
+    struct Subscriber {
+        int fd;
+        // Empty until the subscription message is received.
+        std::vector<uint32_t> regions;
+        // The sequence number of the last version sent, per subscribed region.
+        std::vector<uint64_t> sent;
+    };
+
+   public:
+    /// `Listen` creates a relay listening on `path`, replacing any socket file left there by a previous relay. If
+    /// `send_buffer` is not zero, it sets the size of the socket buffer of every subscriber, which must hold at least
+    /// one message of the largest region.
+    static std::expected<Relay, std::string> Listen(const std::string& path, size_t send_buffer = 0) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return std::unexpected(std::format("Socket path {} is too long.", path));
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+        const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if (fd < 0) {
+            return std::unexpected(std::format("Could not create socket err={}.", std::strerror(errno)));
+        }
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 or ::listen(fd, SOMAXCONN) != 0 or
+            ::fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+            auto error = std::format("Could not listen on {} err={}.", path, std::strerror(errno));
+            ::close(fd);
+            return std::unexpected(std::move(error));
+        }
+        return Relay{fd, path, send_buffer};
+    }
+
+    ~Relay() {
+        for (const auto& subscriber : subscribers_) {
+            ::close(subscriber.fd);
+        }
+        if (listen_fd_ >= 0) {
+            ::close(listen_fd_);
+            ::unlink(path_.c_str());
+        }
+    }
+
+    // Copy.
+    Relay(const Relay&) = delete;
+    Relay& operator=(const Relay&) = delete;
+
+    // Move.
+    Relay(Relay&& other) noexcept
+        : listen_fd_{std::exchange(other.listen_fd_, -1)},
+          path_{std::move(other.path_)},
+          send_buffer_{other.send_buffer_},
+          sources_{std::move(other.sources_)},
+          subscribers_{std::move(other.subscribers_)},
+          sent_{other.sent_} {}
+    Relay& operator=(Relay&&) = delete;
+
+    /// `Add` relays `region` and returns its id. `region` must outlive the relay.
+    template <mode::Mode ModeT, size_t N>
+    uint32_t Add(const GuardedRegion<ModeT, N>& region) {
+        static_assert(N <= UINT32_MAX, "Relayed regions hold less than 4GiB.");
+        using Region = GuardedRegion<ModeT, N>;
+
+        const auto id = static_cast<uint32_t>(sources_.size());
+        sources_.push_back(Source{
+            .region = &region,
+            .sequence = [](const void* r) { return static_cast<const Region*>(r)->Sequence(); },
+            .try_load = [](const void* r, char* into,
+                           uint64_t* seq) { return static_cast<const Region*>(r)->TryLoad(into, N, seq); },
+            .header = {id, static_cast<uint32_t>(N), 0},
+            .data = std::vector<char>(N),
+            .scratch = std::vector<char>(N),
+        });
+        return id;
+    }
+
+    /// `RunOnce` accepts new subscribers, loads the regions that changed and sends them to the subscribers that have
+    /// room for them. Returns the number of messages sent.
+    size_t RunOnce() {
+        Accept();
+        for (auto& source : sources_) {
+            if (const uint64_t seq = source.sequence(source.region); seq != source.header.seq and (seq & 1) == 0) {
+                // A failed load leaves the sent version untouched, and the region is loaded again on the next pass.
+                if (uint64_t loaded_seq{0}; source.try_load(source.region, source.scratch.data(), &loaded_seq)) {
+                    source.data.swap(source.scratch);
+                    source.header.seq = loaded_seq;
+                }
+            }
+        }
+
+        size_t sent{0};
+        for (size_t i = 0; i < subscribers_.size();) {
+            auto& subscriber = subscribers_[i];
+            const auto sent_result = subscriber.regions.empty() ? Subscribe(subscriber) : Send(subscriber);
+            if (not sent_result) {
+                ::close(subscriber.fd);
+                subscriber = std::move(subscribers_.back());
+                subscribers_.pop_back();
+                continue;
+            }
+            sent += sent_result.value();
+            i++;
+        }
+        sent_ += sent;
+        return sent;
+    }
+
+    /// `Run` calls `RunOnce` until `Stop` is called.
+    void Run() {
+        while (not stop_.load(std::memory_order_relaxed)) {
+            RunOnce();
+        }
+    }
+
+    /// `Stop` makes `Run` return after its current pass.
+    void Stop() noexcept { stop_.store(true, std::memory_order_relaxed); }
+
+    /// `Subscribers` returns the number of connected subscribers, including the ones that did not subscribe yet.
+    size_t Subscribers() const noexcept { return subscribers_.size(); }
+
+    /// `Sent` returns the number of messages sent since the relay started.
+    uint64_t Sent() const noexcept { return sent_; }
+
+   private:
+    int listen_fd_;
+    std::string path_;
+    size_t send_buffer_;
+    std::vector<Source> sources_;
+    std::vector<Subscriber> subscribers_;
+    uint64_t sent_{0};
+    std::atomic<bool> stop_{false};
+
+    // Scratch space for the messages sent to a subscriber in one call.
+    std::vector<mmsghdr> messages_;
+    std::vector<iovec> iovs_;
+    std::vector<size_t> pending_;
+
+    Relay(int listen_fd, std::string path, size_t send_buffer) noexcept
+        : listen_fd_{listen_fd}, path_{std::move(path)}, send_buffer_{send_buffer} {}
+
+    void Accept() {
+        while (true) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            const int buffer = static_cast<int>(send_buffer_);
+            if (::fcntl(fd, F_SETFL, O_NONBLOCK) != 0 or
+                (send_buffer_ > 0 and ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer)) != 0)) {
+                ::close(fd);
+                continue;
+            }
+            subscribers_.push_back(Subscriber{fd, {}, {}});
+        }
+    }
+
+    // Receives the subscription message, if it arrived. Returns an error if the subscriber left or sent an invalid
+    // subscription.
+    std::expected<size_t, std::string> Subscribe(Subscriber& subscriber) {
+        std::vector<uint32_t> regions(sources_.size() + 1);
+        const ssize_t received = ::recv(subscriber.fd, regions.data(), regions.size() * sizeof(uint32_t), MSG_DONTWAIT);
+        if (received < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+            return 0;
+        }
+        if (received <= 0 or received % sizeof(uint32_t) != 0) {
+            return std::unexpected("Invalid subscription.");
+        }
+        regions.resize(static_cast<size_t>(received) / sizeof(uint32_t));
+        if (regions.size() == 1 and regions[0] == RelaySubscriber::kAllRegions) {
+            regions.resize(sources_.size());
+            for (size_t i = 0; i < regions.size(); i++) {
+                regions[i] = static_cast<uint32_t>(i);
+            }
+        }
+        for (const uint32_t region : regions) {
+            if (region >= sources_.size()) {
+                return std::unexpected(std::format("Unknown region {}.", region));
+            }
+        }
+        subscriber.regions = std::move(regions);
+        subscriber.sent.assign(subscriber.regions.size(), 0);
+        return Send(subscriber);
+    }
+
+    // Sends the latest versions the subscriber did not receive yet. Returns the number of messages sent, or an error if
+    // the subscriber left or cannot receive a region.
+    std::expected<size_t, std::string> Send(Subscriber& subscriber) {
+        pending_.clear();
+        for (size_t i = 0; i < subscriber.regions.size(); i++) {
+            const Source& source = sources_[subscriber.regions[i]];
+            if (source.header.seq != 0 and source.header.seq != subscriber.sent[i]) {
+                pending_.push_back(i);
+            }
+        }
+        if (pending_.empty()) {
+            return 0;
+        }
+
+        messages_.resize(pending_.size());
+        iovs_.resize(2 * pending_.size());
+        for (size_t m = 0; m < pending_.size(); m++) {
+            Source& source = sources_[subscriber.regions[pending_[m]]];
+            iovs_[2 * m] = {&source.header, sizeof(source.header)};
+            iovs_[2 * m + 1] = {source.data.data(), source.data.size()};
+            messages_[m] = {};
+            messages_[m].msg_hdr.msg_iov = &iovs_[2 * m];
+            messages_[m].msg_hdr.msg_iovlen = 2;
+        }
+
+        const int sent =
+            ::sendmmsg(subscriber.fd, messages_.data(), static_cast<unsigned>(pending_.size()), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN or errno == EWOULDBLOCK) {
+                return 0;
+            }
+            return std::unexpected(std::format("Could not send err={}.", std::strerror(errno)));
+        }
+        for (size_t m = 0; m < static_cast<size_t>(sent); m++) {
+            subscriber.sent[pending_[m]] = sources_[subscriber.regions[pending_[m]]].header.seq;
+        }
+        return static_cast<size_t>(sent);
+    }
+};
+
+}  // namespace seqlock
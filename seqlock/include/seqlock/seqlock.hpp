@@ -1,33 +1,185 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <concepts>
+#include <coroutine>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <variant>
 
-#include "seqlock/spinlock.hpp"
-
 #if defined(__x86_64__) || defined(_M_X64)
-#define BARRIER asm volatile("" : : : "memory")
-#elif defined(__aarch64__) || defined(_M_ARM64)
-#define BARRIER asm volatile("dmb sy" : : : "memory")
-#else
-#define BARRIER static_assert("Unsupported architecture.")
+#include <immintrin.h>
 #endif
 
+#include "seqlock/spinlock.hpp"
+
 namespace seqlock {
 
 namespace mode {
 struct SingleWriter {};
 struct MultiWriter {};
 
+/// `CompactMultiWriter` is a multi-writer mode without a separate writer lock: writers acquire the `SeqLock` by CAS-ing
+/// its sequence number from even to odd. The lock fits in a single cache line instead of two, and writers touch one
+/// cache line per store instead of two. The sequence number type can be narrowed to 32 bits, see
+/// `CompactMultiWriter32`.
+template <typename SeqValueT = uint64_t>
+struct CompactMultiWriter {
+    static_assert(std::unsigned_integral<SeqValueT>, "The sequence number must be an unsigned integer.");
+    using SeqValueType = SeqValueT;
+};
+
+/// A 32-bit sequence number wraps around after 2^31 writes. A reader that is preempted for exactly a multiple of 2^31
+/// writes between its two sequence number loads accepts a torn read, which is practically impossible but not ruled out
+/// as it is with 64 bits.
+using CompactMultiWriter32 = CompactMultiWriter<uint32_t>;
+
 template <typename T>
-concept Mode = std::same_as<T, mode::SingleWriter> or std::same_as<T, mode::MultiWriter>;
+inline constexpr bool kIsCompact = false;
+
+template <typename SeqValueT>
+inline constexpr bool kIsCompact<CompactMultiWriter<SeqValueT>> = true;
+
+template <typename T>
+concept Compact = kIsCompact<T>;
+
+template <typename T>
+concept Mode = std::same_as<T, mode::SingleWriter> or std::same_as<T, mode::MultiWriter> or Compact<T>;
+
+/// `SeqValue<ModeT>` is the type of the sequence number of a `SeqLock<ModeT>`.
+template <Mode ModeT>
+struct SeqValue {
+    using type = uint64_t;
+};
+
+template <Compact ModeT>
+struct SeqValue<ModeT> {
+    using type = typename ModeT::SeqValueType;
+};
 
 }  // namespace mode
 
+/// Fence policies of `SeqLock`: the memory orders of the sequence number loads and stores, and the fences around the
+/// reads and writes of the guarded data. All policies are interchangeable between readers and writers of the same
+/// lock, so a policy can be chosen per process. Compare them with `seqlock.bm.cpp` on the target.
+namespace fence {
+
+/// `Barrier` is the default policy. On x86, whose loads are not reordered with other loads and stores not with other
+/// stores, it only prevents the compiler from reordering. On ARM, it issues a full `dmb sy`. Other architectures get a
+/// sequentially consistent fence instead.
+struct Barrier {
+    static constexpr std::memory_order kReadBegin = std::memory_order_relaxed;
+    static constexpr std::memory_order kReadEnd = std::memory_order_relaxed;
+    static constexpr std::memory_order kWriteBegin = std::memory_order_relaxed;
+    static constexpr std::memory_order kWriteEnd = std::memory_order_release;
+
+    static void AfterReadBegin() noexcept { std::atomic_thread_fence(std::memory_order_acquire); }
+    static void BeforeReadEnd() noexcept { Hardware(); }
+    static void AfterWriteBegin() noexcept { Hardware(); }
+
+   private:
+    static void Hardware() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+        asm volatile("" : : : "memory");
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        asm volatile("dmb sy" : : : "memory");
+#else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+    }
+};
+
+/// `ThreadFence` only uses C++ fences, and so needs no porting: an acquire fence before the second sequence number
+/// load, and a release fence after the odd sequence number store. They cost nothing on x86 and are one-way barriers,
+/// cheaper than `dmb sy`, on ARM.
+struct ThreadFence {
+    static constexpr std::memory_order kReadBegin = std::memory_order_acquire;
+    static constexpr std::memory_order kReadEnd = std::memory_order_relaxed;
+    static constexpr std::memory_order kWriteBegin = std::memory_order_relaxed;
+    static constexpr std::memory_order kWriteEnd = std::memory_order_release;
+
+    static void AfterReadBegin() noexcept {}
+    static void BeforeReadEnd() noexcept { std::atomic_thread_fence(std::memory_order_acquire); }
+    static void AfterWriteBegin() noexcept { std::atomic_thread_fence(std::memory_order_release); }
+};
+
+/// `SeqCst` makes every sequence number access and fence sequentially consistent. It is the simplest to reason about
+/// and the most expensive: on x86, each store is an `xchg` and each fence an `mfence`.
+struct SeqCst {
+    static constexpr std::memory_order kReadBegin = std::memory_order_seq_cst;
+    static constexpr std::memory_order kReadEnd = std::memory_order_seq_cst;
+    static constexpr std::memory_order kWriteBegin = std::memory_order_seq_cst;
+    static constexpr std::memory_order kWriteEnd = std::memory_order_seq_cst;
+
+    static void AfterReadBegin() noexcept {}
+    static void BeforeReadEnd() noexcept { std::atomic_thread_fence(std::memory_order_seq_cst); }
+    static void AfterWriteBegin() noexcept { std::atomic_thread_fence(std::memory_order_seq_cst); }
+};
+
+/// `AcquireLoad` loads both sequence numbers with acquire semantics and has no reader fence. It is the cheapest reader,
+/// but not a correct one in general: an acquire load keeps later loads after it, not earlier ones, so the compiler or
+/// the CPU may move loads of the data past the second sequence number load. Only use it on targets where the generated
+/// code was checked, or as a baseline in benchmarks.
+struct AcquireLoad {
+    static constexpr std::memory_order kReadBegin = std::memory_order_acquire;
+    static constexpr std::memory_order kReadEnd = std::memory_order_acquire;
+    static constexpr std::memory_order kWriteBegin = std::memory_order_relaxed;
+    static constexpr std::memory_order kWriteEnd = std::memory_order_release;
+
+    static void AfterReadBegin() noexcept {}
+    static void BeforeReadEnd() noexcept {}
+    static void AfterWriteBegin() noexcept { std::atomic_thread_fence(std::memory_order_release); }
+};
+
+template <typename T>
+concept Policy = requires {
+    { T::kReadBegin } -> std::convertible_to<std::memory_order>;
+    { T::kReadEnd } -> std::convertible_to<std::memory_order>;
+    { T::kWriteBegin } -> std::convertible_to<std::memory_order>;
+    { T::kWriteEnd } -> std::convertible_to<std::memory_order>;
+    T::AfterReadBegin();
+    T::BeforeReadEnd();
+    T::AfterWriteBegin();
+};
+
+}  // namespace fence
+
+/// `UpdateAwaiter` is the awaitable returned by `SeqLock::NextUpdate`. It completes once the sequence number of the
+/// lock differs from the last sequence number seen by the awaiting coroutine and no write is in progress. `co_await`
+/// yields the sequence number that satisfied the wait, which callers pass to the next `NextUpdate`.
+///
+/// `UpdateAwaiter` does not poll by itself: a suspended coroutine is handed to its promise through
+/// `promise.Park(awaiter, handle)`, and the promise's scheduler is expected to call `Ready()` until it returns true and
+/// then resume the coroutine. See `PollScheduler` in `poll.hpp`.
+class UpdateAwaiter {
+   public:
+    UpdateAwaiter(const std::atomic<uint64_t>& seq, uint64_t last_seq) noexcept : seq_{seq}, last_seq_{last_seq} {}
+
+    /// `Ready` returns true if the sequence number moved past `last_seq` and no write is in progress.
+    bool Ready() noexcept {
+        observed_ = seq_.load(std::memory_order_acquire);
+        return observed_ != last_seq_ and (observed_ & 1ULL) == 0ULL;
+    }
+
+    bool await_ready() noexcept { return Ready(); }
+
+    template <typename PromiseT>
+    void await_suspend(std::coroutine_handle<PromiseT> handle) noexcept {
+        handle.promise().Park(*this, handle);
+    }
+
+    uint64_t await_resume() const noexcept { return observed_; }
+
+   private:
+    const std::atomic<uint64_t>& seq_;
+    uint64_t last_seq_;
+    uint64_t observed_{0};
+};
+
 /// `SeqLock` is a fast, lock-free and potentially wait-free multi-writer-multi-reader lock that guarantees writers are
 /// not starved by readers. This comes at the expense of readers having to retry reads until they're successful. If
 /// there is a single writer, all writes are guaranteed to be wait-free. If there are multiple writers, then they're
@@ -36,14 +188,22 @@ concept Mode = std::same_as<T, mode::SingleWriter> or std::same_as<T, mode::Mult
 /// It is guaranteed that the performance of the `SeqLock` stays the same no matter the number of readers.
 ///
 /// Callers are expected to instantiate the right SeqLock based on the number of writers: `SeqLock<mode::SingleWriter>`
-/// for a single writer or `SeqLock<mode::MultiWriter>` for multiple writers. The right `Store` function is chosen at
-/// compile-time based on the passed mode. Readers are not impacted by the writer `mode`: the `Load` function is the
+/// for a single writer or `SeqLock<mode::MultiWriter>` for multiple writers. `SeqLock<mode::CompactMultiWriter<>>` is
+/// a multi-writer lock half the size, for large arrays of locks. The right `Store` function is chosen at compile-time
+/// based on the passed mode. Readers are not impacted by the writer `mode`: the `Load` function is the
 /// same no matter the `mode`. For multi-process synchronization (see the `examples` folder), it is recommended that the
 /// readers have the same mode as the writers for code clarity.
-template <mode::Mode ModeT>
+///
+/// `InlineSize` bytes of data can be stored right after the sequence number, in the same cache line, and accessed with
+/// `InlineData`. Readers of small payloads then touch a single cache line instead of two. See `GuardedRegion`.
+///
+/// `FenceT` sets the memory orders and fences of loads and stores, see the `fence` namespace.
+template <mode::Mode ModeT, size_t InlineSize = 0, fence::Policy FenceT = fence::Barrier>
 class SeqLock {
    private:
-    using SeqT = std::atomic<uint64_t>;
+    using SeqT = std::atomic<typename mode::SeqValue<ModeT>::type>;
+
+    static_assert(sizeof(SeqT) + InlineSize <= 64, "Inline data must fit in the sequence number's cache line.");
 
    public:
     SeqLock() { static_assert(SeqT::is_always_lock_free, "Sequence number type must be lock-free."); }
@@ -68,7 +228,13 @@ class SeqLock {
 
     /// `WriterStalled` returns true if at least one writer is stalled from a set of writers updating the shared memory
     /// with `StoreMulti` or `TryStoreMulti`.
-    bool WriterStalled() const noexcept { return writer_lock_.IsAcquired(); }
+    bool WriterStalled() const noexcept {
+        if constexpr (mode::Compact<ModeT>) {
+            return WriteInProgress();
+        } else {
+            return writer_lock_.IsAcquired();
+        }
+    }
 
     /// `Store` executes `store_fn`, a function meant to update the shared memory synchronized through this lock. This
     /// function is only defined if the mode is `mode::SingleWriter. It is guaranteed that the single writer that
@@ -116,6 +282,40 @@ class SeqLock {
         return false;
     }
 
+    /// `Store` executes `store_fn`, a function meant to update the shared memory synchronized through this lock. This
+    /// function is only defined if the mode is `mode::CompactMultiWriter`. The writer acquires the lock by CAS-ing the
+    /// sequence number from even to odd, spinning while another write is in progress.
+    ///
+    /// Callers must ensure `store_fn` only stores to and does load anything from the shared memory that's synchronized
+    /// through the `SeqLock`.
+    template <typename StoreFnT>
+    void Store(StoreFnT&& store_fn) noexcept
+        requires mode::Compact<ModeT>
+    {
+        while (not TryStore(store_fn)) {
+            while (WriteInProgress()) {
+            }
+        }
+    }
+
+    /// `TryStore` is like `Store` but returns `false` without executing `store_fn` if there is already a write in
+    /// progress or if another writer acquires the lock first. This function is only defined if the mode is
+    /// `mode::CompactMultiWriter`.
+    template <typename StoreFnT>
+    bool TryStore(StoreFnT&& store_fn) noexcept
+        requires mode::Compact<ModeT>
+    {
+        typename SeqT::value_type seq_init = seq_.load(std::memory_order_relaxed);
+        if ((seq_init & 1U) != 0U or
+            not seq_.compare_exchange_strong(seq_init, seq_init + 1, kAcquireOrder, std::memory_order_relaxed)) {
+            return false;
+        }
+        FenceT::AfterWriteBegin();
+        store_fn();
+        seq_.store(seq_init + 2, FenceT::kWriteEnd);
+        return true;
+    }
+
     /// `TryLoad` tries to execute the provided `load_fn`, a function meant to read from the shared memory synchronized
     /// through this lock. If the function is executed successfully, `true` is returned - the shared piece of data was
     /// read correctly, in a synchronized manner. Otherwise, `false` is returned.
@@ -124,11 +324,11 @@ class SeqLock {
     /// synchronized through the `SeqLock`.
     template <typename LoadFnT>
     bool TryLoad(LoadFnT&& load_fn) const noexcept {
-        if (const SeqT::value_type seq_start = seq_.load(std::memory_order_relaxed); (seq_start & 1ULL) == 0ULL) {
-            std::atomic_thread_fence(std::memory_order_acquire);
+        if (const typename SeqT::value_type seq_start = seq_.load(FenceT::kReadBegin); (seq_start & 1ULL) == 0ULL) {
+            FenceT::AfterReadBegin();
             load_fn();
-            BARRIER;
-            const SeqT::value_type seq_end = seq_.load(std::memory_order_relaxed);
+            FenceT::BeforeReadEnd();
+            const typename SeqT::value_type seq_end = seq_.load(FenceT::kReadEnd);
             return seq_start == seq_end;
         }
         return false;
@@ -141,27 +341,75 @@ class SeqLock {
         }
     }
 
+    /// `NextUpdate` returns an awaitable which completes once a write committed after the sequence number `last_seq`
+    /// was observed. `co_await lock.NextUpdate(seq)` evaluates to the new sequence number. The awaiting coroutine must
+    /// run on a scheduler that polls parked awaiters, like `PollScheduler` in `poll.hpp`.
+    UpdateAwaiter NextUpdate(uint64_t last_seq) const noexcept
+        requires std::same_as<typename SeqT::value_type, uint64_t>
+    {
+        return UpdateAwaiter{seq_, last_seq};
+    }
+
+    /// `InlineData` returns the `InlineSize` bytes stored next to the sequence number.
+    char* InlineData() noexcept
+        requires(InlineSize > 0)
+    {
+        return inline_data_.data();
+    }
+
+    const char* InlineData() const noexcept
+        requires(InlineSize > 0)
+    {
+        return inline_data_.data();
+    }
+
    private:
     alignas(64) SeqT seq_{0};
 
+    // Occupies 0 bytes if there is no inline data.
+    [[no_unique_address]] std::conditional_t<(InlineSize > 0), std::array<char, InlineSize>, std::monostate>
+        inline_data_;
+
     // Define the `SpinLock` only if in `mode::MultiWriter`. Otherwise, this member variable occupies 0 bytes. It is
     // guaranteed that `seq_` is when this lock is not held.
     [[no_unique_address]] std::conditional_t<std::is_same_v<ModeT, mode::MultiWriter>, SpinLock, std::monostate>
         writer_lock_{};
 
+    // A compact writer acquires the lock with the odd sequence number, so the exchange must at least acquire.
+    static constexpr std::memory_order kAcquireOrder =
+        FenceT::kWriteBegin == std::memory_order_seq_cst ? std::memory_order_seq_cst : std::memory_order_acquire;
+
     template <typename StoreFnT>
     void SingleWriterStore(StoreFnT&& store_fn) {
-        const SeqT::value_type seq_init = seq_.load(std::memory_order::relaxed);
-        seq_.store(seq_init + 1, std::memory_order::relaxed);
-        BARRIER;
+        const typename SeqT::value_type seq_init = seq_.load(std::memory_order::relaxed);
+        seq_.store(seq_init + 1, FenceT::kWriteBegin);
+        FenceT::AfterWriteBegin();
         store_fn();
-        seq_.store(seq_init + 2, std::memory_order::release);
+        seq_.store(seq_init + 2, FenceT::kWriteEnd);
     }
 };
 
 /// A utility class holding N bytes guarded by a SeqLock of the given mode.
-template <mode::Mode ModeT, size_t N>
+///
+/// Payloads that fit in the sequence number's cache line, up to 56 bytes with a 64-bit sequence number, are stored
+/// there: a reader then touches a single cache line instead of two. Larger payloads start on the next cache line. For
+/// payloads up to 16 bytes, see also `AtomicRegion` in `atomic_region.hpp`. `FenceT` is the fence policy of the lock.
+///
+/// In the `MultiWriter` mode, the payload always starts at offset 128, after the writer lock, whatever its size: the Go
+/// and Python bindings write to shared regions with this layout, see `seqlock_multi_writer_create_shared`.
+template <mode::Mode ModeT, size_t N, fence::Policy FenceT = fence::Barrier>
 class GuardedRegion {
+   private:
+    static constexpr bool kInline =
+        not std::same_as<ModeT, mode::MultiWriter> and sizeof(typename mode::SeqValue<ModeT>::type) + N <= 64;
+
+    static constexpr size_t kLineSize = 64;
+    static constexpr size_t kLines = (N + kLineSize - 1) / kLineSize;
+
+    // Stands for `data_` when the payload is stored in the lock. Unlike `std::monostate`, which the lock might already
+    // hold, it is free to share the lock's address and occupy 0 bytes.
+    struct InLock {};
+
    public:
     GuardedRegion() = default;
     ~GuardedRegion() = default;
@@ -175,22 +423,190 @@ class GuardedRegion {
     GuardedRegion& operator=(GuardedRegion&&) = delete;
 
     void Set(int v) {
-        lock_.Store([&] { std::memset(data_, v, N); });
+        lock_.Store([&] { std::memset(Data(), v, N); });
+    }
+
+    void Store(const char* from, size_t size) {
+        lock_.Store([&] { std::memcpy(Data(), from, std::min(size, N)); });
+    }
+
+    /// `StoreChanged` is like `Store` but only writes the 64-byte lines of the region that differ from `from`, such
+    /// that readers keep the unchanged lines in their caches. Returns the number of lines written.
+    ///
+    /// A single writer compares the lines before taking the lock, which then only covers the copy of the changed lines,
+    /// and stores nothing if no line changed: the sequence number then stays the same. Multiple writers compare the
+    /// lines while holding the lock, since another writer might change the region in between.
+    size_t StoreChanged(const char* from, size_t size) {
+        size = std::min(size, N);
+        ChangedLines changed{};
+        if constexpr (std::same_as<ModeT, mode::SingleWriter>) {
+            // As the only writer, nothing changes the region while it is compared.
+            const size_t count = FindChanged(from, size, changed);
+            if (count > 0) {
+                lock_.Store([&] { CopyChanged(from, size, changed); });
+            }
+            return count;
+        } else {
+            size_t count{0};
+            lock_.Store([&] {
+                count = FindChanged(from, size, changed);
+                CopyChanged(from, size, changed);
+            });
+            return count;
+        }
     }
 
-    void Store(char* from, size_t size) {
-        lock_.Store([&] { std::memcpy(data_, from, std::min(size, N)); });
+    /// `TryLoad` tries to copy the region into `into` once. Returns false if a write interfered. Otherwise, returns
+    /// true and sets `seq`, if given, to the sequence number of the copied version.
+    bool TryLoad(char* into, size_t size, uint64_t* seq = nullptr) const {
+        return TryLoadWith([&](const char* data) { std::memcpy(into, data, std::min(size, N)); }, seq);
     }
 
-    void Load(char* into, size_t size) {
-        lock_.Load([&] { std::memcpy(into, data_, std::min(size, N)); });
+    /// `TryLoadWith` is like `TryLoad` but lets `copy_fn(data)` copy the N bytes of the region out of `data` itself,
+    /// like `ParallelCopier` in `parallel.hpp` does with several threads. `copy_fn` must only load from `data`.
+    template <typename CopyFnT>
+    bool TryLoadWith(CopyFnT&& copy_fn, uint64_t* seq = nullptr) const {
+        uint64_t loaded_seq{0};
+        const bool ok = lock_.TryLoad([&] {
+            // Read between the two sequence number loads of `TryLoad`, so it equals them if the load succeeds.
+            loaded_seq = lock_.Sequence();
+            copy_fn(Data());
+        });
+        if (ok and seq != nullptr) {
+            *seq = loaded_seq;
+        }
+        return ok;
     }
 
+    /// `Load` copies the region into `into` and returns the sequence number of the copied version.
+    uint64_t Load(char* into, size_t size) const {
+        uint64_t seq{0};
+        while (not TryLoad(into, size, &seq)) {
+        }
+        return seq;
+    }
+
+    /// `Sequence` returns the current sequence number of the lock guarding the region.
+    uint64_t Sequence() const noexcept { return lock_.Sequence(); }
+
+    /// `NextUpdate` returns an awaitable which completes once the region is updated past `last_seq`. See
+    /// `SeqLock::NextUpdate`.
+    UpdateAwaiter NextUpdate(uint64_t last_seq) const noexcept { return lock_.NextUpdate(last_seq); }
+
     static constexpr size_t Size() noexcept { return N; }
 
+    /// `IsInline` returns true if the payload shares the cache line of the sequence number.
+    static constexpr bool IsInline() noexcept { return kInline; }
+
+    /// `DataOffset` returns the offset of the payload from the start of the region, where the bindings in other
+    /// languages must find it to share the region.
+    static constexpr size_t DataOffset() noexcept {
+        return kInline ? sizeof(typename mode::SeqValue<ModeT>::type) : sizeof(SeqLock<ModeT, 0, FenceT>);
+    }
+
    private:
-    SeqLock<ModeT> lock_;
-    char data_[N];
+    SeqLock<ModeT, kInline ? N : 0, FenceT> lock_;
+    [[no_unique_address]] std::conditional_t<kInline, InLock, char[N]> data_;
+
+    char* Data() noexcept {
+        if constexpr (kInline) {
+            return lock_.InlineData();
+        } else {
+            return data_;
+        }
+    }
+
+    const char* Data() const noexcept {
+        if constexpr (kInline) {
+            return lock_.InlineData();
+        } else {
+            return data_;
+        }
+    }
+
+    // One bit per line of the payload. Lines are counted from the start of the payload, which is cache-line aligned
+    // unless it is inline, and the last one ends at the size of the store.
+    using ChangedLines = std::array<uint64_t, (kLines + 63) / 64>;
+
+    // Sets the bits of the lines of `from` that differ from the region and returns their number.
+    size_t FindChanged(const char* from, size_t size, ChangedLines& changed) const noexcept {
+        const size_t full_lines = size / kLineSize;
+#if defined(__AVX2__)
+        size_t count = FindChangedAvx2(Data(), from, full_lines, changed.data());
+#elif defined(__x86_64__) || defined(_M_X64)
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        size_t count = avx2 ? FindChangedAvx2(Data(), from, full_lines, changed.data())
+                            : FindChangedSse2(Data(), from, full_lines, changed.data());
+#else
+        size_t count{0};
+        for (size_t line = 0; line < full_lines; line++) {
+            if (std::memcmp(Data() + line * kLineSize, from + line * kLineSize, kLineSize) != 0) {
+                changed[line / 64] |= uint64_t{1} << (line % 64);
+                count++;
+            }
+        }
+#endif
+        const size_t offset = full_lines * kLineSize;
+        if (offset < size and std::memcmp(Data() + offset, from + offset, size - offset) != 0) {
+            changed[full_lines / 64] |= uint64_t{1} << (full_lines % 64);
+            count++;
+        }
+        return count;
+    }
+
+    void CopyChanged(const char* from, size_t size, const ChangedLines& changed) noexcept {
+        for (size_t word = 0; word < changed.size(); word++) {
+            for (uint64_t bits = changed[word]; bits != 0; bits &= bits - 1) {
+                const size_t offset = (word * 64 + static_cast<size_t>(std::countr_zero(bits))) * kLineSize;
+                if (N >= kLineSize and size - offset >= kLineSize) {
+                    // A constant size, which compilers copy with a few vector moves instead of a call.
+                    std::memcpy(Data() + offset, from + offset, kLineSize);
+                } else {
+                    std::memcpy(Data() + offset, from + offset, size - offset);
+                }
+            }
+        }
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    // SSE2 is part of x86-64, so it needs no runtime check.
+    static size_t FindChangedSse2(const char* data, const char* from, size_t lines, uint64_t* changed) noexcept {
+        const auto equal = [](const char* a, const char* b) {
+            return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+        };
+        size_t count{0};
+        for (size_t line = 0; line < lines; line++) {
+            const char* a = data + line * kLineSize;
+            const char* b = from + line * kLineSize;
+            const __m128i low = _mm_and_si128(equal(a, b), equal(a + 16, b + 16));
+            const __m128i high = _mm_and_si128(equal(a + 32, b + 32), equal(a + 48, b + 48));
+            if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF) {
+                changed[line / 64] |= uint64_t{1} << (line % 64);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    __attribute__((target("avx2"))) static size_t FindChangedAvx2(const char* data, const char* from, size_t lines,
+                                                                  uint64_t* changed) noexcept {
+        size_t count{0};
+        for (size_t line = 0; line < lines; line++) {
+            const char* a = data + line * kLineSize;
+            const char* b = from + line * kLineSize;
+            const __m256i low = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                                                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+            const __m256i high = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 32)),
+                                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32)));
+            if (_mm256_movemask_epi8(_mm256_and_si256(low, high)) != -1) {
+                changed[line / 64] |= uint64_t{1} << (line % 64);
+                count++;
+            }
+        }
+        return count;
+    }
+#endif
 };
 
 }  // namespace seqlock
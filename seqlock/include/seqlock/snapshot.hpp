@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "seqlock/seqlock.hpp"
+
+namespace seqlock {
+
+/// `SnapshotPublisher` shares the latest version of a `GuardedRegion` between the threads of a process. Instead of
+/// every thread copying the region out and racing the writer, one thread takes the validated copy with `Refresh` and
+/// publishes it as an immutable snapshot, which any number of threads then read in place.
+///
+/// Snapshots live in a pool of `Buffers` buffers and are reference counted: a buffer is reused once no reader holds it
+/// anymore, so publishing never allocates. A reader holding a snapshot for long pins its buffer; `Refresh` skips a
+/// version and returns `kPinned` when every buffer is pinned, so the pool should have one more buffer than the number
+/// of snapshots held at any time, plus the published one.
+///
+/// `Refresh` must be called by a single thread at a time. `Acquire` and `Sequence` may be called from any thread.
+/// The pool is stored inline, so large publishers should be allocated on the heap.
+template <size_t N, size_t Buffers = 4>
+class SnapshotPublisher {
+   private:
+    static_assert(Buffers >= 2, "Publishing while a snapshot is read needs at least two buffers.");
+
+    // Added to the reference count of a buffer while `Refresh` writes to it.
+    static constexpr uint64_t kWriting = uint64_t{1} << 32;
+
+    struct alignas(64) Buffer {
+        std::atomic<uint64_t> refs{0};
+        uint64_t seq{0};
+        alignas(64) char data[N];
+    };
+
+   public:
+    /// `RefreshStatus` is the outcome of a `Refresh`.
+    enum class RefreshStatus {
+        // A new snapshot was published.
+        kPublished,
+        // The region did not change since the last published snapshot.
+        kUnchanged,
+        // The region changed, but readers held every buffer. The version is published by a later `Refresh`.
+        kPinned,
+    };
+
+    /// `Snapshot` is a reference to a published version. The version is immutable and stays valid until the snapshot
+    /// is destroyed, whatever `Refresh` publishes in the meantime.
+    class Snapshot {
+       public:
+        Snapshot() = default;
+        ~Snapshot() { Release(); }
+
+        // Copy.
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        // Move.
+        Snapshot(Snapshot&& other) noexcept : buffer_{std::exchange(other.buffer_, nullptr)} {}
+        Snapshot& operator=(Snapshot&& other) noexcept {
+            if (this != &other) {
+                Release();
+                buffer_ = std::exchange(other.buffer_, nullptr);
+            }
+            return *this;
+        }
+
+        /// `Empty` returns true if nothing was published when the snapshot was acquired.
+        bool Empty() const noexcept { return buffer_ == nullptr; }
+
+        const char* Data() const noexcept { return buffer_->data; }
+
+        /// `Sequence` returns the sequence number of the region's version held by the snapshot.
+        uint64_t Sequence() const noexcept { return buffer_ == nullptr ? 0 : buffer_->seq; }
+
+        static constexpr size_t Size() noexcept { return N; }
+
+       private:
+        friend class SnapshotPublisher;
+
+        explicit Snapshot(Buffer* buffer) noexcept : buffer_{buffer} {}
+
+        void Release() noexcept {
+            if (buffer_ != nullptr) {
+                buffer_->refs.fetch_sub(1, std::memory_order_release);
+                buffer_ = nullptr;
+            }
+        }
+
+        Buffer* buffer_{nullptr};
+    };
+
+    SnapshotPublisher() = default;
+    ~SnapshotPublisher() = default;
+
+    // Copy.
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Move.
+    SnapshotPublisher(SnapshotPublisher&&) = delete;
+    SnapshotPublisher& operator=(SnapshotPublisher&&) = delete;
+
+    /// `Refresh` publishes the current version of `region` if it changed since the last refresh. A caller that must not
+    /// miss the latest version calls it again after `kPinned`, once readers released some snapshots.
+    template <mode::Mode ModeT>
+    RefreshStatus Refresh(const GuardedRegion<ModeT, N>& region) noexcept {
+        if (const uint64_t seq = region.Sequence(); seq == published_seq_.load(std::memory_order_relaxed)) {
+            return RefreshStatus::kUnchanged;
+        }
+        Buffer* buffer = Reserve();
+        if (buffer == nullptr) {
+            return RefreshStatus::kPinned;
+        }
+        buffer->seq = region.Load(buffer->data, N);
+        Publish(buffer);
+        return RefreshStatus::kPublished;
+    }
+
+    /// `Acquire` returns the latest published snapshot, or an empty one if nothing was published yet.
+    Snapshot Acquire() const noexcept {
+        while (true) {
+            Buffer* buffer = current_.load(std::memory_order_acquire);
+            if (buffer == nullptr) {
+                return Snapshot{};
+            }
+            const uint64_t refs = buffer->refs.fetch_add(1, std::memory_order_acquire);
+            // Between the two loads, the buffer might have been released and reserved by `Refresh`, which is writing
+            // to it. It might also hold an older version, released but not reused yet.
+            if ((refs & kWriting) == 0 and current_.load(std::memory_order_relaxed) == buffer) {
+                return Snapshot{buffer};
+            }
+            buffer->refs.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /// `Sequence` returns the sequence number of the latest published snapshot, 0 if nothing was published yet. It
+    /// lets readers skip `Acquire` when they already hold the latest snapshot.
+    uint64_t Sequence() const noexcept { return published_seq_.load(std::memory_order_acquire); }
+
+    static constexpr size_t Size() noexcept { return N; }
+
+   private:
+    alignas(64) std::atomic<Buffer*> current_{nullptr};
+    std::atomic<uint64_t> published_seq_{0};
+    size_t next_{0};
+    Buffer buffers_[Buffers];
+
+    // Returns a buffer that no reader holds, marked as being written, or a null pointer if there is none.
+    Buffer* Reserve() noexcept {
+        for (size_t i = 0; i < Buffers; i++) {
+            Buffer& buffer = buffers_[(next_ + i) % Buffers];
+            uint64_t free{0};
+            if (&buffer != current_.load(std::memory_order_relaxed) and
+                buffer.refs.compare_exchange_strong(free, kWriting, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+                next_ = (next_ + i + 1) % Buffers;
+                return &buffer;
+            }
+        }
+        return nullptr;
+    }
+
+    void Publish(Buffer* buffer) noexcept {
+        // The publisher holds one reference to the current buffer, dropped when the next one replaces it. Readers which
+        // incremented the count while the buffer was being written drop theirs on their own.
+        buffer->refs.fetch_sub(kWriting - 1, std::memory_order_release);
+        Buffer* previous = current_.exchange(buffer, std::memory_order_acq_rel);
+        published_seq_.store(buffer->seq, std::memory_order_release);
+        if (previous != nullptr) {
+            previous->refs.fetch_sub(1, std::memory_order_release);
+        }
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/spinlock.hpp"
+
+namespace seqlock {
+
+/// `SortedIndex` is a fixed-capacity ordered map from 64-bit integer keys to values, meant to live in shared memory for
+/// range queries such as "levels between two prices" or "symbols in a prefix range" (with symbols packed big-endian in
+/// a `uint64_t`). Readers do lock-free `Find`, `LowerBound` and `Range` queries which retry if they race with a
+/// writer. Writers are synchronized as in `SharedHashMap`: a single writer is wait-free, and multiple writers
+/// (`mode::MultiWriter`) take turns through an index-wide spin-lock.
+///
+/// Entries are kept sorted in nodes of 16 keys, like the leaves of a B+-tree, and each node is guarded by its own
+/// `SeqLock` sequence. A directory, guarded by another sequence, holds the smallest key each node may hold. Inserts and
+/// deletes shift entries in place within a single node, so they only make readers of that node retry. A node that
+/// overflows is split in two, and a node that falls below half full is merged with or rebalanced against its
+/// neighbour: only these change the directory and make all readers retry.
+///
+/// Readers binary-search the directory and then compare the key against all keys of a node at once, with AVX2 when the
+/// CPU supports it.
+template <mode::Mode ModeT, typename KeyT, typename ValueT, size_t Capacity>
+class SortedIndex {
+   private:
+    static_assert(std::integral<KeyT> and sizeof(KeyT) == 8, "Key type must be a 64-bit integer.");
+    static_assert(std::is_trivially_copyable_v<ValueT>, "Value type must be trivially copyable.");
+    static_assert(Capacity > 0, "SortedIndex must have a non-zero capacity.");
+
+    static constexpr size_t kNodeKeys = 16;
+    static constexpr size_t kMinKeys = kNodeKeys / 2;
+    // Every node but a lone one holds at least `kMinKeys` entries, and a split needs one more node.
+    static constexpr size_t kNodes = Capacity / kMinKeys + 1;
+    // The directory is searched in windows of `kNodeKeys` keys, which may extend past the last node.
+    static constexpr size_t kDirectoryKeys = (kNodes + 2 * kNodeKeys - 1) / kNodeKeys * kNodeKeys;
+
+    // Keys are stored as signed integers such that they compare like `KeyT`.
+    static constexpr int64_t kMinKey = std::numeric_limits<int64_t>::min();
+
+    // The sequence numbers guard the number of entries, stored next to them, and the arrays.
+    struct Node {
+        SeqLock<mode::SingleWriter, sizeof(uint32_t)> lock;
+        alignas(64) int64_t keys[kNodeKeys]{};
+        ValueT values[kNodeKeys];
+    };
+
+    struct Directory {
+        SeqLock<mode::SingleWriter, sizeof(uint32_t)> lock;
+        // `keys[i]` is the smallest key of `nodes[i]`, which holds the keys up to `keys[i + 1]`. `keys[0]` is always
+        // the smallest key.
+        alignas(64) int64_t keys[kDirectoryKeys]{};
+        uint32_t nodes[kNodes]{};
+    };
+
+   public:
+    struct Entry {
+        KeyT key;
+        ValueT value;
+    };
+
+    SortedIndex() {
+        directory_.keys[0] = kMinKey;
+        SetCount(directory_.lock, 1);
+        SetCount(nodes_[0].lock, 0);
+        for (size_t i = 1; i < kNodes; i++) {
+            free_[free_count_++] = static_cast<uint32_t>(kNodes - i);
+        }
+    }
+    ~SortedIndex() = default;
+
+    // Copy.
+    SortedIndex(const SortedIndex&) = delete;
+    SortedIndex& operator=(const SortedIndex&) = delete;
+
+    // Move.
+    SortedIndex(SortedIndex&&) = delete;
+    SortedIndex& operator=(SortedIndex&&) = delete;
+
+    /// `Find` copies the value of `key` into `value` and returns true if `key` is in the index. Otherwise, `value` is
+    /// left untouched and false is returned.
+    bool Find(KeyT key, ValueT& value) const noexcept {
+        Entry entry;
+        if (LowerBound(key, entry) and entry.key == key) {
+            value = entry.value;
+            return true;
+        }
+        return false;
+    }
+
+    bool Contains(KeyT key) const noexcept {
+        ValueT value;
+        return Find(key, value);
+    }
+
+    /// `LowerBound` copies the entry with the smallest key not less than `key` into `entry` and returns true, or
+    /// returns false if all keys are less than `key`.
+    bool LowerBound(KeyT key, Entry& entry) const noexcept {
+        return Range(key, std::numeric_limits<KeyT>::max(), std::span{&entry, 1}, true) == 1;
+    }
+
+    /// `Range` copies the entries with keys from `from` up to, but excluding, `to` into `into`, in order, and returns
+    /// their number. At most `into.size()` entries are copied.
+    ///
+    /// Each node is copied consistently, and entries never move between nodes during the copy, so every copied entry
+    /// was in the index at some point during the call. Entries of different nodes might come from different writes.
+    size_t Range(KeyT from, KeyT to, std::span<Entry> into) const noexcept { return Range(from, to, into, false); }
+
+    /// `Upsert` inserts `key` with `value` or updates the value of `key` if it is already in the index. Returns false
+    /// if the index is full and `key` is not in the index.
+    bool Upsert(KeyT key, const ValueT& value) noexcept {
+        return Exclusive([&] {
+            const int64_t k = ToOrdered(key);
+            const size_t position = Locate(directory_, k);
+            Node& node = nodes_[directory_.nodes[position]];
+            const size_t count = Count(node.lock);
+            const size_t i = LowerBoundInNode(node, count, k);
+            if (i < count and node.keys[i] == k) {
+                node.lock.Store([&] { std::memcpy(&node.values[i], &value, sizeof(ValueT)); });
+                return true;
+            }
+            if (Size() == Capacity) {
+                return false;
+            }
+
+            if (count < kNodeKeys) {
+                node.lock.Store([&] {
+                    std::memmove(&node.keys[i + 1], &node.keys[i], (count - i) * sizeof(int64_t));
+                    std::memmove(&node.values[i + 1], &node.values[i], (count - i) * sizeof(ValueT));
+                    node.keys[i] = k;
+                    std::memcpy(&node.values[i], &value, sizeof(ValueT));
+                    SetCount(node.lock, count + 1);
+                });
+            } else {
+                Split(position, i, k, value);
+            }
+            size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    /// `Erase` removes `key` from the index. Returns false if `key` is not in the index.
+    bool Erase(KeyT key) noexcept {
+        return Exclusive([&] {
+            const int64_t k = ToOrdered(key);
+            const size_t position = Locate(directory_, k);
+            Node& node = nodes_[directory_.nodes[position]];
+            const size_t count = Count(node.lock);
+            const size_t i = LowerBoundInNode(node, count, k);
+            if (i == count or node.keys[i] != k) {
+                return false;
+            }
+
+            if (count > kMinKeys or Count(directory_.lock) == 1) {
+                node.lock.Store([&] {
+                    std::memmove(&node.keys[i], &node.keys[i + 1], (count - i - 1) * sizeof(int64_t));
+                    std::memmove(&node.values[i], &node.values[i + 1], (count - i - 1) * sizeof(ValueT));
+                    SetCount(node.lock, count - 1);
+                });
+            } else {
+                Underflow(position, i);
+            }
+            size_.store(size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    /// `Size` returns the number of keys in the index.
+    size_t Size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t MaxSize() noexcept { return Capacity; }
+
+   private:
+    Directory directory_;
+    Node nodes_[kNodes];
+
+    // Only accessed by writers: the nodes that are not in the directory.
+    uint32_t free_[kNodes]{};
+    size_t free_count_{0};
+
+    std::atomic<size_t> size_{0};
+
+    // Define the `SpinLock` only if there can be multiple writers. Otherwise, it occupies 0 bytes as in `SeqLock`.
+    [[no_unique_address]] std::conditional_t<not std::is_same_v<ModeT, mode::SingleWriter>, SpinLock, std::monostate>
+        writer_lock_{};
+
+    template <typename FnT>
+    bool Exclusive(FnT&& fn) noexcept {
+        if constexpr (not std::is_same_v<ModeT, mode::SingleWriter>) {
+            bool result{false};
+            writer_lock_([&] { result = fn(); });
+            return result;
+        } else {
+            return fn();
+        }
+    }
+
+    static constexpr int64_t ToOrdered(KeyT key) noexcept {
+        if constexpr (std::is_signed_v<KeyT>) {
+            return static_cast<int64_t>(key);
+        } else {
+            return static_cast<int64_t>(key ^ (uint64_t{1} << 63));
+        }
+    }
+
+    static constexpr KeyT FromOrdered(int64_t key) noexcept {
+        if constexpr (std::is_signed_v<KeyT>) {
+            return static_cast<KeyT>(key);
+        } else {
+            return static_cast<KeyT>(static_cast<uint64_t>(key) ^ (uint64_t{1} << 63));
+        }
+    }
+
+    template <typename LockT>
+    static size_t Count(const LockT& lock) noexcept {
+        uint32_t count{0};
+        std::memcpy(&count, lock.InlineData(), sizeof(count));
+        return count;
+    }
+
+    template <typename LockT>
+    static void SetCount(LockT& lock, size_t count) noexcept {
+        const auto value = static_cast<uint32_t>(count);
+        std::memcpy(lock.InlineData(), &value, sizeof(value));
+    }
+
+    size_t Range(KeyT from, KeyT to, std::span<Entry> into, bool unbounded) const noexcept {
+        const int64_t lo = ToOrdered(from);
+        const int64_t hi = ToOrdered(to);
+        if (into.empty() or (lo >= hi and not unbounded)) {
+            return 0;
+        }
+
+        size_t copied{0};
+        directory_.lock.Load([&] {
+            copied = 0;
+            // Counts might be torn until the sequence numbers are checked, so they are capped to stay in bounds.
+            const size_t nodes = std::min(Count(directory_.lock), kNodes);
+            for (size_t position = Locate(directory_, lo); position < nodes; position++) {
+                const Node& node = nodes_[std::min<size_t>(directory_.nodes[position], kNodes - 1)];
+                bool done{false};
+                size_t node_copied{0};
+                node.lock.Load([&] {
+                    const size_t count = std::min(Count(node.lock), kNodeKeys);
+                    const size_t begin = LowerBoundInNode(node, count, lo);
+                    const size_t end = unbounded ? count : LowerBoundInNode(node, count, hi);
+                    node_copied = std::min(end - std::min(begin, end), into.size() - copied);
+                    for (size_t i = 0; i < node_copied; i++) {
+                        into[copied + i].key = FromOrdered(node.keys[begin + i]);
+                        std::memcpy(&into[copied + i].value, &node.values[begin + i], sizeof(ValueT));
+                    }
+                    done = end < count;
+                });
+                copied += node_copied;
+                if (done or copied == into.size()) {
+                    break;
+                }
+            }
+        });
+        return copied;
+    }
+
+    // Returns the position in the directory of the node that holds `key`.
+    static size_t Locate(const Directory& directory, int64_t key) noexcept {
+        size_t lo{0};
+        size_t hi = std::min(Count(directory.lock), kNodes);
+        // `keys[lo] <= key` holds throughout, as `keys[0]` is the smallest key.
+        while (hi - lo > kNodeKeys) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (directory.keys[mid] <= key) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        const uint32_t window = (uint32_t{1} << (hi - lo)) - 1;
+        const uint32_t not_greater = key == std::numeric_limits<int64_t>::max()
+                                         ? window
+                                         : LessMask(&directory.keys[lo], key + 1) & window;
+        return lo + std::max(std::popcount(not_greater), 1) - 1;
+    }
+
+    // Returns the position of the first of the `count` keys of `node` not less than `key`.
+    static size_t LowerBoundInNode(const Node& node, size_t count, int64_t key) noexcept {
+        const uint32_t window = (uint32_t{1} << count) - 1;
+        return static_cast<size_t>(std::popcount(LessMask(node.keys, key) & window));
+    }
+
+    // Returns a mask with bit `i` set if `keys[i] < key`, for the `kNodeKeys` keys starting at `keys`.
+    static uint32_t LessMask(const int64_t* keys, int64_t key) noexcept {
+#if defined(__AVX2__)
+        return LessMaskAvx2(keys, key);
+#elif defined(__x86_64__) || defined(_M_X64)
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2 ? LessMaskAvx2(keys, key) : LessMaskScalar(keys, key);
+#else
+        return LessMaskScalar(keys, key);
+#endif
+    }
+
+    static uint32_t LessMaskScalar(const int64_t* keys, int64_t key) noexcept {
+        uint32_t mask{0};
+        for (size_t i = 0; i < kNodeKeys; i++) {
+            mask |= static_cast<uint32_t>(keys[i] < key) << i;
+        }
+        return mask;
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    __attribute__((target("avx2"))) static uint32_t LessMaskAvx2(const int64_t* keys, int64_t key) noexcept {
+        const __m256i target = _mm256_set1_epi64x(key);
+        uint32_t mask{0};
+        for (size_t i = 0; i < kNodeKeys; i += 4) {
+            const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+            const __m256i less = _mm256_cmpgt_epi64(target, loaded);
+            mask |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(less))) << i;
+        }
+        return mask;
+    }
+#endif
+
+    // Splits the full node at `position` in two, inserting `key` with `value` at `index` on the way. The upper half
+    // moves to a free node, which is filled before the directory links it.
+    void Split(size_t position, size_t index, int64_t key, const ValueT& value) noexcept {
+        int64_t keys[kNodeKeys + 1];
+        ValueT values[kNodeKeys + 1];
+        Node& node = nodes_[directory_.nodes[position]];
+        std::memcpy(keys, node.keys, index * sizeof(int64_t));
+        std::memcpy(values, node.values, index * sizeof(ValueT));
+        keys[index] = key;
+        std::memcpy(&values[index], &value, sizeof(ValueT));
+        std::memcpy(&keys[index + 1], &node.keys[index], (kNodeKeys - index) * sizeof(int64_t));
+        std::memcpy(&values[index + 1], &node.values[index], (kNodeKeys - index) * sizeof(ValueT));
+
+        const uint32_t upper = free_[--free_count_];
+        Fill(nodes_[upper], keys + kMinKeys, values + kMinKeys, kNodeKeys + 1 - kMinKeys);
+        directory_.lock.Store([&] {
+            const size_t nodes = Count(directory_.lock);
+            InsertLink(position + 1, nodes, keys[kMinKeys], upper);
+            SetCount(directory_.lock, nodes + 1);
+            Fill(node, keys, values, kMinKeys);
+        });
+    }
+
+    // Removes the entry at `index` of the node at `position`, which then holds less than `kMinKeys` entries, and merges
+    // the node with a neighbour or moves entries over from it.
+    void Underflow(size_t position, size_t index) noexcept {
+        const size_t nodes = Count(directory_.lock);
+        const size_t left = position + 1 < nodes ? position : position - 1;
+        Node& left_node = nodes_[directory_.nodes[left]];
+        Node& right_node = nodes_[directory_.nodes[left + 1]];
+
+        int64_t keys[2 * kNodeKeys];
+        ValueT values[2 * kNodeKeys];
+        size_t total{0};
+        for (Node* node : {&left_node, &right_node}) {
+            const size_t count = Count(node->lock);
+            for (size_t i = 0; i < count; i++) {
+                if (node == &nodes_[directory_.nodes[position]] and i == index) {
+                    continue;
+                }
+                keys[total] = node->keys[i];
+                std::memcpy(&values[total], &node->values[i], sizeof(ValueT));
+                total++;
+            }
+        }
+
+        directory_.lock.Store([&] {
+            if (total <= kNodeKeys) {
+                Fill(left_node, keys, values, total);
+                free_[free_count_++] = directory_.nodes[left + 1];
+                RemoveLink(left + 1, nodes);
+                SetCount(directory_.lock, nodes - 1);
+            } else {
+                const size_t half = total / 2;
+                Fill(left_node, keys, values, half);
+                Fill(right_node, keys + half, values + half, total - half);
+                directory_.keys[left + 1] = keys[half];
+            }
+        });
+    }
+
+    static void Fill(Node& node, const int64_t* keys, const ValueT* values, size_t count) noexcept {
+        node.lock.Store([&] {
+            std::memcpy(node.keys, keys, count * sizeof(int64_t));
+            std::memcpy(node.values, values, count * sizeof(ValueT));
+            SetCount(node.lock, count);
+        });
+    }
+
+    void InsertLink(size_t position, size_t nodes, int64_t key, uint32_t node) noexcept {
+        std::memmove(&directory_.keys[position + 1], &directory_.keys[position], (nodes - position) * sizeof(int64_t));
+        std::memmove(&directory_.nodes[position + 1], &directory_.nodes[position],
+                     (nodes - position) * sizeof(uint32_t));
+        directory_.keys[position] = key;
+        directory_.nodes[position] = node;
+    }
+
+    void RemoveLink(size_t position, size_t nodes) noexcept {
+        std::memmove(&directory_.keys[position], &directory_.keys[position + 1],
+                     (nodes - position - 1) * sizeof(int64_t));
+        std::memmove(&directory_.nodes[position], &directory_.nodes[position + 1],
+                     (nodes - position - 1) * sizeof(uint32_t));
+    }
+};
+
+}  // namespace seqlock
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/util.hpp"
+
+namespace seqlock {
+
+/// `CommitStamp` is the time at which a version of a `StampedRegion` was committed, both as a TSC reading and as a
+/// wall-clock time. A zero stamp means no version was committed yet.
+struct CommitStamp {
+    uint64_t tsc{0};
+    int64_t timestamp_ns{0};
+
+    /// `Age` returns how long ago the version was committed, measured with the TSC, which is shared by all processes
+    /// of the machine. Returns `nanoseconds::max()` for a zero stamp.
+    std::chrono::nanoseconds Age() const noexcept {
+        if (tsc == 0) {
+            return std::chrono::nanoseconds::max();
+        }
+        const uint64_t now = util::ReadTsc();
+        const uint64_t ticks = now > tsc ? now - tsc : 0;
+        return std::chrono::nanoseconds{static_cast<int64_t>(static_cast<double>(ticks) / TicksPerNs())};
+    }
+
+    /// `TicksPerNs` returns the TSC rate, calibrated on first use, which busy-waits for 10ms. Call it at startup to
+    /// keep the calibration out of the first `Age`.
+    static double TicksPerNs() noexcept {
+        static const double ticks_per_ns = util::TscTicksPerNs();
+        return ticks_per_ns;
+    }
+};
+
+/// `StampedRegion` is a `GuardedRegion` whose writer stamps every commit with a `CommitStamp`. The stamp is stored
+/// next to the sequence number, in the same cache line, and is updated in the same write as the data, so a reader
+/// always gets the stamp of the version it copied. Like `GuardedRegion`, it can be placed in shared memory.
+///
+/// Readers can reject stale versions with `LoadIfFresherThan`. A writer with nothing to publish calls `Touch` from time
+/// to time, so that readers can tell a quiet region from a dead or stuck writer.
+template <mode::Mode ModeT, size_t N>
+class StampedRegion {
+   public:
+    StampedRegion() = default;
+    ~StampedRegion() = default;
+
+    // Copy.
+    StampedRegion(const StampedRegion&) = delete;
+    StampedRegion& operator=(const StampedRegion&) = delete;
+
+    // Move.
+    StampedRegion(StampedRegion&&) = delete;
+    StampedRegion& operator=(StampedRegion&&) = delete;
+
+    void Set(int v) {
+        Commit([&] { std::memset(data_, v, N); });
+    }
+
+    /// `Store` commits the first `size` bytes of `from`, stamped with the current time.
+    void Store(const char* from, size_t size) {
+        Commit([&] { std::memcpy(data_, from, std::min(size, N)); });
+    }
+
+    /// `Touch` commits a new version with the same data and the current time, as a heartbeat.
+    void Touch() {
+        Commit([] {});
+    }
+
+    /// `TryLoad` tries to copy the region into `into` once. Returns false if a write interfered. Otherwise, returns
+    /// true and sets `seq` and `stamp`, if given, to the sequence number and stamp of the copied version.
+    bool TryLoad(char* into, size_t size, uint64_t* seq = nullptr, CommitStamp* stamp = nullptr) const {
+        uint64_t loaded_seq{0};
+        CommitStamp loaded_stamp;
+        const bool ok = lock_.TryLoad([&] {
+            loaded_seq = lock_.Sequence();
+            std::memcpy(&loaded_stamp, lock_.InlineData(), sizeof(loaded_stamp));
+            std::memcpy(into, data_, std::min(size, N));
+        });
+        if (ok and seq != nullptr) {
+            *seq = loaded_seq;
+        }
+        if (ok and stamp != nullptr) {
+            *stamp = loaded_stamp;
+        }
+        return ok;
+    }
+
+    /// `Load` copies the region into `into` and returns the sequence number of the copied version. Sets `stamp`, if
+    /// given, to the stamp of the copied version.
+    uint64_t Load(char* into, size_t size, CommitStamp* stamp = nullptr) const {
+        uint64_t seq{0};
+        while (not TryLoad(into, size, &seq, stamp)) {
+        }
+        return seq;
+    }
+
+    /// `LoadIfFresherThan` copies the region into `into` if the current version was committed less than `max_age`
+    /// ago and returns true. Otherwise, it returns false and `into` is left in an unspecified state.
+    bool LoadIfFresherThan(char* into, size_t size, std::chrono::nanoseconds max_age, uint64_t* seq = nullptr) const {
+        CommitStamp stamp;
+        uint64_t loaded_seq{0};
+        while (not TryLoad(into, size, &loaded_seq, &stamp)) {
+        }
+        if (stamp.Age() >= max_age) {
+            return false;
+        }
+        if (seq != nullptr) {
+            *seq = loaded_seq;
+        }
+        return true;
+    }
+
+    /// `Stamp` returns the stamp of the current version.
+    CommitStamp Stamp() const noexcept {
+        CommitStamp stamp;
+        lock_.Load([&] { std::memcpy(&stamp, lock_.InlineData(), sizeof(stamp)); });
+        return stamp;
+    }
+
+    /// `Age` returns how long ago the current version was committed, or `nanoseconds::max()` if there is none.
+    std::chrono::nanoseconds Age() const noexcept { return Stamp().Age(); }
+
+    /// `Sequence` returns the current sequence number of the lock guarding the region.
+    uint64_t Sequence() const noexcept { return lock_.Sequence(); }
+
+    /// `NextUpdate` returns an awaitable which completes once the region is updated past `last_seq`. See
+    /// `SeqLock::NextUpdate`.
+    UpdateAwaiter NextUpdate(uint64_t last_seq) const noexcept { return lock_.NextUpdate(last_seq); }
+
+    static constexpr size_t Size() noexcept { return N; }
+
+   private:
+    // The stamp is stored inline, in the sequence number's cache line.
+    SeqLock<ModeT, sizeof(CommitStamp)> lock_;
+    char data_[N];
+
+    template <typename StoreFnT>
+    void Commit(StoreFnT&& store_fn) {
+        lock_.Store([&] {
+            // Stamped under the lock, so that stamps follow the commit order of multiple writers, and before the data
+            // is written, so that readers never see a stamp later than the time they load at.
+            const CommitStamp stamp{
+                util::ReadTsc(),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count()};
+            std::memcpy(lock_.InlineData(), &stamp, sizeof(stamp));
+            store_fn();
+        });
+    }
+};
+
+}  // namespace seqlock
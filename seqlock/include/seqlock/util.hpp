@@ -1,18 +1,29 @@
 #pragma once
 
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/fcntl.h>
 #include <sys/file.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
 #include <cassert>
+#include <chrono>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 #include <expected>
 #include <format>
 #include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
 
 namespace seqlock::util {
 
@@ -40,6 +51,50 @@ inline std::expected<size_t, std::string> RoundToPageSize(size_t size) {
     return size;
 }
 
+/// Pins the calling thread to the given CPU. Busy-polling threads, like the one running a `PollScheduler`, should be
+/// pinned to an isolated core. Only supported on Linux.
+inline std::expected<void, std::string> PinThisThread(size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (const int err = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set); err != 0) {
+        return std::unexpected(std::format("Cannot pin thread to cpu {} err={}", cpu, std::strerror(err)));
+    }
+    return {};
+#else
+    return std::unexpected(std::format("Cannot pin thread to cpu {}: unsupported platform", cpu));
+#endif
+}
+
+/// `ReadTsc` returns the current value of the CPU's timestamp counter: the TSC on x86 and the virtual counter on ARM.
+/// Counters tick at a constant rate, see `TscTicksPerNs`. Falls back to the steady clock, in nanoseconds, elsewhere.
+inline uint64_t ReadTsc() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+/// `TscTicksPerNs` estimates the rate of `ReadTsc` against the steady clock by busy-waiting for `duration`.
+inline double TscTicksPerNs(std::chrono::nanoseconds duration = std::chrono::milliseconds{10}) noexcept {
+    const auto clock_start = std::chrono::steady_clock::now();
+    const uint64_t tsc_start = ReadTsc();
+    auto clock_end = clock_start;
+    while (clock_end - clock_start < duration) {
+        clock_end = std::chrono::steady_clock::now();
+    }
+    const uint64_t tsc_end = ReadTsc();
+    return static_cast<double>(tsc_end - tsc_start) / static_cast<double>((clock_end - clock_start).count());
+}
+
 inline std::expected<size_t, std::string> GetFileSize(int fd) {
     struct stat st {};
     if (::fstat(fd, &st) != 0) {
@@ -163,6 +218,50 @@ class SharedMemory {
         return obj;
     }
 
+    // Maps an existing file. If `size` is 0, the file is mapped at its current size. Otherwise, the file is grown to
+    // `size` bytes if it is smaller and mapped at `size` bytes. Files are never shrunk, as that would invalidate the
+    // mappings of other processes.
+    static std::expected<std::pair<T*, size_t>, std::string> MapGrow(int fd, const std::string& filename,
+                                                                      size_t size) {
+#if defined(__linux__)
+        if (::flock(fd, LOCK_EX) != 0) {
+            return std::unexpected(
+                std::format("Could not acquire file lock on fd {} err={}.", fd, std::strerror(errno)));
+        }
+#endif
+
+        const auto file_size_result = GetFileSize(fd);
+        if (not file_size_result) {
+            return std::unexpected(std::format("File {} err={}", filename, file_size_result.error()));
+        }
+
+        const size_t file_size = file_size_result.value();
+        if (size == 0) {
+            size = file_size;
+        } else if (file_size < size and ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return std::unexpected(
+                std::format("Cannot truncate file {} to {} err={}.", filename, size, std::strerror(errno)));
+        }
+        if (size < sizeof(T)) {
+            return std::unexpected(std::format("File {} of size {} is too small.", filename, size));
+        }
+
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED) {
+            return std::unexpected(std::format("Cannot mmap file {} err={}.", filename, std::strerror(errno)));
+        }
+
+#if defined(__linux__)
+        if (::flock(fd, LOCK_UN) != 0) {
+            ::munmap(ptr, size);
+            return std::unexpected(
+                std::format("Could not release file lock on fd {} err={}.", fd, std::strerror(errno)));
+        }
+#endif
+
+        return std::pair{static_cast<T*>(ptr), size};
+    }
+
    public:
     /// If the file does not exist, `Create` creates a new memory-shared file of the given size, constructing `T` with
     /// the provided constructor arguments `Args` in the new memory. If the file exists, `Create` just maps it. The
@@ -218,6 +317,52 @@ class SharedMemory {
         return SharedMemory{obj, filename, size, is_creator};
     }
 
+    /// `Open` maps an existing memory-shared file at its current size. Unlike `Create`, the caller does not need to
+    /// know the size of the file, which is useful when the file is grown by another process through `Resize`.
+    static std::expected<SharedMemory, std::string> Open(const std::string& filename) {
+        const int fd = ::shm_open(filename.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+        if (fd < 0) {
+            return std::unexpected(
+                std::format("Could not shm_open existing file {} err={}.", filename, std::strerror(errno)));
+        }
+
+        auto map_result = MapGrow(fd, filename, 0);
+        ::close(fd);
+        if (not map_result) {
+            return std::unexpected(map_result.error());
+        }
+
+        const auto [obj, size] = map_result.value();
+        return SharedMemory{obj, filename, size, false};
+    }
+
+    /// `Resize` remaps the file to `size` bytes, rounded up to the page size, growing the file if it is smaller. The
+    /// file is never shrunk. Contents are preserved, but pointers obtained through `Get` before the call are
+    /// invalidated. Other processes keep their mappings at the old size until they `Resize` as well.
+    std::expected<void, std::string> Resize(size_t size) {
+        const auto page_size_result = RoundToPageSize(std::max(size, sizeof(T)));
+        if (not page_size_result) {
+            return std::unexpected(page_size_result.error());
+        }
+        size = page_size_result.value();
+
+        const int fd = ::shm_open(filename_.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+        if (fd < 0) {
+            return std::unexpected(
+                std::format("Could not shm_open existing file {} err={}.", filename_, std::strerror(errno)));
+        }
+
+        auto map_result = MapGrow(fd, filename_, size);
+        ::close(fd);
+        if (not map_result) {
+            return std::unexpected(map_result.error());
+        }
+
+        ::munmap(static_cast<void*>(obj_), size_);
+        std::tie(obj_, size_) = map_result.value();
+        return {};
+    }
+
     ~SharedMemory() noexcept {
         if (obj_ != nullptr) {
             ::munmap(static_cast<void*>(obj_), size_);
@@ -0,0 +1,69 @@
+#include "seqlock/lanes.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+using seqlock::LaneRegion;
+using seqlock::LaneView;
+using seqlock::SeqLock;
+
+constexpr size_t kMaxWriters = 16;
+
+struct Counters {
+    uint64_t count;
+    uint64_t quantity;
+};
+
+// Writers update their own counters in a table guarded by a single multi-writer lock, `state.threads()` of them
+// contending on its `SpinLock`.
+static void BM_MultiWriterUpdate(benchmark::State& state) {
+    static SeqLock<seqlock::mode::MultiWriter> lock{};
+    static Counters counters[kMaxWriters]{};
+
+    auto& own = counters[state.thread_index()];
+    for (auto _ : state) {
+        lock.Store([&] {
+            own.count++;
+            own.quantity += 10;
+        });
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Writers update their own lane, without contending.
+static void BM_LaneUpdate(benchmark::State& state) {
+    static LaneRegion<Counters, kMaxWriters> region{};
+
+    const auto lane = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        region.Update(lane, [](Counters& counters) {
+            counters.count++;
+            counters.quantity += 10;
+        });
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// A reader refreshes its view of 16 lanes, `state.range(0)` of which change between two refreshes.
+static void BM_LaneViewRefresh(benchmark::State& state) {
+    static LaneRegion<Counters, kMaxWriters> region{};
+    LaneView view{region};
+
+    const auto changed = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        for (size_t lane = 0; lane < changed; lane++) {
+            region.Update(lane, [](Counters& counters) { counters.count++; });
+        }
+        view.Refresh();
+        benchmark::DoNotOptimize(
+            view.Fold(uint64_t{0}, [](uint64_t acc, const Counters& counters) { return acc + counters.count; }));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_MultiWriterUpdate)->ThreadRange(1, kMaxWriters)->UseRealTime();
+BENCHMARK(BM_LaneUpdate)->ThreadRange(1, kMaxWriters)->UseRealTime();
+BENCHMARK(BM_LaneViewRefresh)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->ArgName("changed");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+#include "seqlock/lanes.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+namespace {
+
+struct Fills {
+    uint64_t count;
+    uint64_t quantity;
+};
+
+}  // namespace
+
+TEST(LaneRegion, StoreFold) {
+    using Region = LaneRegion<Fills, 8>;
+    auto region = std::make_unique<Region>();
+    // Small values share the cache line of their lane's sequence number.
+    ASSERT_EQ(sizeof(Region), 8 * 64);
+
+    const auto total = [](Fills acc, const Fills& fills) {
+        return Fills{acc.count + fills.count, acc.quantity + fills.quantity};
+    };
+    ASSERT_EQ(region->Fold(Fills{}, total).count, 0);
+
+    region->Store(0, Fills{1, 100});
+    region->Store(2, Fills{2, 50});
+    region->Update(2, [](Fills& fills) {
+        fills.count++;
+        fills.quantity += 10;
+    });
+    region->Update(3, [](Fills& fills) { fills.count++; });
+
+    const Fills fills = region->Fold(Fills{}, total);
+    ASSERT_EQ(fills.count, 5);
+    ASSERT_EQ(fills.quantity, 160);
+    ASSERT_EQ(region->Sequence(0), 2);
+    ASSERT_EQ(region->Sequence(1), 0);
+    ASSERT_EQ(region->Sequence(2), 4);
+}
+
+TEST(LaneView, Refresh) {
+    using Region = LaneRegion<Fills, 8>;
+    auto region = std::make_unique<Region>();
+    LaneView view{*region};
+    ASSERT_EQ(view.Refresh(), 0);
+
+    region->Store(1, Fills{1, 1});
+    region->Store(5, Fills{5, 5});
+    ASSERT_EQ(view.Refresh(), 2);
+    ASSERT_EQ(view.Refresh(), 0);
+
+    region->Store(5, Fills{6, 6});
+    ASSERT_EQ(view.Refresh(), 1);
+    ASSERT_EQ(view.Get(5).count, 6);
+    ASSERT_EQ(view.Sequence(5), 4);
+    ASSERT_EQ(view.Fold(uint64_t{0}, [](uint64_t acc, const Fills& fills) { return acc + fills.count; }), 7);
+}
+
+TEST(LaneRegion, MultiThread) {
+    constexpr size_t kWriters = 4;
+    constexpr uint64_t kUpdates = 100'000;
+    using Region = LaneRegion<Fills, 8>;
+    auto region = std::make_unique<Region>();
+
+    std::vector<std::thread> writers;
+    for (size_t lane = 0; lane < kWriters; lane++) {
+        writers.emplace_back([&, lane] {
+            for (uint64_t i = 0; i < kUpdates; i++) {
+                region->Update(lane, [](Fills& fills) {
+                    fills.count++;
+                    fills.quantity = 10 * fills.count;
+                });
+            }
+        });
+    }
+
+    LaneView view{*region};
+    std::atomic<bool> done{false};
+    std::thread reader{[&] {
+        while (not done) {
+            view.Refresh();
+            // Every lane is read consistently.
+            view.Fold(0, [](int acc, const Fills& fills) {
+                EXPECT_EQ(fills.quantity, 10 * fills.count);
+                return acc;
+            });
+        }
+    }};
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    view.Refresh();
+    ASSERT_EQ(view.Fold(uint64_t{0}, [](uint64_t acc, const Fills& fills) { return acc + fills.count; }),
+              kWriters * kUpdates);
+}
+
+TEST(LaneRegion, Shm) {
+    using Region = LaneRegion<Fills, 8>;
+    ::shm_unlink("/laneregion");
+
+    auto writer_shm = util::SharedMemory<Region>::Create("/laneregion", sizeof(Region));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    auto reader_shm = util::SharedMemory<Region>::Create("/laneregion", sizeof(Region));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+
+    writer_shm->Get()->Store(7, Fills{3, 30});
+    Fills fills{};
+    ASSERT_EQ(reader_shm->Get()->Load(7, fills), 2);
+    ASSERT_EQ(fills.quantity, 30);
+}
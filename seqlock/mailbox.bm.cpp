@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/mailbox.hpp"
+
+namespace {
+
+template <size_t N>
+using Region = seqlock::MailboxRegion<N, 8>;
+
+// The cost of a store to the writer when `state.range(0)` readers requested a copy before each store, all served by it.
+template <size_t N>
+void BM_StoreServe(benchmark::State& state) {
+    const auto requests = static_cast<size_t>(state.range(0));
+    auto region = std::make_unique<Region<N>>();
+    std::vector<char> from(N, 1);
+    for (auto _ : state) {
+        for (size_t slot = 0; slot < requests; slot++) {
+            region->Request(slot);
+        }
+        region->Store(from.data(), from.size(), requests);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N));
+}
+
+// Readers load while the writer stores back to back. Reports the fraction of loads completed with the writer's copy.
+template <size_t N>
+void BM_LoadUnderFastWriter(benchmark::State& state) {
+    static auto* region = new Region<N>;
+    static std::atomic<bool> writer_done{false};
+    static std::thread* writer{nullptr};
+    if (state.thread_index() == 0) {
+        writer_done.store(false);
+        writer = new std::thread{[] {
+            std::vector<char> from(N);
+            for (int i = 0; not writer_done.load(std::memory_order_relaxed); i++) {
+                from[0] = static_cast<char>(i);
+                region->Store(from.data(), from.size());
+            }
+        }};
+    }
+
+    std::vector<char> into(N);
+    int64_t assisted_loads{0};
+    for (auto _ : state) {
+        bool assisted{false};
+        benchmark::DoNotOptimize(region->Load(state.thread_index(), into.data(), into.size(), 4, &assisted));
+        assisted_loads += assisted ? 1 : 0;
+    }
+    state.counters["assisted"] = benchmark::Counter(static_cast<double>(assisted_loads) /
+                                                        static_cast<double>(state.iterations()),
+                                                    benchmark::Counter::kAvgThreads);
+
+    if (state.thread_index() == 0) {
+        writer_done.store(true);
+        writer->join();
+        delete writer;
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_StoreServe<1 << 16>)->Arg(0)->Arg(1)->Arg(4);
+BENCHMARK(BM_StoreServe<1 << 20>)->Arg(0)->Arg(1)->Arg(4);
+
+BENCHMARK(BM_LoadUnderFastWriter<1 << 20>)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
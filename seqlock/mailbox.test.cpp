@@ -0,0 +1,93 @@
+#include "seqlock/mailbox.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kSize = 1 << 16;
+
+using Region = seqlock::MailboxRegion<kSize, 4>;
+
+}  // namespace
+
+TEST(MailboxRegion, ServeRequests) {
+    auto region = std::make_unique<Region>();
+    std::vector<char> from(kSize, 1);
+    std::vector<char> into(kSize, 0);
+
+    uint64_t seq{0};
+    ASSERT_FALSE(region->TryCollect(0, into.data(), into.size(), &seq));
+    ASSERT_EQ(region->Serve(4), 0);
+
+    region->Store(from.data(), from.size());
+    region->Request(0);
+    region->Request(2);
+    region->Request(3);
+    ASSERT_EQ(region->Pending(), 3);
+    ASSERT_FALSE(region->TryCollect(0, into.data(), into.size()));
+
+    // Each store serves up to its budget, the remaining requests wait for the next ones.
+    std::fill(from.begin(), from.end(), 2);
+    region->Store(from.data(), from.size(), 2);
+    ASSERT_EQ(region->Pending(), 1);
+    ASSERT_TRUE(region->TryCollect(0, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 4);
+    ASSERT_EQ(into, from);
+    ASSERT_TRUE(region->TryCollect(2, into.data(), into.size()));
+    ASSERT_FALSE(region->TryCollect(3, into.data(), into.size()));
+
+    // Round-robin: slot 3 is served before slot 0, which requested again.
+    region->Request(0);
+    std::fill(from.begin(), from.end(), 3);
+    region->Store(from.data(), from.size(), 1);
+    ASSERT_TRUE(region->TryCollect(3, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 6);
+    ASSERT_EQ(into, from);
+    ASSERT_FALSE(region->TryCollect(0, into.data(), into.size()));
+    ASSERT_EQ(region->Serve(4), 1);
+    ASSERT_TRUE(region->TryCollect(0, into.data(), into.size(), &seq));
+    ASSERT_EQ(seq, 6);
+    ASSERT_EQ(region->Pending(), 0);
+}
+
+TEST(MailboxRegion, LoadUnderFastWriter) {
+    auto region = std::make_unique<Region>();
+    std::atomic<int> readers_done{0};
+    constexpr int kReaders = 4;
+
+    // The writer stores back to back, without giving readers any gap between two stores.
+    std::thread writer{[&] {
+        std::vector<char> from(kSize);
+        for (int i = 1; readers_done.load() < kReaders; i++) {
+            std::fill(from.begin(), from.end(), static_cast<char>(i));
+            region->Store(from.data(), from.size());
+        }
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; r++) {
+        readers.emplace_back([&, r] {
+            std::vector<char> into(kSize);
+            uint64_t last_seq{0};
+            for (int i = 0; i < 50; i++) {
+                const uint64_t seq = region->Load(r, into.data(), into.size(), 2);
+                ASSERT_GE(seq, last_seq);
+                last_seq = seq;
+                for (size_t j = 0; j < kSize; j++) {
+                    ASSERT_EQ(into[j], into[0]);
+                }
+            }
+            readers_done++;
+        });
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    writer.join();
+}
@@ -0,0 +1,96 @@
+#include "seqlock/order_book.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using seqlock::Action;
+using seqlock::LevelUpdate;
+using seqlock::OrderBook;
+using seqlock::Side;
+
+constexpr size_t kDepth = 10;
+
+using Book = OrderBook<seqlock::mode::SingleWriter, kDepth>;
+
+/// Generates a synthetic price-level feed. The same seed always replays the same feed. Most updates modify a level
+/// close to the top of the book, like on a real feed, and adds and deletes are balanced to keep the book populated.
+static std::vector<LevelUpdate> MakeFeed(size_t size, uint32_t seed = 42) {
+    std::mt19937 gen{seed};
+    std::geometric_distribution<int> depth_dist{0.4};
+    std::uniform_int_distribution<int> action_dist{0, 99};
+    std::uniform_int_distribution<int64_t> quantity_dist{1, 1000};
+
+    std::vector<LevelUpdate> feed;
+    feed.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        const auto side = (gen() & 1) != 0 ? Side::kBid : Side::kAsk;
+        const auto depth = static_cast<uint16_t>(std::min<int>(depth_dist(gen), kDepth - 1));
+        const int action = action_dist(gen);
+        const int64_t price = side == Side::kBid ? 10'000 - depth : 10'001 + depth;
+        feed.push_back({side, action < 70 ? Action::kModify : (action < 85 ? Action::kAdd : Action::kDelete), depth,
+                        {price, quantity_dist(gen)}});
+    }
+    return feed;
+}
+
+static void BM_OrderBookApply(benchmark::State& state) {
+    const auto feed = MakeFeed(1 << 16);
+    auto book = std::make_unique<Book>();
+
+    size_t i{0};
+    for (auto _ : state) {
+        book->Apply(feed[i]);
+        i = (i + 1) & (feed.size() - 1);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+std::unique_ptr<Book> book{nullptr};
+std::thread* writer{nullptr};
+std::atomic<bool> writer_done{false};
+
+// Readers run while a writer replays the feed in a loop. `state.range(0)` is the number of levels read per side: 0 is
+// the top of the book, `kDepth` is the full snapshot.
+static void BM_OrderBookRead(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        book = std::make_unique<Book>();
+        writer_done.store(false, std::memory_order_relaxed);
+        writer = new std::thread{[] {
+            const auto feed = MakeFeed(1 << 16);
+            size_t i{0};
+            while (not writer_done.load(std::memory_order_relaxed)) {
+                book->Apply(feed[i]);
+                i = (i + 1) & (feed.size() - 1);
+            }
+        }};
+    }
+
+    const auto levels = static_cast<size_t>(state.range(0));
+    seqlock::BookSnapshot<kDepth> snapshot;
+    for (auto _ : state) {
+        if (levels == 0) {
+            benchmark::DoNotOptimize(book->Top());
+        } else {
+            benchmark::DoNotOptimize(book->Top(levels, snapshot.bids, snapshot.asks));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+    if (state.thread_index() == 0) {
+        writer_done.store(true, std::memory_order_relaxed);
+        writer->join();
+        delete writer;
+        writer = nullptr;
+        book.reset();
+    }
+}
+
+BENCHMARK(BM_OrderBookApply);
+BENCHMARK(BM_OrderBookRead)->Arg(0)->Arg(5)->Arg(kDepth)->ArgName("levels")->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+#include "seqlock/order_book.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+using Book = OrderBook<mode::SingleWriter, 8>;
+
+TEST(OrderBook, AddModifyDelete) {
+    auto book = std::make_unique<Book>();
+
+    auto top = book->Top();
+    ASSERT_EQ(top.bid.quantity, 0);
+    ASSERT_EQ(top.ask.quantity, 0);
+
+    ASSERT_TRUE(book->Apply({Side::kBid, Action::kAdd, 0, {100, 5}}));
+    ASSERT_TRUE(book->Apply({Side::kBid, Action::kAdd, 0, {101, 3}}));  // new best bid
+    ASSERT_TRUE(book->Apply({Side::kBid, Action::kAdd, 2, {99, 7}}));
+    ASSERT_TRUE(book->Apply({Side::kAsk, Action::kAdd, 0, {102, 1}}));
+    ASSERT_FALSE(book->Apply({Side::kAsk, Action::kAdd, Book::MaxDepth(), {0, 1}}));
+
+    BookSnapshot<Book::MaxDepth()> snapshot;
+    book->Snapshot(snapshot);
+    ASSERT_EQ(snapshot.bids[0].price, 101);
+    ASSERT_EQ(snapshot.bids[1].price, 100);
+    ASSERT_EQ(snapshot.bids[2].price, 99);
+    ASSERT_EQ(snapshot.bids[3].quantity, 0);
+    ASSERT_EQ(snapshot.asks[0].price, 102);
+    ASSERT_EQ(snapshot.asks[1].quantity, 0);
+
+    ASSERT_TRUE(book->Apply({Side::kBid, Action::kModify, 1, {100, 50}}));
+    ASSERT_TRUE(book->Apply({Side::kBid, Action::kDelete, 0, {}}));
+    top = book->Top();
+    ASSERT_EQ(top.bid.price, 100);
+    ASSERT_EQ(top.bid.quantity, 50);
+    ASSERT_EQ(top.ask.price, 102);
+
+    Level bids[2];
+    Level asks[2];
+    ASSERT_EQ(book->Top(2, bids, asks), 2);
+    ASSERT_EQ(bids[1].price, 99);
+    ASSERT_EQ(bids[1].quantity, 7);
+    ASSERT_EQ(asks[1].quantity, 0);
+
+    // Deleting an empty level does nothing.
+    ASSERT_TRUE(book->Apply({Side::kAsk, Action::kDelete, 5, {}}));
+    book->Snapshot(snapshot);
+    ASSERT_EQ(snapshot.asks[0].price, 102);
+
+    book->Clear();
+    top = book->Top();
+    ASSERT_EQ(top.bid.quantity, 0);
+    ASSERT_EQ(top.ask.quantity, 0);
+}
+
+TEST(OrderBook, AddToFullBookDropsWorst) {
+    auto book = std::make_unique<Book>();
+    for (int64_t i = 0; i < static_cast<int64_t>(Book::MaxDepth()); i++) {
+        book->Apply({Side::kAsk, Action::kAdd, static_cast<uint16_t>(i), {100 + i, 1}});
+    }
+    book->Apply({Side::kAsk, Action::kAdd, 0, {99, 1}});
+
+    BookSnapshot<Book::MaxDepth()> snapshot;
+    book->Snapshot(snapshot);
+    for (size_t i = 0; i < Book::MaxDepth(); i++) {
+        ASSERT_EQ(snapshot.asks[i].price, 99 + static_cast<int64_t>(i));
+    }
+}
+
+TEST(OrderBook, BatchIsAtomic) {
+    auto book = std::make_unique<Book>();
+
+    const std::vector<LevelUpdate> batch{
+        {Side::kBid, Action::kAdd, 0, {100, 1}},
+        {Side::kAsk, Action::kAdd, 0, {101, 1}},
+        {Side::kAsk, Action::kAdd, 100, {0, 0}},  // skipped
+    };
+    const auto seq = book->Sequence();
+    ASSERT_EQ(book->Apply(batch), 2);
+    ASSERT_EQ(book->Sequence(), seq + 2);
+}
+
+TEST(OrderBook, MultiThreadConsistentSnapshots) {
+    auto book = std::make_unique<Book>();
+
+    // The writer keeps the book crossed by exactly one tick at every depth. Readers must never see anything else.
+    std::atomic<bool> writer_done{false};
+    std::thread writer{[&] {
+        for (int64_t i = 1; i <= 100'000; i++) {
+            std::vector<LevelUpdate> batch;
+            for (uint16_t depth = 0; depth < Book::MaxDepth(); depth++) {
+                const int64_t price = i * 100 - depth;
+                batch.push_back({Side::kBid, Action::kModify, depth, {price, i}});
+                batch.push_back({Side::kAsk, Action::kModify, depth, {price + 1, i}});
+            }
+            book->Apply(batch);
+        }
+        writer_done = true;
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            BookSnapshot<Book::MaxDepth()> snapshot;
+            while (not writer_done) {
+                const auto top = book->Top();
+                ASSERT_EQ(top.ask.price - top.bid.price, top.bid.quantity == 0 ? 0 : 1);
+                ASSERT_EQ(top.bid.quantity, top.ask.quantity);
+
+                book->Snapshot(snapshot);
+                for (size_t i = 0; i < Book::MaxDepth(); i++) {
+                    ASSERT_EQ(snapshot.bids[i].quantity, snapshot.bids[0].quantity);
+                    ASSERT_EQ(snapshot.asks[i].quantity, snapshot.bids[0].quantity);
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(OrderBook, Shm) {
+    using SharedBook = OrderBook<mode::MultiWriter, 16>;
+
+    auto writer_shm = util::SharedMemory<SharedBook>::Create("/orderbook", sizeof(SharedBook));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    writer_shm->Get()->Apply({Side::kBid, Action::kAdd, 0, {42, 1}});
+
+    auto reader_shm = util::SharedMemory<SharedBook>::Create("/orderbook", sizeof(SharedBook));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+    ASSERT_EQ(reader_shm->Get()->Top().bid.price, 42);
+}
@@ -0,0 +1,66 @@
+#include "seqlock/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "seqlock/util.hpp"
+
+using seqlock::GuardedRegion;
+using seqlock::ParallelCopier;
+
+constexpr size_t kSize = 16 << 20;
+
+using Region = GuardedRegion<seqlock::mode::SingleWriter, kSize>;
+
+// A reader takes validated snapshots of a 16 MiB region with `state.range(0)` helper threads, while a writer commits a
+// small tick every `state.range(1)` microseconds. Reports the share of copies that validate, and the mean latency of a
+// validated snapshot including retries.
+static void BM_ParallelLoad(benchmark::State& state) {
+    static const double ticks_per_ns = seqlock::util::TscTicksPerNs();
+    auto region = std::make_unique<Region>();
+    region->Set(0);
+
+    std::atomic<bool> done{false};
+    std::thread writer{[&, gap = std::chrono::microseconds{state.range(1)}] {
+        char tick[64]{};
+        while (not done.load(std::memory_order_relaxed)) {
+            tick[0]++;
+            region->Store(tick, sizeof(tick));
+            std::this_thread::sleep_for(gap);
+        }
+    }};
+
+    ParallelCopier copier{static_cast<size_t>(state.range(0))};
+    auto into = std::make_unique<char[]>(kSize);
+    int64_t attempts{0};
+    int64_t snapshots{0};
+    uint64_t ticks{0};
+    for (auto _ : state) {
+        const uint64_t start = seqlock::util::ReadTsc();
+        attempts++;
+        while (not copier.TryLoad(*region, into.get(), kSize)) {
+            attempts++;
+        }
+        ticks += seqlock::util::ReadTsc() - start;
+        snapshots++;
+        benchmark::DoNotOptimize(into.get());
+    }
+    done.store(true, std::memory_order_relaxed);
+    writer.join();
+
+    state.SetBytesProcessed(static_cast<int64_t>(snapshots * kSize));
+    state.counters["success%"] = 100.0 * static_cast<double>(snapshots) / static_cast<double>(attempts);
+    state.counters["snapshot_us"] = static_cast<double>(ticks) / ticks_per_ns / 1000.0 / static_cast<double>(snapshots);
+}
+
+BENCHMARK(BM_ParallelLoad)
+    ->ArgsProduct({{0, 1, 3, 7}, {100, 1000}})
+    ->ArgNames({"helpers", "gap_us"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
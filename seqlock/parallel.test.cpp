@@ -0,0 +1,63 @@
+#include "seqlock/parallel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace seqlock;  // NOLINT
+
+TEST(ParallelCopier, Copy) {
+    std::vector<char> from(100'003);
+    for (size_t i = 0; i < from.size(); i++) {
+        from[i] = static_cast<char>(i * 7);
+    }
+
+    for (size_t helpers : {0, 1, 3}) {
+        ParallelCopier copier{helpers};
+        ASSERT_EQ(copier.Threads(), helpers + 1);
+        for (size_t size : {0UL, 1UL, 63UL, 64UL, 1000UL, from.size()}) {
+            std::vector<char> into(from.size(), 0);
+            copier.Copy(into.data(), from.data(), size);
+            ASSERT_TRUE(std::equal(from.begin(), from.begin() + static_cast<ptrdiff_t>(size), into.begin()))
+                << "helpers=" << helpers << " size=" << size;
+            ASSERT_TRUE(
+                std::all_of(into.begin() + static_cast<ptrdiff_t>(size), into.end(), [](char c) { return c == 0; }));
+        }
+    }
+}
+
+TEST(ParallelCopier, Load) {
+    constexpr size_t kSize = 1 << 20;
+    using Region = GuardedRegion<mode::SingleWriter, kSize>;
+    auto region = std::make_unique<Region>();
+    region->Set(0);
+
+    std::atomic<bool> done{false};
+    std::thread writer{[&] {
+        for (int i = 1; not done; i++) {
+            region->Set(i & 127);
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+    }};
+
+    // One helper per spare CPU, up to 3. `Load` must also complete without any CPU to spare.
+    const size_t helpers = std::min<size_t>(3, std::max(std::thread::hardware_concurrency(), 1U) - 1);
+    ParallelCopier copier{helpers};
+    auto into = std::make_unique<char[]>(kSize);
+    uint64_t last_seq{0};
+    for (int i = 0; i < 20; i++) {
+        const uint64_t seq = copier.Load(*region, into.get(), kSize);
+        ASSERT_GE(seq, last_seq);
+        last_seq = seq;
+        for (size_t j = 1; j < kSize; j++) {
+            ASSERT_EQ(into[j], into[0]);
+        }
+    }
+    done = true;
+    writer.join();
+}
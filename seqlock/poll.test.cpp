@@ -0,0 +1,126 @@
+#include "seqlock/poll.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace seqlock;  // NOLINT
+
+using Region = GuardedRegion<mode::SingleWriter, 64>;
+
+constexpr int kUpdates = 1'000;
+
+// Coroutines are free functions rather than capturing lambdas: a lambda's captures do not live in the coroutine frame.
+// Tasks start lazily, so the sequence number to wait from is taken when spawning the task rather than when it first
+// runs, which might be after all updates landed.
+static PollTask Consume(Region* region, uint64_t seq, int* updates, int* last_value) {
+    while (*last_value < kUpdates) {
+        const uint64_t next = co_await region->NextUpdate(seq);
+        EXPECT_NE(next, seq);
+        EXPECT_EQ(next % 2, 0);
+        seq = next;
+
+        int data[Region::Size() / sizeof(int)];
+        region->Load(reinterpret_cast<char*>(data), sizeof(data));  // NOLINT
+        for (size_t i = 0; i < std::size(data) - 1; i++) {
+            EXPECT_EQ(data[i], data[i + 1]);
+        }
+
+        const int value = data[0];
+        (*updates)++;
+        *last_value = value;
+    }
+}
+
+static PollTask AwaitOnce(const SeqLock<mode::SingleWriter>* lock, uint64_t last_seq, uint64_t* seen) {
+    *seen = co_await lock->NextUpdate(last_seq);
+}
+
+TEST(PollScheduler, ReadyWithoutSuspending) {
+    SeqLock<mode::SingleWriter> lock{};
+    lock.Store([] {});
+    lock.Store([] {});
+
+    uint64_t seen{0};
+    PollScheduler scheduler{};
+    scheduler.Spawn(AwaitOnce(&lock, 0, &seen));
+    ASSERT_EQ(scheduler.Pending(), 1);
+
+    ASSERT_EQ(scheduler.RunOnce(), 1);
+    ASSERT_EQ(scheduler.Pending(), 0);
+    ASSERT_EQ(seen, 4);
+}
+
+TEST(PollScheduler, ResumesOnlyUpdated) {
+    SeqLock<mode::SingleWriter> updated{};
+    SeqLock<mode::SingleWriter> idle{};
+
+    uint64_t seen_updated{0};
+    uint64_t seen_idle{0};
+    PollScheduler scheduler{};
+    scheduler.Spawn(AwaitOnce(&updated, 0, &seen_updated));
+    scheduler.Spawn(AwaitOnce(&idle, 0, &seen_idle));
+
+    ASSERT_EQ(scheduler.RunOnce(), 2);  // both start and park
+    ASSERT_EQ(scheduler.RunOnce(), 0);
+    ASSERT_EQ(scheduler.Pending(), 2);
+
+    updated.Store([] {});
+    ASSERT_EQ(scheduler.RunOnce(), 0);  // the update is observed at the end of the pass
+    ASSERT_EQ(scheduler.RunOnce(), 1);
+    ASSERT_EQ(seen_updated, 2);
+    ASSERT_EQ(seen_idle, 0);
+    ASSERT_EQ(scheduler.Pending(), 1);
+
+    scheduler.Stop();
+    scheduler.Run();
+    ASSERT_EQ(scheduler.Pending(), 1);
+}
+
+TEST(PollScheduler, ManyRegionsOneThread) {
+    constexpr size_t kRegions = 16;
+
+    std::vector<std::unique_ptr<Region>> regions;
+    for (size_t i = 0; i < kRegions; i++) {
+        regions.push_back(std::make_unique<Region>());
+        regions.back()->Set(0);
+    }
+
+    std::vector<int> updates(kRegions, 0);
+    std::vector<int> last_values(kRegions, 0);
+
+    PollScheduler scheduler{};
+    for (size_t i = 0; i < kRegions; i++) {
+        scheduler.Spawn(Consume(regions[i].get(), regions[i]->Sequence(), &updates[i], &last_values[i]));
+    }
+
+    // Each writer updates its region with increasing values, consumers return after seeing the last one.
+    std::vector<std::thread> writers;
+    for (size_t i = 0; i < kRegions; i++) {
+        writers.emplace_back([region = regions[i].get()] {
+            char from[Region::Size()];
+            for (int value = 1; value <= kUpdates; value++) {
+                for (size_t j = 0; j < sizeof(from); j += sizeof(value)) {
+                    memcpy(from + j, &value, sizeof(value));
+                }
+                region->Store(from, sizeof(from));
+            }
+        });
+    }
+
+    scheduler.Run();
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    ASSERT_EQ(scheduler.Pending(), 0);
+    for (size_t i = 0; i < kRegions; i++) {
+        ASSERT_EQ(last_values[i], kUpdates);
+        ASSERT_GT(updates[i], 0);
+        ASSERT_LE(updates[i], kUpdates);
+    }
+}
@@ -0,0 +1,176 @@
+#include "seqlock/rcu.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+namespace {
+
+struct Book {
+    uint64_t version;
+    uint64_t levels[255];
+};
+
+}  // namespace
+
+TEST(Arena, AllocateFree) {
+    auto arena = std::make_unique<Arena<100, 3>>();
+    ASSERT_EQ(arena->Available(), 3);
+
+    for (int i = 0; i < 3; i++) {
+        auto ptr = arena->Allocate<uint64_t>();
+        ASSERT_FALSE(ptr.IsNull());
+        // Blocks are rounded up to cache lines.
+        ASSERT_EQ(ptr.Offset() % 64, 0);
+        *ptr.Get(*arena) = i;
+    }
+    ASSERT_EQ(arena->Available(), 0);
+    ASSERT_TRUE(arena->Allocate<uint64_t>().IsNull());
+
+    arena->Free(OffsetPtr<uint64_t>{128});
+    auto ptr = arena->Allocate<uint64_t>();
+    ASSERT_EQ(ptr.Offset(), 128);
+    ASSERT_EQ(*ptr.Get(*arena), 1);
+}
+
+TEST(RcuRegion, UpdateRead) {
+    using Region = RcuRegion<mode::SingleWriter, Book, 4, 2>;
+    auto region = std::make_unique<Region>();
+    auto reader = region->Register(1);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+
+    {
+        auto guard = reader->Read();
+        ASSERT_EQ(guard.Get(), nullptr);
+        ASSERT_EQ(guard.Version(), 0);
+    }
+
+    ASSERT_TRUE(region->Update([](Book& book) { book.levels[0] = 10; }));
+    ASSERT_TRUE(region->Update([](Book& book) { book.levels[1] = 20; }));
+    ASSERT_EQ(region->Version(), 2);
+
+    auto guard = reader->Read();
+    ASSERT_EQ(guard.Version(), 2);
+    // Updates start from a copy of the current version.
+    ASSERT_EQ(guard->levels[0], 10);
+    ASSERT_EQ(guard->levels[1], 20);
+
+    // Readers access the version in place.
+    const Book* book = guard.Get();
+    {
+        auto other = region->Register(2);
+        ASSERT_TRUE(other.has_value()) << other.error();
+        ASSERT_EQ(other->Read().Get(), book);
+    }
+    ASSERT_FALSE(region->Register(0).has_value());
+}
+
+TEST(RcuRegion, Reclaim) {
+    using Region = RcuRegion<mode::SingleWriter, Book, 4, 2>;
+    auto region = std::make_unique<Region>();
+    auto reader = region->Register(1);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+
+    // Without readers, replaced versions are reclaimed as needed.
+    for (uint64_t i = 1; i <= 100; i++) {
+        ASSERT_TRUE(region->Update([&](Book& book) { book.version = i; }));
+    }
+
+    {
+        // A reader holding a guard keeps every version replaced since from being reclaimed.
+        auto guard = reader->Read();
+        ASSERT_EQ(guard->version, 100);
+        for (uint64_t i = 101; i <= 103; i++) {
+            ASSERT_TRUE(region->Update([&](Book& book) { book.version = i; }));
+        }
+        ASSERT_EQ(region->FreeVersions(), 0);
+        ASSERT_FALSE(region->Update([](Book&) { FAIL() << "fn should not be called without a free block"; }));
+        ASSERT_EQ(guard->version, 100);
+    }
+
+    // Only the current version is still in use once the guard is released.
+    ASSERT_EQ(region->Reclaim(), 3);
+    ASSERT_EQ(region->FreeVersions(), 3);
+    Book book{};
+    book.version = 104;
+    ASSERT_TRUE(region->Publish(book));
+    ASSERT_EQ(reader->Read()->version, 104);
+}
+
+TEST(RcuRegion, MultiThread) {
+    using Region = RcuRegion<mode::MultiWriter, Book, 8, 4>;
+    auto region = std::make_unique<Region>();
+
+    std::atomic<int> readers_done{0};
+    std::atomic<uint64_t> updates{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; w++) {
+        threads.emplace_back([&] {
+            while (readers_done < 2) {
+                updates += region->Update([](Book& book) {
+                    book.version++;
+                    for (auto& level : book.levels) {
+                        level = book.version;
+                    }
+                });
+            }
+        });
+    }
+    for (uint64_t id = 1; id <= 2; id++) {
+        threads.emplace_back([&, id] {
+            auto reader = region->Register(id);
+            ASSERT_TRUE(reader.has_value()) << reader.error();
+            uint64_t last{0};
+            for (int i = 0; i < 2000; i++) {
+                auto guard = reader->Read();
+                if (guard.Get() == nullptr) {
+                    continue;
+                }
+                // The version must not change, nor be reclaimed and reused, while the guard is held.
+                ASSERT_GE(guard->version, last);
+                for (auto level : guard->levels) {
+                    ASSERT_EQ(level, guard->version);
+                }
+                ASSERT_EQ(guard->version, guard.Version());
+                last = guard->version;
+            }
+            readers_done++;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(region->Version(), updates);
+    region->Reclaim();
+    ASSERT_EQ(region->FreeVersions(), Region::MaxVersions() - 1);
+}
+
+TEST(RcuRegion, Shm) {
+    using Region = RcuRegion<mode::SingleWriter, Book, 4, 4>;
+    ::shm_unlink("/rcuregion");
+
+    auto writer_shm = util::SharedMemory<Region>::Create("/rcuregion", sizeof(Region));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    auto reader_shm = util::SharedMemory<Region>::Create("/rcuregion", sizeof(Region));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+    ASSERT_NE(writer_shm->Get(), reader_shm->Get());
+
+    auto reader = reader_shm->Get()->Register(42);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    ASSERT_TRUE(writer_shm->Get()->Update([](Book& book) { book.levels[254] = 7; }));
+
+    // Offsets resolve to the version in the reader's own mapping.
+    auto guard = reader->Read();
+    ASSERT_EQ(guard->levels[254], 7);
+    ASSERT_GE(reinterpret_cast<const char*>(guard.Get()), reinterpret_cast<const char*>(reader_shm->Get()));
+    ASSERT_LT(reinterpret_cast<const char*>(guard.Get()),
+              reinterpret_cast<const char*>(reader_shm->Get()) + sizeof(Region));
+}
@@ -0,0 +1,126 @@
+#include "seqlock/recorder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using seqlock::GuardedRegion;
+using seqlock::Replayer;
+using seqlock::UpdateLog;
+using seqlock::UpdateRecord;
+
+constexpr size_t kSize = 256;
+
+using Region = GuardedRegion<seqlock::mode::SingleWriter, kSize>;
+
+/// Opens the log to replay. Set `SEQLOCK_REPLAY_LOG` to the path of a log recorded in production with a `Recorder`.
+/// Otherwise, a bursty synthetic log is generated: the same seed always generates the same log.
+static std::unique_ptr<UpdateLog> OpenLog(uint32_t seed = 42) {
+    if (const char* path = std::getenv("SEQLOCK_REPLAY_LOG"); path != nullptr) {
+        auto log = UpdateLog::Open(path);
+        return log ? std::make_unique<UpdateLog>(std::move(log.value())) : nullptr;
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "seqlock-replay.bm.log";
+    auto log = UpdateLog::Create(path.string());
+    if (not log) {
+        return nullptr;
+    }
+
+    // Bursts of back-to-back updates separated by quiet periods, like a market data feed.
+    std::mt19937 gen{seed};
+    std::geometric_distribution<int> burst_dist{0.1};
+    std::exponential_distribution<double> gap_ns_dist{1.0 / 20'000};
+    std::vector<char> data(kSize);
+    const double ticks_per_ns = log->TscTicksPerNs();
+
+    uint64_t seq{0};
+    double tsc{0};
+    while (seq < 2 * 10'000) {
+        tsc += gap_ns_dist(gen) * ticks_per_ns;
+        for (int burst = burst_dist(gen); burst >= 0; burst--) {
+            seq += 2;
+            tsc += 50 * ticks_per_ns;
+            std::fill(data.begin(), data.end(), static_cast<char>(seq));
+            if (not log->Append(seq, static_cast<uint64_t>(tsc), 0, data.data(), data.size())) {
+                return nullptr;
+            }
+        }
+    }
+    return std::make_unique<UpdateLog>(std::move(log.value()));
+}
+
+static void BM_ReplayAsFastAsPossible(benchmark::State& state) {
+    auto log = OpenLog();
+    if (log == nullptr) {
+        state.SkipWithError("Cannot open the replay log.");
+        return;
+    }
+
+    auto region = std::make_unique<Region>();
+    const Replayer replayer{*log, 0};
+    size_t stores{0};
+    for (auto _ : state) {
+        stores += replayer.Run(*region);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(stores));
+}
+
+std::unique_ptr<UpdateLog> replay_log{nullptr};
+std::unique_ptr<Region> shared_region{nullptr};
+std::thread* writer{nullptr};
+std::atomic<bool> writer_done{false};
+
+// Readers load the region while a writer replays the log in a loop at `state.range(0)` times the original speed.
+static void BM_ReplayedLoad(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        replay_log = OpenLog();
+        shared_region = std::make_unique<Region>();
+        writer_done.store(false, std::memory_order_relaxed);
+        if (replay_log != nullptr) {
+            writer = new std::thread{[speed = static_cast<double>(state.range(0))] {
+                const Replayer replayer{*replay_log, speed};
+                while (not writer_done.load(std::memory_order_relaxed)) {
+                    replayer.Run([](const UpdateRecord& record, const char* data) {
+                        shared_region->Store(data, record.size);
+                        return not writer_done.load(std::memory_order_relaxed);
+                    });
+                }
+            }};
+        }
+    }
+
+    char into[kSize];
+    uint64_t last_seq{0};
+    int64_t versions{0};
+    for (auto _ : state) {
+        const uint64_t seq = shared_region->Load(into, sizeof(into));
+        versions += seq != last_seq ? 1 : 0;
+        last_seq = seq;
+        benchmark::DoNotOptimize(into);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["versions"] = benchmark::Counter(static_cast<double>(versions), benchmark::Counter::kAvgThreads);
+
+    if (state.thread_index() == 0) {
+        writer_done.store(true, std::memory_order_relaxed);
+        if (writer != nullptr) {
+            writer->join();
+            delete writer;
+            writer = nullptr;
+        }
+        shared_region.reset();
+        replay_log.reset();
+    }
+}
+
+BENCHMARK(BM_ReplayAsFastAsPossible);
+BENCHMARK(BM_ReplayedLoad)->Arg(1)->Arg(10)->ArgName("speed")->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
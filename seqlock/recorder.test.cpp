@@ -0,0 +1,203 @@
+#include "seqlock/recorder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/dirty.hpp"
+#include "seqlock/seqlock.hpp"
+
+using namespace seqlock;  // NOLINT
+
+static std::string LogPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("seqlock-" + name + ".log")).string();
+}
+
+TEST(UpdateLog, AppendAndReopen) {
+    const std::string path = LogPath("append");
+    {
+        auto log = UpdateLog::Create(path, 128);
+        ASSERT_TRUE(log.has_value()) << log.error();
+        ASSERT_GT(log->TscTicksPerNs(), 0);
+
+        // Records of varying sizes, which outgrow the initial capacity many times.
+        std::vector<char> data(100);
+        for (uint32_t i = 0; i < 1000; i++) {
+            std::memset(data.data(), static_cast<int>(i), data.size());
+            auto append_result = log->Append(2 * i, 1000 * i, i % 7, data.data(), i % data.size());
+            ASSERT_TRUE(append_result.has_value()) << append_result.error();
+        }
+        ASSERT_EQ(log->Records(), 1000);
+    }
+
+    auto log = UpdateLog::Open(path);
+    ASSERT_TRUE(log.has_value()) << log.error();
+    ASSERT_EQ(log->Records(), 1000);
+
+    uint32_t i{0};
+    log->ForEach([&](const UpdateRecord& record, const char* data) {
+        ASSERT_EQ(record.seq, 2 * i);
+        ASSERT_EQ(record.tsc, 1000 * i);
+        ASSERT_EQ(record.index, i % 7);
+        ASSERT_EQ(record.size, i % 100);
+        for (size_t j = 0; j < record.size; j++) {
+            ASSERT_EQ(data[j], static_cast<char>(i));
+        }
+        i++;
+    });
+    ASSERT_EQ(i, 1000);
+
+    ASSERT_FALSE(log->Append(0, 0, 0, nullptr, 0).has_value());
+    ASSERT_FALSE(UpdateLog::Open(LogPath("missing")).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(Recorder, RecordAndReplayGuardedRegion) {
+    using Region = GuardedRegion<mode::SingleWriter, 64>;
+    const std::string path = LogPath("guarded");
+
+    auto region = std::make_unique<Region>();
+    {
+        auto log = UpdateLog::Create(path);
+        ASSERT_TRUE(log.has_value()) << log.error();
+
+        Recorder recorder{log.value()};
+        auto poll_result = recorder.Poll(*region);
+        ASSERT_TRUE(poll_result.has_value()) << poll_result.error();
+        ASSERT_FALSE(poll_result.value());
+
+        for (int i = 1; i <= 100; i++) {
+            region->Set(i);
+            ASSERT_TRUE(recorder.Poll(*region).value());
+            ASSERT_FALSE(recorder.Poll(*region).value());
+        }
+        ASSERT_EQ(log->Records(), 100);
+    }
+
+    auto log = UpdateLog::Open(path);
+    ASSERT_TRUE(log.has_value()) << log.error();
+
+    auto replayed = std::make_unique<Region>();
+    Replayer replayer{log.value(), 0};
+    ASSERT_EQ(replayer.Run(*replayed), 100);
+    ASSERT_EQ(replayed->Sequence(), region->Sequence());
+
+    char into[Region::Size()];
+    ASSERT_EQ(replayed->Load(into, sizeof(into)), 200);
+    for (char c : into) {
+        ASSERT_EQ(c, 100);
+    }
+
+    // Stores can be stopped early.
+    size_t stores{0};
+    ASSERT_EQ(replayer.Run([&](const UpdateRecord& record, const char*) {
+        stores++;
+        return record.seq < 20;
+    }),
+              10);
+    ASSERT_EQ(stores, 10);
+
+    std::filesystem::remove(path);
+}
+
+TEST(Recorder, RecordWatchedRegions) {
+    using Regions = WatchedRegions<mode::SingleWriter, 32, 1000>;
+    const std::string path = LogPath("watched");
+
+    auto regions = std::make_unique<Regions>();
+    auto log = UpdateLog::Create(path);
+    ASSERT_TRUE(log.has_value()) << log.error();
+
+    Recorder recorder{log.value()};
+    regions->Set(3, 1);
+    regions->Set(500, 2);
+    regions->Set(3, 3);
+    regions->Set(999, 4);
+
+    auto poll_result = recorder.Poll(*regions, 0);
+    ASSERT_TRUE(poll_result.has_value()) << poll_result.error();
+    ASSERT_EQ(poll_result.value(), 3);
+    ASSERT_EQ(recorder.Poll(*regions, 0).value(), 0);
+
+    std::vector<std::pair<uint32_t, uint64_t>> recorded;
+    log->ForEach([&](const UpdateRecord& record, const char*) { recorded.emplace_back(record.index, record.seq); });
+    ASSERT_EQ(recorded, (std::vector<std::pair<uint32_t, uint64_t>>{{3, 4}, {500, 2}, {999, 2}}));
+
+    auto replayed = std::make_unique<Regions>();
+    ASSERT_EQ(Replayer(log.value(), 0).Run(*replayed), 3);
+    char into[Regions::Size()];
+    replayed->Load(3, into, sizeof(into));
+    ASSERT_EQ(into[0], 3);
+    replayed->Load(999, into, sizeof(into));
+    ASSERT_EQ(into[0], 4);
+
+    std::filesystem::remove(path);
+}
+
+TEST(Replayer, Pacing) {
+    const std::string path = LogPath("pacing");
+    auto log = UpdateLog::Create(path);
+    ASSERT_TRUE(log.has_value()) << log.error();
+
+    // 11 records, 2ms apart.
+    const double ticks_per_ms = log->TscTicksPerNs() * 1e6;
+    for (int i = 0; i <= 10; i++) {
+        ASSERT_TRUE(log->Append(2 * i, static_cast<uint64_t>(2 * i * ticks_per_ms), 0, nullptr, 0).has_value());
+    }
+
+    const auto elapsed = [&](double speed) {
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(Replayer(log.value(), speed).Run([](const UpdateRecord&, const char*) {}), 11);
+        return std::chrono::steady_clock::now() - start;
+    };
+    ASSERT_GE(elapsed(1), std::chrono::milliseconds{20});
+    ASSERT_GE(elapsed(4), std::chrono::milliseconds{5});
+    ASSERT_LT(elapsed(0), std::chrono::milliseconds{5});
+
+    std::filesystem::remove(path);
+}
+
+TEST(Recorder, MultiThreadFollow) {
+    using Region = GuardedRegion<mode::SingleWriter, 1024>;
+    const std::string path = LogPath("follow");
+
+    auto region = std::make_unique<Region>();
+    auto log = UpdateLog::Create(path);
+    ASSERT_TRUE(log.has_value()) << log.error();
+
+    std::atomic<bool> writer_done{false};
+    std::thread writer{[&] {
+        for (int i = 1; i <= 100'000; i++) {
+            region->Set(i & 127);
+        }
+        writer_done = true;
+    }};
+
+    Recorder recorder{log.value()};
+    while (not writer_done) {
+        ASSERT_TRUE(recorder.Poll(*region).has_value());
+    }
+    writer.join();
+    ASSERT_TRUE(recorder.Poll(*region).has_value());
+
+    uint64_t last_seq{0};
+    log->ForEach([&](const UpdateRecord& record, const char* data) {
+        ASSERT_GT(record.seq, last_seq);
+        ASSERT_EQ(record.seq % 2, 0);
+        last_seq = record.seq;
+        ASSERT_EQ(record.size, Region::Size());
+        for (size_t j = 0; j < record.size; j++) {
+            ASSERT_EQ(data[j], static_cast<char>((record.seq / 2) & 127));
+        }
+    });
+    ASSERT_EQ(last_seq, 200'000);
+
+    std::filesystem::remove(path);
+}
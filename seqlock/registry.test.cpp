@@ -0,0 +1,159 @@
+#include "seqlock/registry.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+
+TEST(ReaderRegistry, RegisterUnregister) {
+    auto registry = std::make_unique<ReaderRegistry<4>>();
+    ASSERT_EQ(registry->Readers(), 0);
+    ASSERT_FALSE(registry->Register(0).has_value());
+
+    {
+        std::vector<ReaderSlot<4>> slots;
+        for (uint64_t id = 1; id <= 4; id++) {
+            auto slot = registry->Register(id);
+            ASSERT_TRUE(slot.has_value()) << slot.error();
+            slots.push_back(std::move(slot.value()));
+        }
+        ASSERT_EQ(registry->Readers(), 4);
+        ASSERT_FALSE(registry->Register(5).has_value());
+    }
+    ASSERT_EQ(registry->Readers(), 0);
+
+    // Slots are reused, and their counters reset.
+    auto slot = registry->Register(6);
+    ASSERT_TRUE(slot.has_value()) << slot.error();
+    slot->Publish(10, 3);
+    ASSERT_FALSE(registry->Evict(slot->Slot(), 5));
+    ASSERT_TRUE(registry->Evict(slot->Slot(), 6));
+    ASSERT_EQ(registry->Readers(), 0);
+
+    auto reused = registry->Register(7);
+    ASSERT_TRUE(reused.has_value()) << reused.error();
+    ASSERT_EQ(reused->Slot(), slot->Slot());
+
+    // The evicted reader neither publishes to nor releases the slot of its successor.
+    slot->Publish(20, 1);
+    ASSERT_FALSE(registry->Evict(slot->Slot(), 6));
+    registry->ForEach([](const ReaderStats& stats) {
+        ASSERT_EQ(stats.id, 7);
+        ASSERT_EQ(stats.last_seq, 0);
+        ASSERT_EQ(stats.loads, 0);
+        ASSERT_EQ(stats.retries, 0);
+    });
+    {
+        const auto evicted = std::move(slot.value());
+    }
+    ASSERT_EQ(registry->Readers(), 1);
+}
+
+TEST(ReaderRegistry, Lag) {
+    using Region = GuardedRegion<mode::SingleWriter, 64>;
+    auto region = std::make_unique<Region>();
+    auto registry = std::make_unique<ReaderRegistry<8>>();
+
+    auto fast = registry->Register(1);
+    auto slow = registry->Register(2);
+    ASSERT_TRUE(fast.has_value() and slow.has_value());
+
+    char into[Region::Size()];
+    for (int i = 1; i <= 10; i++) {
+        region->Set(i);
+        ASSERT_EQ(fast->Load(*region, into, sizeof(into)), 2 * i);
+        ASSERT_EQ(into[0], i);
+        if (i == 3) {
+            ASSERT_EQ(slow->Load(*region, into, sizeof(into)), 6);
+        }
+    }
+
+    std::vector<ReaderStats> stats;
+    registry->ForEach([&](const ReaderStats& s) { stats.push_back(s); });
+    ASSERT_EQ(stats.size(), 2);
+    ASSERT_EQ(stats[0].id, 1);
+    ASSERT_EQ(stats[0].loads, 10);
+    ASSERT_EQ(stats[0].Lag(region->Sequence()), 0);
+    ASSERT_EQ(stats[1].id, 2);
+    ASSERT_EQ(stats[1].loads, 1);
+    ASSERT_EQ(stats[1].Lag(region->Sequence()), 7);
+    // A write in progress does not count as a version yet.
+    ASSERT_EQ(stats[1].Lag(region->Sequence() + 1), 7);
+}
+
+TEST(ReaderRegistry, MultiThread) {
+    constexpr size_t kSize = 4096;
+    using Region = GuardedRegion<mode::SingleWriter, kSize>;
+    auto region = std::make_unique<Region>();
+    auto registry = std::make_unique<ReaderRegistry<8>>();
+
+    std::atomic<bool> readers_done{false};
+    std::thread writer{[&] {
+        int i{0};
+        while (not readers_done) {
+            region->Set(i++ & 127);
+        }
+    }};
+
+    std::vector<std::thread> readers;
+    for (uint64_t id = 1; id <= 2; id++) {
+        readers.emplace_back([&, id] {
+            auto slot = registry->Register(id);
+            ASSERT_TRUE(slot.has_value()) << slot.error();
+            auto into = std::make_unique<char[]>(kSize);
+            for (int i = 0; i < 200; i++) {
+                slot->Load(*region, into.get(), kSize);
+            }
+
+            // Also load through the lock.
+            SeqLock<mode::SingleWriter> lock{};
+            ASSERT_EQ(slot->Load(lock, [] {}), 0);
+
+            registry->ForEach([&](const ReaderStats& stats) {
+                if (stats.slot == slot->Slot()) {
+                    ASSERT_EQ(stats.id, id);
+                    ASSERT_EQ(stats.loads, 201);
+                    ASSERT_EQ(stats.last_seq, 0);
+                }
+            });
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    readers_done = true;
+    writer.join();
+    ASSERT_EQ(registry->Readers(), 0);
+}
+
+TEST(ReaderRegistry, Shm) {
+    using Registry = ReaderRegistry<16>;
+    ::shm_unlink("/readerregistry");
+
+    auto monitor_shm = util::SharedMemory<Registry>::Create("/readerregistry", sizeof(Registry));
+    ASSERT_TRUE(monitor_shm.has_value()) << monitor_shm.error();
+    auto reader_shm = util::SharedMemory<Registry>::Create("/readerregistry", sizeof(Registry));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+
+    auto slot = reader_shm->Get()->Register(42);
+    ASSERT_TRUE(slot.has_value()) << slot.error();
+    slot->Publish(100, 5);
+
+    size_t readers{0};
+    monitor_shm->Get()->ForEach([&](const ReaderStats& stats) {
+        ASSERT_EQ(stats.id, 42);
+        ASSERT_EQ(stats.last_seq, 100);
+        ASSERT_EQ(stats.loads, 1);
+        ASSERT_EQ(stats.retries, 5);
+        readers++;
+    });
+    ASSERT_EQ(readers, 1);
+}
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "seqlock/relay.hpp"
+#include "seqlock/seqlock.hpp"
+
+namespace {
+
+using Region = seqlock::GuardedRegion<seqlock::mode::SingleWriter, 512>;
+
+// Fans out updates of `state.range(1)` regions to `state.range(0)` subscribers, all subscribed to every region. Each
+// iteration updates every region and runs one relay pass, which sends one batch of messages to each subscriber. The
+// subscribers drain their sockets outside of the timed section. Items are messages.
+void BM_RelayFanOut(benchmark::State& state) {
+    const auto subscribers = static_cast<size_t>(state.range(0));
+    const auto regions = static_cast<size_t>(state.range(1));
+    const std::string path = "/tmp/seqlock-relay-bm.sock";
+
+    std::vector<std::unique_ptr<Region>> sources;
+    auto relay = seqlock::Relay::Listen(path);
+    if (not relay) {
+        state.SkipWithError(relay.error().c_str());
+        return;
+    }
+    for (size_t i = 0; i < regions; i++) {
+        sources.push_back(std::make_unique<Region>());
+        relay->Add(*sources.back());
+    }
+
+    const uint32_t all[]{seqlock::RelaySubscriber::kAllRegions};
+    std::vector<seqlock::RelaySubscriber> clients;
+    for (size_t i = 0; i < subscribers; i++) {
+        auto client = seqlock::RelaySubscriber::Connect(path, all);
+        if (not client) {
+            state.SkipWithError(client.error().c_str());
+            return;
+        }
+        clients.push_back(std::move(client.value()));
+    }
+    relay->RunOnce();
+
+    char into[Region::Size()];
+    int value{0};
+    for (auto _ : state) {
+        for (auto& source : sources) {
+            source->Set(value++);
+        }
+        benchmark::DoNotOptimize(relay->RunOnce());
+
+        state.PauseTiming();
+        for (auto& client : clients) {
+            while (client.Receive(into, sizeof(into), false).value_or(std::nullopt).has_value()) {
+            }
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(relay->Sent()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_RelayFanOut)->ArgsProduct({{1, 16, 256}, {1, 8}})->ArgNames({"subscribers", "regions"});
+
+BENCHMARK_MAIN();
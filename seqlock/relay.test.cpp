@@ -0,0 +1,228 @@
+#include "seqlock/relay.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+namespace {
+
+using Small = seqlock::GuardedRegion<seqlock::mode::SingleWriter, 64>;
+using Large = seqlock::GuardedRegion<seqlock::mode::MultiWriter, 4096>;
+
+const std::string kPath = "/tmp/seqlock-relay-test.sock";
+
+}  // namespace
+
+TEST(Relay, SendsLatestVersions) {
+    auto small = std::make_unique<Small>();
+    auto large = std::make_unique<Large>();
+    auto relay = seqlock::Relay::Listen(kPath);
+    ASSERT_TRUE(relay.has_value()) << relay.error();
+    ASSERT_EQ(relay->Add(*small), 0);
+    ASSERT_EQ(relay->Add(*large), 1);
+
+    small->Set(1);
+    const uint32_t regions[]{0};
+    auto subscriber = seqlock::RelaySubscriber::Connect(kPath, regions);
+    ASSERT_TRUE(subscriber.has_value()) << subscriber.error();
+
+    // The subscriber gets the current version of its region once subscribed.
+    ASSERT_EQ(relay->RunOnce(), 1);
+    ASSERT_EQ(relay->Subscribers(), 1);
+    char into[4096];
+    auto received = subscriber->Receive(into, sizeof(into));
+    ASSERT_TRUE(received.has_value()) << received.error();
+    ASSERT_EQ(received.value()->region, 0);
+    ASSERT_EQ(received.value()->size, 64);
+    ASSERT_EQ(received.value()->seq, 2);
+    ASSERT_EQ(into[0], 1);
+    ASSERT_EQ(into[63], 1);
+
+    // Versions stored between two passes are conflated, and regions the subscriber did not subscribe to are not sent.
+    small->Set(2);
+    small->Set(3);
+    large->Set(4);
+    ASSERT_EQ(relay->RunOnce(), 1);
+    ASSERT_EQ(relay->RunOnce(), 0);
+    received = subscriber->Receive(into, sizeof(into));
+    ASSERT_TRUE(received.has_value()) << received.error();
+    ASSERT_EQ(received.value()->seq, 6);
+    ASSERT_EQ(into[0], 3);
+    received = subscriber->Receive(into, sizeof(into), false);
+    ASSERT_TRUE(received.has_value()) << received.error();
+    ASSERT_FALSE(received.value().has_value());
+
+    // A subscriber to all regions gets both in one pass.
+    const uint32_t all[]{seqlock::RelaySubscriber::kAllRegions};
+    auto all_subscriber = seqlock::RelaySubscriber::Connect(kPath, all);
+    ASSERT_TRUE(all_subscriber.has_value()) << all_subscriber.error();
+    ASSERT_EQ(relay->RunOnce(), 2);
+    ASSERT_EQ(all_subscriber->Receive(into, sizeof(into)).value()->region, 0);
+    ASSERT_EQ(all_subscriber->Receive(into, sizeof(into)).value()->region, 1);
+    ASSERT_EQ(into[4095], 4);
+
+    // A buffer too small for the region is an error.
+    small->Set(5);
+    ASSERT_EQ(relay->RunOnce(), 2);
+    ASSERT_FALSE(subscriber->Receive(into, 8).has_value());
+
+    ASSERT_EQ(relay->Sent(), 6);
+}
+
+TEST(Relay, DropsLeavingAndInvalidSubscribers) {
+    auto small = std::make_unique<Small>();
+    auto relay = seqlock::Relay::Listen(kPath);
+    ASSERT_TRUE(relay.has_value()) << relay.error();
+    relay->Add(*small);
+    small->Set(1);
+
+    const uint32_t unknown[]{7};
+    auto invalid = seqlock::RelaySubscriber::Connect(kPath, unknown);
+    ASSERT_TRUE(invalid.has_value()) << invalid.error();
+    relay->RunOnce();
+    ASSERT_EQ(relay->Subscribers(), 0);
+    char into[64];
+    ASSERT_FALSE(invalid->Receive(into, sizeof(into)).has_value());
+
+    const uint32_t regions[]{0};
+    {
+        auto leaving = seqlock::RelaySubscriber::Connect(kPath, regions);
+        ASSERT_TRUE(leaving.has_value()) << leaving.error();
+        relay->RunOnce();
+        ASSERT_EQ(relay->Subscribers(), 1);
+    }
+    small->Set(2);
+    relay->RunOnce();
+    ASSERT_EQ(relay->Subscribers(), 0);
+}
+
+TEST(Relay, SlowSubscriberGetsLatest) {
+    auto large = std::make_unique<Large>();
+    auto relay = seqlock::Relay::Listen(kPath, 16 * 1024);
+    ASSERT_TRUE(relay.has_value()) << relay.error();
+    relay->Add(*large);
+
+    const uint32_t regions[]{0};
+    auto slow = seqlock::RelaySubscriber::Connect(kPath, regions);
+    ASSERT_TRUE(slow.has_value()) << slow.error();
+    auto fast = seqlock::RelaySubscriber::Connect(kPath, regions);
+    ASSERT_TRUE(fast.has_value()) << fast.error();
+
+    // The slow subscriber's buffer fills up while the fast one keeps draining its own.
+    constexpr int kVersions = 1000;
+    char into[4096];
+    int fast_received{0};
+    for (int i = 1; i <= kVersions; i++) {
+        large->Set(i & 127);
+        relay->RunOnce();
+        while (fast->Receive(into, sizeof(into), false).value().has_value()) {
+            fast_received++;
+        }
+    }
+    ASSERT_EQ(fast_received, kVersions);
+
+    int slow_received{0};
+    uint64_t last_seq{0};
+    while (true) {
+        const auto received = slow->Receive(into, sizeof(into), false);
+        ASSERT_TRUE(received.has_value()) << received.error();
+        if (not received.value().has_value()) {
+            if (relay->RunOnce() == 0) {
+                break;
+            }
+            continue;
+        }
+        ASSERT_GT(received.value()->seq, last_seq);
+        last_seq = received.value()->seq;
+        for (size_t i = 0; i < sizeof(into); i++) {
+            ASSERT_EQ(into[i], into[0]);
+        }
+        slow_received++;
+    }
+    ASSERT_LT(slow_received, kVersions);
+    ASSERT_EQ(last_seq, large->Sequence());
+    ASSERT_EQ(into[0], kVersions & 127);
+}
+
+TEST(Relay, Run) {
+    auto small = std::make_unique<Small>();
+    auto relay = seqlock::Relay::Listen(kPath);
+    ASSERT_TRUE(relay.has_value()) << relay.error();
+    relay->Add(*small);
+
+    std::thread runner{[&] { relay->Run(); }};
+    const uint32_t regions[]{0};
+    auto subscriber = seqlock::RelaySubscriber::Connect(kPath, regions);
+    ASSERT_TRUE(subscriber.has_value()) << subscriber.error();
+
+    // Every received version is consistent, and the last one is eventually received.
+    char into[64];
+    for (int i = 1; i <= 100; i++) {
+        small->Set(i);
+        while (true) {
+            const auto received = subscriber->Receive(into, sizeof(into));
+            ASSERT_TRUE(received.has_value()) << received.error();
+            for (size_t j = 0; j < sizeof(into); j++) {
+                ASSERT_EQ(into[j], into[0]);
+            }
+            if (received.value()->seq == static_cast<uint64_t>(2 * i)) {
+                break;
+            }
+        }
+    }
+
+    relay->Stop();
+    runner.join();
+}
+
+// The relay loads the region while it is being written. A subscriber connecting late and receiving slowly must only
+// get consistent versions, each matching the sequence number in its header.
+TEST(Relay, ConcurrentWriterSlowSubscriber) {
+    auto large = std::make_unique<Large>();
+    auto relay = seqlock::Relay::Listen(kPath, 16 * 1024);
+    ASSERT_TRUE(relay.has_value()) << relay.error();
+    relay->Add(*large);
+
+    std::atomic<bool> done{false};
+    std::thread runner{[&] { relay->Run(); }};
+    std::thread writer{[&] {
+        for (int i = 1; not done.load(std::memory_order_relaxed); i++) {
+            large->Set(i & 127);
+        }
+    }};
+
+    while (large->Sequence() < 10'000) {
+        std::this_thread::yield();
+    }
+    const uint32_t regions[]{0};
+    auto subscriber = seqlock::RelaySubscriber::Connect(kPath, regions);
+    ASSERT_TRUE(subscriber.has_value()) << subscriber.error();
+
+    char into[4096];
+    uint64_t last_seq{0};
+    for (int received_versions = 0; received_versions < 200; received_versions++) {
+        const auto received = subscriber->Receive(into, sizeof(into));
+        ASSERT_TRUE(received.has_value()) << received.error();
+        ASSERT_GT(received.value()->seq, last_seq);
+        last_seq = received.value()->seq;
+        ASSERT_EQ(into[0], static_cast<char>((last_seq / 2) & 127));
+        for (size_t i = 0; i < sizeof(into); i++) {
+            ASSERT_EQ(into[i], into[0]);
+        }
+        if (received_versions % 4 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+    }
+
+    done.store(true);
+    writer.join();
+    relay->Stop();
+    runner.join();
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+
+#include "seqlock/seqlock.hpp"
+#include "testdata/quote.hpp"
+
+namespace {
+
+using QuoteRegion = market::QuoteRegion<seqlock::mode::SingleWriter>;
+using TradeRegion = market::TradeRegion<seqlock::mode::MultiWriter>;
+
+market::Quote MakeQuote() {
+    market::Quote quote;
+    quote.bid = 99.5;
+    quote.ask = 100.25;
+    quote.bid_size = 10;
+    quote.ask_size = 20;
+    std::memcpy(quote.venue, "XNAS", 4);
+    quote.halted = true;
+    for (int i = 0; i < 16; i++) {
+        quote.depth[i] = i - 8;
+    }
+    return quote;
+}
+
+}  // namespace
+
+TEST(Schema, StoreLoad) {
+    auto region = std::make_unique<QuoteRegion>();
+    const market::Quote quote = MakeQuote();
+    region->Store(quote);
+
+    market::Quote into;
+    into.layout_hash = 0;
+    ASSERT_EQ(region->Load(into), 2);
+    ASSERT_EQ(std::memcmp(&into, &quote, sizeof(quote)), 0);
+
+    TradeRegion trades;
+    trades.Store(market::Trade{.price = 100.0, .quantity = -5, .side = 1});
+    market::Trade trade;
+    trades.Load(trade);
+    ASSERT_EQ(trade.price, 100.0);
+    ASSERT_EQ(trade.quantity, -5);
+    ASSERT_EQ(trade.side, 1);
+    ASSERT_NE(market::Quote::kLayoutHash, market::Trade::kLayoutHash);
+}
+
+TEST(Schema, LoadFields) {
+    auto region = std::make_unique<QuoteRegion>();
+    const market::Quote quote = MakeQuote();
+    region->Store(quote);
+
+    // Only the selected fields are copied, the others keep their value.
+    market::Quote into;
+    into.bid_size = 1;
+    uint64_t seq{0};
+    ASSERT_TRUE(region->TryLoad(into, market::Quote::kBid | market::Quote::kDepth, &seq));
+    ASSERT_EQ(seq, 2);
+    ASSERT_EQ(into.bid, quote.bid);
+    ASSERT_EQ(std::memcmp(into.depth, quote.depth, sizeof(quote.depth)), 0);
+    ASSERT_EQ(into.bid_size, 1);
+    ASSERT_EQ(into.ask, 0.0);
+
+    ASSERT_EQ(region->Load(into, market::Quote::kAll), 2);
+    ASSERT_EQ(std::memcmp(&into, &quote, sizeof(quote)), 0);
+
+    ASSERT_EQ(region->LoadAsk(), quote.ask);
+    ASSERT_EQ(region->LoadAskSize(), quote.ask_size);
+    ASSERT_TRUE(region->LoadHalted());
+    char venue[8];
+    region->LoadVenue(venue);
+    ASSERT_STREQ(venue, "XNAS");
+}
+
+TEST(Schema, CheckLayout) {
+    auto region = std::make_unique<QuoteRegion>();
+    auto result = region->CheckLayout();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.error(), "Quote was never stored.");
+
+    market::Quote quote = MakeQuote();
+    region->Store(quote);
+    ASSERT_TRUE(region->CheckLayout());
+
+    // A writer generated from another version of the schema stores another hash.
+    quote.layout_hash = 0x1234;
+    region->Store(quote);
+    result = region->CheckLayout();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.error(), "Quote has layout hash 0x1234 instead of 0xa7a6cda010f1ff44.");
+}
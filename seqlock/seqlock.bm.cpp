@@ -3,8 +3,13 @@
 #include <benchmark/benchmark.h>
 
 #include <atomic>
+#include <memory>
 #include <thread>
 
+#include "seqlock/atomic_region.hpp"
+
+using seqlock::AtomicRegion;
+using seqlock::GuardedRegion;
 using seqlock::SeqLock;
 
 static void BM_SeqLockReference(benchmark::State& state) {
@@ -53,7 +58,137 @@ static void BM_SeqLockSingleWriter(benchmark::State& state) {
     }
 }
 
+// Writers store to the same lock, `state.threads()` of them contending. `lock_bytes` is the footprint of the lock.
+template <seqlock::mode::Mode ModeT>
+static void BM_SeqLockStore(benchmark::State& state) {
+    static SeqLock<ModeT> store_lock{};
+    static int store_shared{0};
+
+    for (auto _ : state) {
+        store_lock.Store([&] { store_shared++; });
+    }
+    benchmark::DoNotOptimize(store_shared);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["lock_bytes"] = benchmark::Counter(sizeof(SeqLock<ModeT>), benchmark::Counter::kAvgThreads);
+}
+
+// A writer stores to random locks of a large array, as in a table of per-instrument regions. Compact locks halve the
+// footprint of the array, and so the cache misses per store.
+template <seqlock::mode::Mode ModeT>
+static void BM_SeqLockArrayStore(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    auto locks = std::make_unique<SeqLock<ModeT>[]>(count);
+    auto values = std::make_unique<int[]>(count);
+
+    uint64_t index{0};
+    for (auto _ : state) {
+        // A cheap LCG is enough to defeat the prefetcher.
+        index = index * 6364136223846793005ULL + 1442695040888963407ULL;
+        const size_t i = (index >> 33) % count;
+        locks[i].Store([&] { values[i]++; });
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["array_bytes"] = static_cast<double>(count * sizeof(SeqLock<ModeT>));
+}
+
+// A reader loads random regions of a large array, as in a table of per-instrument top of books. Inline regions touch a
+// single cache line per load, the others two.
+template <typename RegionT>
+static void BM_RegionArrayLoad(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    auto regions = std::make_unique<RegionT[]>(count);
+
+    char into[RegionT::Size()];
+    uint64_t index{0};
+    for (auto _ : state) {
+        index = index * 6364136223846793005ULL + 1442695040888963407ULL;
+        regions[(index >> 33) % count].Load(into, sizeof(into));
+        benchmark::DoNotOptimize(into);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["array_bytes"] = static_cast<double>(count * sizeof(RegionT));
+}
+
+// The reader cost of a fence policy: uncontended loads of a small region, which hit the cache. Readers pay for their
+// fences on every load, which dominate here.
+template <seqlock::fence::Policy FenceT>
+static void BM_FenceLoad(benchmark::State& state) {
+    auto region = std::make_unique<GuardedRegion<seqlock::mode::SingleWriter, 16, FenceT>>();
+    region->Set(1);
+
+    char into[16];
+    for (auto _ : state) {
+        region->Load(into, sizeof(into));
+        benchmark::DoNotOptimize(into);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// The writer cost of a fence policy: stores to a small region. `ModeT` is a compact mode to include the exchange that
+// acquires the lock.
+template <seqlock::fence::Policy FenceT, seqlock::mode::Mode ModeT = seqlock::mode::SingleWriter>
+static void BM_FenceStore(benchmark::State& state) {
+    auto region = std::make_unique<GuardedRegion<ModeT, 16, FenceT>>();
+
+    char from[16]{};
+    for (auto _ : state) {
+        from[0]++;
+        region->Store(from, sizeof(from));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// A writer republishes an 8 KiB book of which `state.range(0)` percent of the cache lines changed, with `Store` if
+// `state.range(1)` is 0 and with `StoreChanged` otherwise. `lines_written` is what readers have to fetch again.
+static void BM_StoreChanged(benchmark::State& state) {
+    constexpr size_t kSize = 8192;
+    constexpr size_t kLines = kSize / 64;
+    auto region = std::make_unique<GuardedRegion<seqlock::mode::SingleWriter, kSize>>();
+    auto from = std::make_unique<char[]>(kSize);
+    region->Store(from.get(), kSize);
+
+    const auto changed = static_cast<size_t>(state.range(0)) * kLines / 100;
+    // Spread the changed lines over the region.
+    const size_t stride = changed == 0 ? 0 : kLines / changed * 64;
+    const bool diff = state.range(1) != 0;
+    size_t lines_written{0};
+    for (auto _ : state) {
+        for (size_t i = 0; i < changed; i++) {
+            from[i * stride]++;
+        }
+        if (diff) {
+            lines_written += region->StoreChanged(from.get(), kSize);
+        } else {
+            region->Store(from.get(), kSize);
+            lines_written += kLines;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["lines_written"] =
+        benchmark::Counter(static_cast<double>(lines_written) / static_cast<double>(state.iterations()));
+}
+
 BENCHMARK(BM_SeqLockReference);
+BENCHMARK(BM_SeqLockStore<seqlock::mode::MultiWriter>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SeqLockStore<seqlock::mode::CompactMultiWriter<>>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SeqLockStore<seqlock::mode::CompactMultiWriter32>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SeqLockArrayStore<seqlock::mode::MultiWriter>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_SeqLockArrayStore<seqlock::mode::CompactMultiWriter<>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_RegionArrayLoad<GuardedRegion<seqlock::mode::SingleWriter, 56>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_RegionArrayLoad<GuardedRegion<seqlock::mode::SingleWriter, 57>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_RegionArrayLoad<GuardedRegion<seqlock::mode::SingleWriter, 16>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_RegionArrayLoad<AtomicRegion<16>>)->Range(1 << 10, 1 << 18);
 BENCHMARK(BM_SeqLockSingleWriter)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_StoreChanged)->ArgsProduct({{0, 1, 10, 50, 100}, {0, 1}})->ArgNames({"changed%", "diff"});
+BENCHMARK(BM_FenceLoad<seqlock::fence::Barrier>);
+BENCHMARK(BM_FenceLoad<seqlock::fence::ThreadFence>);
+BENCHMARK(BM_FenceLoad<seqlock::fence::SeqCst>);
+BENCHMARK(BM_FenceLoad<seqlock::fence::AcquireLoad>);
+BENCHMARK(BM_FenceStore<seqlock::fence::Barrier>);
+BENCHMARK(BM_FenceStore<seqlock::fence::ThreadFence>);
+BENCHMARK(BM_FenceStore<seqlock::fence::SeqCst>);
+BENCHMARK(BM_FenceStore<seqlock::fence::AcquireLoad>);
+BENCHMARK(BM_FenceStore<seqlock::fence::Barrier, seqlock::mode::CompactMultiWriter<>>);
+BENCHMARK(BM_FenceStore<seqlock::fence::SeqCst, seqlock::mode::CompactMultiWriter<>>);
 
 BENCHMARK_MAIN();
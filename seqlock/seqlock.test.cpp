@@ -3,8 +3,10 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -19,6 +21,107 @@ TEST(SeqLock, CorrectMode) {
     // basically checking if SFINAE works
     EXPECT_EQ(sizeof(SeqLock<mode::SingleWriter>), 64 /* since it's aligned.. otherwise it would be 8 */);
     EXPECT_GT(sizeof(SeqLock<mode::MultiWriter>), sizeof(SeqLock<mode::SingleWriter>));
+    EXPECT_EQ(sizeof(SeqLock<mode::CompactMultiWriter<>>), sizeof(SeqLock<mode::SingleWriter>));
+    EXPECT_EQ(sizeof(SeqLock<mode::CompactMultiWriter32>), sizeof(SeqLock<mode::SingleWriter>));
+    EXPECT_EQ(sizeof(SeqLock<mode::SingleWriter, 56>), sizeof(SeqLock<mode::SingleWriter>));
+    EXPECT_EQ(sizeof(SeqLock<mode::MultiWriter, 56>), sizeof(SeqLock<mode::MultiWriter>));
+}
+
+TEST(GuardedRegion, InlineLayout) {
+    // Payloads that fit next to the sequence number share its cache line.
+    EXPECT_TRUE((GuardedRegion<mode::SingleWriter, 8>::IsInline()));
+    EXPECT_EQ(sizeof(GuardedRegion<mode::SingleWriter, 8>), 64);
+    EXPECT_EQ(sizeof(GuardedRegion<mode::SingleWriter, 56>), 64);
+    EXPECT_EQ(sizeof(GuardedRegion<mode::CompactMultiWriter<>, 56>), 64);
+    EXPECT_EQ(sizeof(GuardedRegion<mode::CompactMultiWriter32, 60>), 64);
+
+    // Larger ones start on the next cache line.
+    EXPECT_FALSE((GuardedRegion<mode::SingleWriter, 57>::IsInline()));
+    EXPECT_EQ(sizeof(GuardedRegion<mode::SingleWriter, 57>), 128);
+    EXPECT_FALSE((GuardedRegion<mode::CompactMultiWriter32, 61>::IsInline()));
+
+    auto region = std::make_unique<GuardedRegion<mode::SingleWriter, 56>>();
+    char from[56];
+    char into[56];
+    for (int i = 1; i <= 3; i++) {
+        std::memset(from, i, sizeof(from));
+        region->Store(from, sizeof(from));
+        ASSERT_EQ(region->Load(into, sizeof(into)), 2 * i);
+        ASSERT_EQ(std::memcmp(from, into, sizeof(into)), 0);
+    }
+}
+
+TEST(GuardedRegion, MultiWriterLayout) {
+    // Multi-writer payloads start after the writer lock whatever their size, where the Go and Python bindings expect
+    // them.
+    EXPECT_FALSE((GuardedRegion<mode::MultiWriter, 1>::IsInline()));
+    EXPECT_FALSE((GuardedRegion<mode::MultiWriter, 56>::IsInline()));
+    EXPECT_EQ(sizeof(GuardedRegion<mode::MultiWriter, 8>), 192);
+    EXPECT_EQ(sizeof(GuardedRegion<mode::MultiWriter, 56>), 192);
+
+    const auto check = []<size_t N>(std::unique_ptr<GuardedRegion<mode::MultiWriter, N>> region) {
+        region->Set(7);
+        const char* raw = reinterpret_cast<const char*>(region.get());
+        ASSERT_EQ(raw[127], 0);
+        for (size_t i = 128; i < 128 + N; i++) {
+            ASSERT_EQ(raw[i], 7);
+        }
+    };
+    check(std::make_unique<GuardedRegion<mode::MultiWriter, 8>>());
+    check(std::make_unique<GuardedRegion<mode::MultiWriter, 56>>());
+}
+
+TEST(GuardedRegion, DataOffset) {
+    EXPECT_EQ((GuardedRegion<mode::SingleWriter, 56>::DataOffset()), 8);
+    EXPECT_EQ((GuardedRegion<mode::SingleWriter, 57>::DataOffset()), 64);
+    EXPECT_EQ((GuardedRegion<mode::MultiWriter, 8>::DataOffset()), 128);
+
+    using Region = GuardedRegion<mode::SingleWriter, 192>;
+    auto region = std::make_unique<Region>();
+    region->Set(7);
+    const char* raw = reinterpret_cast<const char*>(region.get());
+    ASSERT_EQ(raw[Region::DataOffset() - 1], 0);
+    ASSERT_EQ(raw[Region::DataOffset()], 7);
+}
+
+TEST(GuardedRegion, StoreChanged) {
+    constexpr size_t kSize = 8192;
+    auto region = std::make_unique<GuardedRegion<mode::SingleWriter, kSize>>();
+    std::vector<char> from(kSize, 1);
+    std::vector<char> into(kSize);
+
+    ASSERT_EQ(region->StoreChanged(from.data(), from.size()), kSize / 64);
+    ASSERT_EQ(region->Sequence(), 2);
+
+    // Nothing changed, so nothing is stored.
+    ASSERT_EQ(region->StoreChanged(from.data(), from.size()), 0);
+    ASSERT_EQ(region->Sequence(), 2);
+
+    from[0] = 2;
+    from[64 * 70 + 63] = 3;
+    from[kSize - 1] = 4;
+    ASSERT_EQ(region->StoreChanged(from.data(), from.size()), 3);
+    ASSERT_EQ(region->Load(into.data(), into.size()), 4);
+    ASSERT_EQ(into, from);
+
+    // Only the first `size` bytes are compared and written, the last line being partial.
+    from[99] = 5;
+    from[100] = 6;
+    ASSERT_EQ(region->StoreChanged(from.data(), 100), 1);
+    region->Load(into.data(), into.size());
+    ASSERT_EQ(into[99], 5);
+    ASSERT_EQ(into[100], 1);
+
+    // Multiple writers compare under the lock, which they take even if nothing changed.
+    auto multi = std::make_unique<GuardedRegion<mode::MultiWriter, 100>>();
+    ASSERT_EQ(multi->StoreChanged(from.data(), 100), 2);
+    ASSERT_EQ(multi->StoreChanged(from.data(), 100), 0);
+    ASSERT_EQ(multi->Sequence(), 4);
+
+    // An inline payload is a single line.
+    auto small = std::make_unique<GuardedRegion<mode::SingleWriter, 56>>();
+    ASSERT_EQ(small->StoreChanged(from.data(), 56), 1);
+    ASSERT_EQ(small->StoreChanged(from.data(), 56), 0);
 }
 
 TEST(SeqLock, SingleThread) {
@@ -129,7 +232,7 @@ class Writer {
     }
 
     void Run()
-        requires std::same_as<ModeT, mode::MultiWriter>
+        requires(not std::same_as<ModeT, mode::SingleWriter>)
     {
         cout_mutex.lock();
         std::cout << "writer " << id_ << " starting" << std::endl;
@@ -303,6 +406,113 @@ TEST(SeqLock, TwoWritersTryStore) {
     }
 }
 
+template <mode::Mode ModeT>
+static void CompactMultiWriterMultiReader() {
+    SeqLock<ModeT> lock{};
+
+    char buf[kBufferSize];
+    memset(buf, 0, kBufferSize);
+
+    constexpr size_t kReaders = 4;
+    constexpr size_t kWriters = 4;
+    std::vector<Reader<ModeT>> readers;
+    std::vector<Writer<ModeT>> writers;
+    std::vector<std::thread> threads;
+    readers.reserve(kReaders);
+    writers.reserve(kWriters);
+    for (size_t i = 0; i < kReaders; i++) {
+        threads.emplace_back([&reader = readers.emplace_back(lock, buf, i)] { reader.Run(); });
+    }
+    for (size_t i = 0; i < kWriters; i++) {
+        threads.emplace_back([&writer = writers.emplace_back(lock, buf, i)] { writer.Run(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // No store was lost.
+    ASSERT_EQ(static_cast<uint64_t>(lock.Sequence()), 2 * kWriters * 1'000'000);
+}
+
+TEST(SeqLock, MultiThreadCompactMultiWriterMultiReader) { CompactMultiWriterMultiReader<mode::CompactMultiWriter<>>(); }
+
+TEST(SeqLock, MultiThreadCompactMultiWriter32MultiReader) {
+    CompactMultiWriterMultiReader<mode::CompactMultiWriter32>();
+}
+
+TEST(SeqLock, CompactTryStore) {
+    SeqLock<mode::CompactMultiWriter<>> lock{};
+
+    ASSERT_TRUE(lock.TryStore([&] {
+        ASSERT_TRUE(lock.WriterStalled());
+        // A write is in progress, so other writers back off.
+        ASSERT_FALSE(lock.TryStore([] { FAIL(); }));
+    }));
+    ASSERT_FALSE(lock.WriterStalled());
+    ASSERT_EQ(lock.Sequence(), 2);
+
+    int stores[2]{0, 0};
+    std::thread writers[2];
+    for (int w = 0; w < 2; w++) {
+        writers[w] = std::thread{[&, w] {
+            while (stores[w] < 100'000) {
+                if (lock.TryStore([] {})) {
+                    stores[w]++;
+                }
+            }
+        }};
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(lock.Sequence(), 2 + 2 * 200'000);
+}
+
+// One writer stores while readers check that every copy is consistent, with the given fence policy.
+template <fence::Policy FenceT, mode::Mode ModeT = mode::SingleWriter>
+static void FencePolicyMultiReader() {
+    auto region = std::make_unique<GuardedRegion<ModeT, kBufferSize, FenceT>>();
+    std::atomic<bool> done{false};
+
+    std::thread writer{[&] {
+        for (int i = 1; i <= 100'000; i++) {
+            region->Set(i & 255);
+        }
+        done.store(true);
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; r++) {
+        readers.emplace_back([&] {
+            char into[kBufferSize];
+            uint64_t last_seq{0};
+            while (not done.load()) {
+                const uint64_t seq = region->Load(into, sizeof(into));
+                ASSERT_GE(seq, last_seq);
+                last_seq = seq;
+                for (size_t i = 1; i < kBufferSize; i++) {
+                    ASSERT_EQ(into[i], into[0]);
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(region->Sequence(), 200'000);
+}
+
+TEST(SeqLock, FencePolicies) {
+    FencePolicyMultiReader<fence::Barrier>();
+    FencePolicyMultiReader<fence::ThreadFence>();
+    FencePolicyMultiReader<fence::SeqCst>();
+    FencePolicyMultiReader<fence::AcquireLoad>();
+    FencePolicyMultiReader<fence::ThreadFence, mode::CompactMultiWriter<>>();
+    FencePolicyMultiReader<fence::SeqCst, mode::CompactMultiWriter32>();
+}
+
 TEST(SeqLock, Shm) {
     using namespace std::chrono_literals;
 
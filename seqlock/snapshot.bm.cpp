@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "seqlock/seqlock.hpp"
+#include "seqlock/snapshot.hpp"
+
+namespace {
+
+constexpr size_t kSize = 4096;
+
+using Region = seqlock::GuardedRegion<seqlock::mode::SingleWriter, kSize>;
+using Publisher = seqlock::SnapshotPublisher<kSize, 64>;
+
+Region* region{nullptr};
+Publisher* publisher{nullptr};
+std::thread* writer{nullptr};
+std::atomic<bool> writer_done{false};
+
+// Stores to the region every 10us. With `publish`, the writer thread also publishes every version, standing in for the
+// thread that refreshes the snapshot every tick.
+void StartWriter(bool publish) {
+    region = new Region;
+    publisher = new Publisher;
+    writer_done.store(false);
+    writer = new std::thread{[publish] {
+        for (int i = 0; not writer_done.load(std::memory_order_relaxed); i++) {
+            region->Set(i);
+            if (publish) {
+                publisher->Refresh(*region);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds{10});
+        }
+    }};
+}
+
+void StopWriter() {
+    writer_done.store(true);
+    writer->join();
+    delete writer;
+    delete publisher;
+    delete region;
+}
+
+// Every thread copies the region out itself, racing the writer.
+void BM_Load(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        StartWriter(false);
+    }
+    auto into = std::make_unique<char[]>(kSize);
+    for (auto _ : state) {
+        region->Load(into.get(), kSize);
+        benchmark::DoNotOptimize(into[0] + into[kSize - 1]);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        StopWriter();
+    }
+}
+
+// Every thread reads the snapshot published by the writer thread in place.
+void BM_Acquire(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        StartWriter(true);
+    }
+    for (auto _ : state) {
+        const auto snapshot = publisher->Acquire();
+        if (not snapshot.Empty()) {
+            benchmark::DoNotOptimize(snapshot.Data()[0] + snapshot.Data()[kSize - 1]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    if (state.thread_index() == 0) {
+        StopWriter();
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Load)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_Acquire)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
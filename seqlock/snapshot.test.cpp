@@ -0,0 +1,110 @@
+#include "seqlock/snapshot.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kSize = 4096;
+
+using Region = seqlock::GuardedRegion<seqlock::mode::SingleWriter, kSize>;
+
+}  // namespace
+
+TEST(SnapshotPublisher, Publish) {
+    using Publisher = seqlock::SnapshotPublisher<kSize, 3>;
+    using Status = Publisher::RefreshStatus;
+    auto region = std::make_unique<Region>();
+    auto publisher = std::make_unique<Publisher>();
+
+    ASSERT_TRUE(publisher->Acquire().Empty());
+    ASSERT_EQ(publisher->Sequence(), 0);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kUnchanged);
+
+    region->Set(1);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPublished);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kUnchanged);
+    ASSERT_EQ(publisher->Sequence(), 2);
+
+    // A held snapshot is not overwritten by later versions.
+    auto first = publisher->Acquire();
+    ASSERT_FALSE(first.Empty());
+    ASSERT_EQ(first.Sequence(), 2);
+    ASSERT_EQ(first.Data()[0], 1);
+    region->Set(2);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPublished);
+    region->Set(3);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPublished);
+    ASSERT_EQ(first.Data()[kSize - 1], 1);
+    auto third = publisher->Acquire();
+    ASSERT_EQ(third.Sequence(), 6);
+    ASSERT_EQ(third.Data()[kSize - 1], 3);
+
+    // Every buffer is held, either by a reader or as the published one.
+    auto also_third = publisher->Acquire();
+    region->Set(4);
+    auto second = publisher->Acquire();
+    ASSERT_EQ(second.Sequence(), 6);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPublished);
+    region->Set(5);
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPinned);
+    ASSERT_EQ(publisher->Sequence(), 8);
+
+    first = std::move(third);
+    ASSERT_EQ(first.Sequence(), 6);
+    ASSERT_TRUE(third.Empty());
+    ASSERT_EQ(publisher->Refresh(*region), Status::kPublished);
+    ASSERT_EQ(publisher->Acquire().Data()[0], 5);
+}
+
+TEST(SnapshotPublisher, MultiThread) {
+    constexpr int kReaders = 4;
+    // Each reader holds at most one snapshot, and the publisher the published one, so a buffer is always free.
+    using Publisher = seqlock::SnapshotPublisher<kSize, kReaders + 2>;
+    auto region = std::make_unique<Region>();
+    auto publisher = std::make_unique<Publisher>();
+    std::atomic<bool> done{false};
+
+    std::thread writer{[&] {
+        for (int i = 1; i <= 500; i++) {
+            region->Set(i & 127);
+            EXPECT_EQ(publisher->Refresh(*region), Publisher::RefreshStatus::kPublished);
+            std::this_thread::sleep_for(20us);
+        }
+        done.store(true);
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; r++) {
+        readers.emplace_back([&] {
+            uint64_t last_seq{0};
+            while (not done.load()) {
+                const auto snapshot = publisher->Acquire();
+                if (snapshot.Empty()) {
+                    continue;
+                }
+                ASSERT_GE(snapshot.Sequence(), last_seq);
+                last_seq = snapshot.Sequence();
+                for (size_t i = 0; i < kSize; i++) {
+                    ASSERT_EQ(snapshot.Data()[i], snapshot.Data()[0]);
+                }
+                ASSERT_EQ(snapshot.Data()[0], static_cast<char>((last_seq / 2) & 127));
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(publisher->Sequence(), 1000);
+}
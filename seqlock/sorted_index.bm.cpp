@@ -0,0 +1,100 @@
+#include "seqlock/sorted_index.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "seqlock/seqlock.hpp"
+
+using seqlock::GuardedRegion;
+using seqlock::SortedIndex;
+using seqlock::mode::SingleWriter;
+
+struct Entry {
+    int64_t key;
+    int64_t value;
+};
+
+// Keys are spread out, such that half of the lookups fall between two keys.
+static int64_t KeyAt(size_t i) { return static_cast<int64_t>(i) * 2; }
+
+static int64_t LookupKey(uint64_t i, size_t size) { return static_cast<int64_t>(i % (2 * size)); }
+
+// The baseline: the sorted array lives in a `GuardedRegion`, which readers copy out before binary-searching it.
+template <size_t Size>
+static void BM_GuardedRegionLowerBound(benchmark::State& state) {
+    using Region = GuardedRegion<SingleWriter, Size * sizeof(Entry)>;
+    auto region = std::make_unique<Region>();
+    std::vector<Entry> entries(Size);
+    for (size_t i = 0; i < Size; i++) {
+        entries[i] = {KeyAt(i), static_cast<int64_t>(i)};
+    }
+    region->Store(reinterpret_cast<const char*>(entries.data()), Region::Size());
+
+    const auto span = static_cast<size_t>(state.range(0));
+    std::vector<Entry> into(Size);
+    std::vector<Entry> range(span);
+    uint64_t i{0};
+    for (auto _ : state) {
+        const int64_t key = LookupKey(i, Size);
+        region->Load(reinterpret_cast<char*>(into.data()), Region::Size());
+        const auto it =
+            std::lower_bound(into.begin(), into.end(), key, [](const Entry& e, int64_t k) { return e.key < k; });
+        const auto end = std::min(it + static_cast<ptrdiff_t>(span), into.end());
+        std::copy(it, end, range.begin());
+        benchmark::DoNotOptimize(range.data());
+        i += 40503;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <size_t Size>
+static void BM_SortedIndexLowerBound(benchmark::State& state) {
+    using Index = SortedIndex<SingleWriter, int64_t, int64_t, Size>;
+    auto index = std::make_unique<Index>();
+    for (size_t i = 0; i < Size; i++) {
+        index->Upsert(KeyAt(i), static_cast<int64_t>(i));
+    }
+
+    const auto span = static_cast<size_t>(state.range(0));
+    std::vector<typename Index::Entry> range(span);
+    uint64_t i{0};
+    for (auto _ : state) {
+        const int64_t key = LookupKey(i, Size);
+        benchmark::DoNotOptimize(index->Range(key, INT64_MAX, range));
+        i += 40503;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Upserts and erases keys in a scattered order, keeping the index about half full. Most operations shift entries
+// within a node, and some split or merge nodes.
+template <size_t Size>
+static void BM_SortedIndexUpsertErase(benchmark::State& state) {
+    using Index = SortedIndex<SingleWriter, int64_t, int64_t, Size>;
+    auto index = std::make_unique<Index>();
+    for (size_t i = 0; i < Size; i += 2) {
+        index->Upsert(KeyAt(i), 0);
+    }
+
+    uint64_t i{0};
+    for (auto _ : state) {
+        const int64_t key = KeyAt(i % Size);
+        if (not index->Erase(key)) {
+            index->Upsert(key, key);
+        }
+        i += 40503;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(BM_GuardedRegionLowerBound<256>)->Arg(1)->Arg(16)->ArgName("entries");
+BENCHMARK(BM_SortedIndexLowerBound<256>)->Arg(1)->Arg(16)->ArgName("entries");
+BENCHMARK(BM_GuardedRegionLowerBound<4096>)->Arg(1)->Arg(16)->ArgName("entries");
+BENCHMARK(BM_SortedIndexLowerBound<4096>)->Arg(1)->Arg(16)->ArgName("entries");
+BENCHMARK(BM_SortedIndexUpsertErase<256>);
+BENCHMARK(BM_SortedIndexUpsertErase<4096>);
+
+BENCHMARK_MAIN();
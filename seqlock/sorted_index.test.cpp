@@ -0,0 +1,169 @@
+#include "seqlock/sorted_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace seqlock;  // NOLINT
+
+TEST(SortedIndex, UpsertFindErase) {
+    auto index = std::make_unique<SortedIndex<mode::SingleWriter, int64_t, uint64_t, 64>>();
+    ASSERT_EQ(index->Size(), 0);
+    ASSERT_FALSE(index->Contains(1));
+
+    ASSERT_TRUE(index->Upsert(10, 100));
+    ASSERT_TRUE(index->Upsert(-5, 50));
+    ASSERT_TRUE(index->Upsert(10, 101));
+    ASSERT_EQ(index->Size(), 2);
+
+    uint64_t value{0};
+    ASSERT_TRUE(index->Find(10, value));
+    ASSERT_EQ(value, 101);
+    ASSERT_TRUE(index->Find(-5, value));
+    ASSERT_EQ(value, 50);
+
+    decltype(index)::element_type::Entry entry{};
+    ASSERT_TRUE(index->LowerBound(0, entry));
+    ASSERT_EQ(entry.key, 10);
+    ASSERT_TRUE(index->LowerBound(INT64_MIN, entry));
+    ASSERT_EQ(entry.key, -5);
+    ASSERT_FALSE(index->LowerBound(11, entry));
+
+    ASSERT_TRUE(index->Erase(10));
+    ASSERT_FALSE(index->Erase(10));
+    ASSERT_FALSE(index->Contains(10));
+    ASSERT_EQ(index->Size(), 1);
+}
+
+TEST(SortedIndex, UnsignedKeys) {
+    using Index = SortedIndex<mode::SingleWriter, uint64_t, int, 16>;
+    auto index = std::make_unique<Index>();
+    ASSERT_TRUE(index->Upsert(UINT64_MAX, 3));
+    ASSERT_TRUE(index->Upsert(1ULL << 63, 2));
+    ASSERT_TRUE(index->Upsert(0, 1));
+
+    Index::Entry entries[4];
+    ASSERT_EQ(index->Range(0, UINT64_MAX, entries), 2);
+    ASSERT_EQ(entries[0].key, 0);
+    ASSERT_EQ(entries[1].key, 1ULL << 63);
+    ASSERT_TRUE(index->LowerBound(UINT64_MAX, entries[0]));
+    ASSERT_EQ(entries[0].value, 3);
+}
+
+// Random upserts and erases, large enough to split, merge and rebalance nodes, checked against `std::map`.
+TEST(SortedIndex, MatchesMap) {
+    using Index = SortedIndex<mode::SingleWriter, int64_t, int64_t, 1024>;
+    auto index = std::make_unique<Index>();
+    std::map<int64_t, int64_t> expected;
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int64_t> key_dist{-2000, 2000};
+
+    std::vector<Index::Entry> entries(Index::MaxSize());
+    for (int round = 0; round < 20'000; round++) {
+        const int64_t key = key_dist(gen);
+        // Grow the index during the first half and shrink it during the second.
+        const bool insert = (gen() % 100) < (round < 10'000 ? 70U : 30U);
+        if (insert) {
+            const bool full = expected.size() == Index::MaxSize() and not expected.contains(key);
+            ASSERT_EQ(index->Upsert(key, key * 3 + round), not full);
+            if (not full) {
+                expected[key] = key * 3 + round;
+            }
+        } else {
+            ASSERT_EQ(index->Erase(key), expected.erase(key) == 1);
+        }
+        ASSERT_EQ(index->Size(), expected.size());
+
+        if (round % 97 == 0) {
+            const int64_t from = key_dist(gen);
+            const int64_t to = from + 500;
+            const size_t copied = index->Range(from, to, entries);
+            auto it = expected.lower_bound(from);
+            for (size_t i = 0; i < copied; i++, ++it) {
+                ASSERT_EQ(entries[i].key, it->first);
+                ASSERT_EQ(entries[i].value, it->second);
+            }
+            ASSERT_TRUE(it == expected.end() or it->first >= to);
+
+            Index::Entry entry{};
+            const auto lower = expected.lower_bound(key);
+            ASSERT_EQ(index->LowerBound(key, entry), lower != expected.end());
+            if (lower != expected.end()) {
+                ASSERT_EQ(entry.key, lower->first);
+            }
+        }
+    }
+
+    // A bounded output stops the range early.
+    Index::Entry two[2];
+    ASSERT_EQ(index->Range(INT64_MIN, INT64_MAX, two), std::min<size_t>(2, expected.size()));
+}
+
+TEST(SortedIndex, Full) {
+    using Index = SortedIndex<mode::MultiWriter, int64_t, int64_t, 40>;
+    auto index = std::make_unique<Index>();
+    for (int64_t i = 0; i < 40; i++) {
+        ASSERT_TRUE(index->Upsert(i * 2, i));
+    }
+    ASSERT_FALSE(index->Upsert(1, 0));
+    ASSERT_TRUE(index->Upsert(2, 7));
+    ASSERT_TRUE(index->Erase(0));
+    ASSERT_TRUE(index->Upsert(1, 0));
+
+    std::vector<Index::Entry> entries(40);
+    ASSERT_EQ(index->Range(INT64_MIN, INT64_MAX, entries), 40);
+    for (size_t i = 1; i < entries.size(); i++) {
+        ASSERT_LT(entries[i - 1].key, entries[i].key);
+    }
+}
+
+// The writer keeps a window of consecutive keys with values derived from them, sliding it such that nodes are split
+// and merged all the time. Readers must only ever see sorted, valid entries.
+TEST(SortedIndex, MultiThreadReadersSingleWriter) {
+    using Index = SortedIndex<mode::SingleWriter, int64_t, int64_t, 512>;
+    auto index = std::make_unique<Index>();
+    std::atomic<bool> done{false};
+
+    std::thread writer{[&] {
+        constexpr int64_t kWindow = 300;
+        for (int64_t i = 0; i < 50'000; i++) {
+            index->Upsert(i, -i);
+            if (i >= kWindow) {
+                index->Erase(i - kWindow);
+            }
+        }
+        done.store(true);
+    }};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&] {
+            std::vector<Index::Entry> entries(64);
+            while (not done.load()) {
+                Index::Entry entry{};
+                if (index->LowerBound(0, entry)) {
+                    ASSERT_EQ(entry.value, -entry.key);
+                    const size_t copied = index->Range(entry.key, entry.key + 1000, entries);
+                    for (size_t i = 0; i < copied; i++) {
+                        ASSERT_EQ(entries[i].value, -entries[i].key);
+                        if (i > 0) {
+                            ASSERT_LT(entries[i - 1].key, entries[i].key);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(index->Size(), 300);
+}
@@ -0,0 +1,107 @@
+#include "seqlock/stamped.hpp"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "seqlock/util.hpp"
+
+using namespace seqlock;  // NOLINT
+using namespace std::chrono_literals;
+
+TEST(StampedRegion, Age) {
+    using Region = StampedRegion<mode::SingleWriter, 256>;
+    auto region = std::make_unique<Region>();
+    // The stamp shares the sequence number's cache line.
+    ASSERT_EQ(sizeof(Region), 64 + 256);
+
+    char into[Region::Size()];
+    ASSERT_EQ(region->Age(), std::chrono::nanoseconds::max());
+    ASSERT_FALSE(region->LoadIfFresherThan(into, sizeof(into), 1h));
+
+    const auto before = std::chrono::system_clock::now();
+    region->Set(1);
+    const auto after = std::chrono::system_clock::now();
+
+    CommitStamp stamp;
+    ASSERT_EQ(region->Load(into, sizeof(into), &stamp), 2);
+    ASSERT_EQ(into[0], 1);
+    const std::chrono::system_clock::time_point timestamp{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{stamp.timestamp_ns})};
+    ASSERT_GE(timestamp, before);
+    ASSERT_LE(timestamp, after);
+    ASSERT_EQ(region->Stamp().tsc, stamp.tsc);
+
+    uint64_t seq{0};
+    ASSERT_TRUE(region->LoadIfFresherThan(into, sizeof(into), 1s, &seq));
+    ASSERT_EQ(seq, 2);
+
+    std::this_thread::sleep_for(20ms);
+    ASSERT_GE(region->Age(), 20ms);
+    ASSERT_FALSE(region->LoadIfFresherThan(into, sizeof(into), 10ms));
+
+    // A heartbeat refreshes the stamp and keeps the data.
+    region->Touch();
+    ASSERT_LT(region->Age(), 10ms);
+    ASSERT_TRUE(region->LoadIfFresherThan(into, sizeof(into), 10ms, &seq));
+    ASSERT_EQ(seq, 4);
+    ASSERT_EQ(into[Region::Size() - 1], 1);
+}
+
+TEST(StampedRegion, MultiThread) {
+    using Region = StampedRegion<mode::MultiWriter, 1024>;
+    auto region = std::make_unique<Region>();
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; w++) {
+        writers.emplace_back([&, w] {
+            for (int i = 1; i <= 10000; i++) {
+                region->Set((i + w) & 127);
+            }
+        });
+    }
+
+    auto into = std::make_unique<char[]>(Region::Size());
+    CommitStamp last;
+    uint64_t last_seq{0};
+    int torn{0};
+    int backwards{0};
+    for (int i = 0; i < 10000; i++) {
+        CommitStamp stamp;
+        const uint64_t seq = region->Load(into.get(), Region::Size(), &stamp);
+        if (std::any_of(into.get(), into.get() + Region::Size(), [&](char c) { return c != into[0]; })) {
+            torn++;
+        }
+        // Stamps never go back in time, whichever writer committed the version.
+        if (seq > last_seq and stamp.tsc < last.tsc) {
+            backwards++;
+        }
+        last = stamp;
+        last_seq = seq;
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(torn, 0);
+    ASSERT_EQ(backwards, 0);
+}
+
+TEST(StampedRegion, Shm) {
+    using Region = StampedRegion<mode::SingleWriter, 64>;
+    ::shm_unlink("/stampedregion");
+
+    auto writer_shm = util::SharedMemory<Region>::Create("/stampedregion", sizeof(Region));
+    ASSERT_TRUE(writer_shm.has_value()) << writer_shm.error();
+    auto reader_shm = util::SharedMemory<Region>::Create("/stampedregion", sizeof(Region));
+    ASSERT_TRUE(reader_shm.has_value()) << reader_shm.error();
+
+    writer_shm->Get()->Set(3);
+    char into[Region::Size()];
+    ASSERT_TRUE(reader_shm->Get()->LoadIfFresherThan(into, sizeof(into), 1s));
+    ASSERT_EQ(into[0], 3);
+}
@@ -0,0 +1,322 @@
+// Code generated by tools/seqlockgen.py from quote.toml. DO NOT EDIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <string>
+#include <type_traits>
+
+#include "seqlock/seqlock.hpp"
+
+namespace market {
+
+/// The top of the book of an instrument, and the depth on its own cache lines.
+struct Quote {
+    static constexpr uint64_t kLayoutHash = 0xa7a6cda010f1ff44ULL;
+
+    /// The bits of each field, to load sets of fields.
+    enum Field : uint32_t {
+        kBid = 1U << 0,
+        kAsk = 1U << 1,
+        kBidSize = 1U << 2,
+        kAskSize = 1U << 3,
+        kVenue = 1U << 4,
+        kHalted = 1U << 5,
+        kDepth = 1U << 6,
+        kAll = (1U << 7) - 1,
+    };
+
+    uint64_t layout_hash{kLayoutHash};
+    double bid{};
+    double ask{};
+    uint32_t bid_size{};
+    uint32_t ask_size{};
+    char venue[8]{};
+    bool halted{};
+    alignas(64) int64_t depth[16]{};
+};
+
+static_assert(std::is_trivially_copyable_v<Quote>);
+static_assert(sizeof(Quote) == 192);
+static_assert(offsetof(Quote, bid) == 8);
+static_assert(offsetof(Quote, ask) == 16);
+static_assert(offsetof(Quote, bid_size) == 24);
+static_assert(offsetof(Quote, ask_size) == 28);
+static_assert(offsetof(Quote, venue) == 32);
+static_assert(offsetof(Quote, halted) == 40);
+static_assert(offsetof(Quote, depth) == 64);
+
+/// `QuoteRegion` holds a `Quote` in a `GuardedRegion` and, like it, can be placed in shared memory.
+template <seqlock::mode::Mode ModeT>
+class QuoteRegion {
+   public:
+    static constexpr uint64_t kLayoutHash = Quote::kLayoutHash;
+
+    /// `kDataOffset` is the offset of the `Quote` in the region, which the Go `QuoteRegion` checks.
+    static constexpr size_t kDataOffset = std::is_same_v<ModeT, seqlock::mode::MultiWriter> ? 128 : 64;
+    static_assert(seqlock::GuardedRegion<ModeT, sizeof(Quote)>::DataOffset() == kDataOffset);
+
+    QuoteRegion() = default;
+    ~QuoteRegion() = default;
+
+    // Copy.
+    QuoteRegion(const QuoteRegion&) = delete;
+    QuoteRegion& operator=(const QuoteRegion&) = delete;
+
+    // Move.
+    QuoteRegion(QuoteRegion&&) = delete;
+    QuoteRegion& operator=(QuoteRegion&&) = delete;
+
+    /// `Store` stores `value`, including its layout hash.
+    void Store(const Quote& value) {
+        region_.Store(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    /// `Load` copies the whole region into `into` and returns the sequence number of the copied version.
+    uint64_t Load(Quote& into) const {
+        return region_.Load(reinterpret_cast<char*>(&into), sizeof(into));
+    }
+
+    /// `TryLoad` tries to copy the `fields` of the region into the same fields of `into` once, leaving the other
+    /// fields untouched. Only the cache lines of those fields are read. Returns false if a write interfered.
+    bool TryLoad(Quote& into, uint32_t fields, uint64_t* seq = nullptr) const {
+        auto* to = reinterpret_cast<char*>(&into);
+        return region_.TryLoadWith(
+            [&](const char* data) {
+                if ((fields & Quote::kBid) != 0) {
+                    std::memcpy(to + 8, data + 8, 8);
+                }
+                if ((fields & Quote::kAsk) != 0) {
+                    std::memcpy(to + 16, data + 16, 8);
+                }
+                if ((fields & Quote::kBidSize) != 0) {
+                    std::memcpy(to + 24, data + 24, 4);
+                }
+                if ((fields & Quote::kAskSize) != 0) {
+                    std::memcpy(to + 28, data + 28, 4);
+                }
+                if ((fields & Quote::kVenue) != 0) {
+                    std::memcpy(to + 32, data + 32, 8);
+                }
+                if ((fields & Quote::kHalted) != 0) {
+                    std::memcpy(to + 40, data + 40, 1);
+                }
+                if ((fields & Quote::kDepth) != 0) {
+                    std::memcpy(to + 64, data + 64, 128);
+                }
+            },
+            seq);
+    }
+
+    /// `Load` copies the `fields` of the region into `into` like `TryLoad`, retrying until no write interferes.
+    uint64_t Load(Quote& into, uint32_t fields) const {
+        uint64_t seq{0};
+        while (not TryLoad(into, fields, &seq)) {
+        }
+        return seq;
+    }
+
+    /// `LoadBid` returns `bid`, reading only its bytes.
+    double LoadBid() const {
+        double value;
+        LoadBytes(&value, 8, 8);
+        return value;
+    }
+
+    /// `LoadAsk` returns `ask`, reading only its bytes.
+    double LoadAsk() const {
+        double value;
+        LoadBytes(&value, 16, 8);
+        return value;
+    }
+
+    /// `LoadBidSize` returns `bid_size`, reading only its bytes.
+    uint32_t LoadBidSize() const {
+        uint32_t value;
+        LoadBytes(&value, 24, 4);
+        return value;
+    }
+
+    /// `LoadAskSize` returns `ask_size`, reading only its bytes.
+    uint32_t LoadAskSize() const {
+        uint32_t value;
+        LoadBytes(&value, 28, 4);
+        return value;
+    }
+
+    /// `LoadVenue` copies `venue` into `into`.
+    void LoadVenue(char (&into)[8]) const {
+        LoadBytes(into, 32, 8);
+    }
+
+    /// `LoadHalted` returns `halted`, reading only its bytes.
+    bool LoadHalted() const {
+        bool value;
+        LoadBytes(&value, 40, 1);
+        return value;
+    }
+
+    /// `LoadDepth` copies `depth` into `into`.
+    void LoadDepth(int64_t (&into)[16]) const {
+        LoadBytes(into, 64, 128);
+    }
+
+    /// `CheckLayout` returns an error if the region was never stored or was stored with a different layout.
+    std::expected<void, std::string> CheckLayout() const {
+        if (region_.Sequence() == 0) {
+            return std::unexpected("Quote was never stored.");
+        }
+        uint64_t layout_hash{0};
+        LoadBytes(&layout_hash, 0, sizeof(layout_hash));
+        if (layout_hash != kLayoutHash) {
+            return std::unexpected(
+                std::format("Quote has layout hash {:#x} instead of {:#x}.", layout_hash, kLayoutHash));
+        }
+        return {};
+    }
+
+    /// `Sequence` returns the current sequence number of the region.
+    uint64_t Sequence() const noexcept { return region_.Sequence(); }
+
+   private:
+    seqlock::GuardedRegion<ModeT, sizeof(Quote)> region_;
+
+    void LoadBytes(void* into, size_t offset, size_t size) const {
+        while (not region_.TryLoadWith([&](const char* data) { std::memcpy(into, data + offset, size); })) {
+        }
+    }
+};
+
+struct Trade {
+    static constexpr uint64_t kLayoutHash = 0x56c4d9096beb8572ULL;
+
+    /// The bits of each field, to load sets of fields.
+    enum Field : uint32_t {
+        kPrice = 1U << 0,
+        kQuantity = 1U << 1,
+        kSide = 1U << 2,
+        kAll = (1U << 3) - 1,
+    };
+
+    uint64_t layout_hash{kLayoutHash};
+    double price{};
+    int32_t quantity{};
+    int8_t side{};
+};
+
+static_assert(std::is_trivially_copyable_v<Trade>);
+static_assert(sizeof(Trade) == 24);
+static_assert(offsetof(Trade, price) == 8);
+static_assert(offsetof(Trade, quantity) == 16);
+static_assert(offsetof(Trade, side) == 20);
+
+/// `TradeRegion` holds a `Trade` in a `GuardedRegion` and, like it, can be placed in shared memory.
+template <seqlock::mode::Mode ModeT>
+class TradeRegion {
+   public:
+    static constexpr uint64_t kLayoutHash = Trade::kLayoutHash;
+
+    /// `kDataOffset` is the offset of the `Trade` in the region, which the Go `TradeRegion` checks.
+    static constexpr size_t kDataOffset = std::is_same_v<ModeT, seqlock::mode::MultiWriter> ? 128 : 8;
+    static_assert(seqlock::GuardedRegion<ModeT, sizeof(Trade)>::DataOffset() == kDataOffset);
+
+    TradeRegion() = default;
+    ~TradeRegion() = default;
+
+    // Copy.
+    TradeRegion(const TradeRegion&) = delete;
+    TradeRegion& operator=(const TradeRegion&) = delete;
+
+    // Move.
+    TradeRegion(TradeRegion&&) = delete;
+    TradeRegion& operator=(TradeRegion&&) = delete;
+
+    /// `Store` stores `value`, including its layout hash.
+    void Store(const Trade& value) {
+        region_.Store(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    /// `Load` copies the whole region into `into` and returns the sequence number of the copied version.
+    uint64_t Load(Trade& into) const {
+        return region_.Load(reinterpret_cast<char*>(&into), sizeof(into));
+    }
+
+    /// `TryLoad` tries to copy the `fields` of the region into the same fields of `into` once, leaving the other
+    /// fields untouched. Only the cache lines of those fields are read. Returns false if a write interfered.
+    bool TryLoad(Trade& into, uint32_t fields, uint64_t* seq = nullptr) const {
+        auto* to = reinterpret_cast<char*>(&into);
+        return region_.TryLoadWith(
+            [&](const char* data) {
+                if ((fields & Trade::kPrice) != 0) {
+                    std::memcpy(to + 8, data + 8, 8);
+                }
+                if ((fields & Trade::kQuantity) != 0) {
+                    std::memcpy(to + 16, data + 16, 4);
+                }
+                if ((fields & Trade::kSide) != 0) {
+                    std::memcpy(to + 20, data + 20, 1);
+                }
+            },
+            seq);
+    }
+
+    /// `Load` copies the `fields` of the region into `into` like `TryLoad`, retrying until no write interferes.
+    uint64_t Load(Trade& into, uint32_t fields) const {
+        uint64_t seq{0};
+        while (not TryLoad(into, fields, &seq)) {
+        }
+        return seq;
+    }
+
+    /// `LoadPrice` returns `price`, reading only its bytes.
+    double LoadPrice() const {
+        double value;
+        LoadBytes(&value, 8, 8);
+        return value;
+    }
+
+    /// `LoadQuantity` returns `quantity`, reading only its bytes.
+    int32_t LoadQuantity() const {
+        int32_t value;
+        LoadBytes(&value, 16, 4);
+        return value;
+    }
+
+    /// `LoadSide` returns `side`, reading only its bytes.
+    int8_t LoadSide() const {
+        int8_t value;
+        LoadBytes(&value, 20, 1);
+        return value;
+    }
+
+    /// `CheckLayout` returns an error if the region was never stored or was stored with a different layout.
+    std::expected<void, std::string> CheckLayout() const {
+        if (region_.Sequence() == 0) {
+            return std::unexpected("Trade was never stored.");
+        }
+        uint64_t layout_hash{0};
+        LoadBytes(&layout_hash, 0, sizeof(layout_hash));
+        if (layout_hash != kLayoutHash) {
+            return std::unexpected(
+                std::format("Trade has layout hash {:#x} instead of {:#x}.", layout_hash, kLayoutHash));
+        }
+        return {};
+    }
+
+    /// `Sequence` returns the current sequence number of the region.
+    uint64_t Sequence() const noexcept { return region_.Sequence(); }
+
+   private:
+    seqlock::GuardedRegion<ModeT, sizeof(Trade)> region_;
+
+    void LoadBytes(void* into, size_t offset, size_t size) const {
+        while (not region_.TryLoadWith([&](const char* data) { std::memcpy(into, data + offset, size); })) {
+        }
+    }
+};
+
+}  // namespace market
@@ -3,6 +3,8 @@
 #include <gtest/gtest.h>
 #include <unistd.h>
 
+#include <thread>
+
 using namespace seqlock::util;  // NOLINT
 
 TEST(Util, RoundToPageSize) {
@@ -12,3 +14,43 @@ TEST(Util, RoundToPageSize) {
     ASSERT_EQ(RoundToPageSize(page_size + 1), 2 * page_size);
     ASSERT_EQ(RoundToPageSize(page_size), page_size);
 }
+
+#if defined(__linux__)
+TEST(Util, PinThisThread) {
+    // Pin a separate thread such that the affinity is not inherited by threads spawned in other tests.
+    std::thread t{[] {
+        const auto cpu = static_cast<size_t>(sched_getcpu());
+        ASSERT_TRUE(PinThisThread(cpu).has_value());
+        ASSERT_EQ(static_cast<size_t>(sched_getcpu()), cpu);
+    }};
+    t.join();
+}
+#endif
+
+TEST(Util, SharedMemoryOpenResize) {
+    ::shm_unlink("/utilresize");
+
+    auto creator = SharedMemory<uint64_t>::Create("/utilresize", 1);
+    ASSERT_TRUE(creator.has_value()) << creator.error();
+    *creator->Get() = 42;
+
+    auto opened = SharedMemory<uint64_t>::Open("/utilresize");
+    ASSERT_TRUE(opened.has_value()) << opened.error();
+    ASSERT_EQ(opened->Size(), creator->Size());
+    ASSERT_EQ(*opened->Get(), 42);
+
+    const auto page_size = GetPageSize();
+    ASSERT_TRUE(creator->Resize(3 * page_size - 1).has_value());
+    ASSERT_EQ(creator->Size(), 3 * page_size);
+    ASSERT_EQ(*creator->Get(), 42);
+
+    // Resizing never shrinks the file, and other mappings stay valid until they resize as well.
+    ASSERT_EQ(*opened->Get(), 42);
+    ASSERT_TRUE(opened->Resize(1).has_value());
+    ASSERT_EQ(opened->Size(), page_size);
+    const int fd = ::shm_open("/utilresize", O_RDONLY, 0);
+    ASSERT_EQ(GetFileSize(fd).value_or(0), 3 * page_size);
+    ::close(fd);
+
+    ASSERT_FALSE(SharedMemory<uint64_t>::Open("/utilresize-missing").has_value());
+}
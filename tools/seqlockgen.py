@@ -0,0 +1,529 @@
+#!/usr/bin/env python3
+"""Generates typed C++ and Go accessors for region layouts described in a schema.
+
+A schema is a TOML file listing regions and their fields:
+
+    namespace = "market"   # C++ namespace of the generated code
+    package = "market"     # Go package of the generated code
+
+    [[region]]
+    name = "Quote"
+    doc = "The top of the book of an instrument."
+    fields = [
+        { name = "bid", type = "f64" },
+        { name = "ask", type = "f64" },
+        { name = "venue", type = "bytes", count = 8 },
+        { name = "levels", type = "i64", count = 10, align = 64 },
+    ]
+
+Field types are `bool`, `u8`, `i8`, `u16`, `i16`, `u32`, `i32`, `u64`, `i64`, `f32`, `f64` and `bytes`. `count` makes
+an array, or sets the length of `bytes`. Fields are laid out in order at their natural alignment, or at `align`, for
+example 64 to start a field on its own cache line. Every region starts with an 8-byte layout hash, derived from the
+names, types and offsets of its fields, which readers check when they attach. A region has at most 31 fields.
+
+The C++ code defines a trivially copyable struct and a region class on top of `GuardedRegion`. The Go code defines the
+same struct with little-endian encoding, and a region type on top of `SeqLockNative` or `SeqLockNativeMulti`. Both
+load single fields or sets of fields, copying only the bytes, and thus only the cache lines, of those fields.
+
+    tools/seqlockgen.py schema.toml --cpp quote.hpp --go quote.go
+"""
+
+import argparse
+import dataclasses
+import sys
+import tomllib
+
+# The C++ type, Go type and size of each field type.
+TYPES = {
+    "bool": ("bool", "bool", 1),
+    "u8": ("uint8_t", "uint8", 1),
+    "i8": ("int8_t", "int8", 1),
+    "u16": ("uint16_t", "uint16", 2),
+    "i16": ("int16_t", "int16", 2),
+    "u32": ("uint32_t", "uint32", 4),
+    "i32": ("int32_t", "int32", 4),
+    "u64": ("uint64_t", "uint64", 8),
+    "i64": ("int64_t", "int64", 8),
+    "f32": ("float", "float32", 4),
+    "f64": ("double", "float64", 8),
+    "bytes": ("char", "byte", 1),
+}
+
+HASH_SIZE = 8
+
+# Field sets are 32-bit masks, with one more bit to spare for the mask of all fields.
+MAX_FIELDS = 31
+
+# Where a `GuardedRegion` puts its data: a single writer next to the 8-byte sequence number if it fits in its cache line
+# and on the next line otherwise, multiple writers after the writer lock.
+SEQ_SIZE = 8
+LINE_SIZE = 64
+MULTI_WRITER_OFFSET = 128
+
+
+@dataclasses.dataclass
+class Field:
+    name: str
+    type: str
+    count: int
+    align: int
+    offset: int = 0
+
+    @property
+    def element_size(self) -> int:
+        return TYPES[self.type][2]
+
+    @property
+    def size(self) -> int:
+        return self.element_size * self.count
+
+    @property
+    def camel(self) -> str:
+        return "".join(part.capitalize() for part in self.name.split("_"))
+
+    @property
+    def is_array(self) -> bool:
+        return self.count > 1 or self.type == "bytes"
+
+
+@dataclasses.dataclass
+class Region:
+    name: str
+    doc: str
+    fields: list[Field]
+    size: int = 0
+    align: int = HASH_SIZE
+    layout_hash: int = 0
+
+    @property
+    def single_writer_offset(self) -> int:
+        return SEQ_SIZE if SEQ_SIZE + self.size <= LINE_SIZE else LINE_SIZE
+
+
+def fail(message: str) -> None:
+    sys.exit(f"seqlockgen: {message}")
+
+
+def parse(schema: dict) -> list[Region]:
+    regions = []
+    for region_schema in schema.get("region", []):
+        name = region_schema.get("name") or fail("a region has no name")
+        fields = []
+        for field_schema in region_schema.get("fields", []):
+            field_name = field_schema.get("name") or fail(f"a field of {name} has no name")
+            field_type = field_schema.get("type")
+            if field_type not in TYPES:
+                fail(f"field {name}.{field_name} has unknown type {field_type!r}")
+            count = field_schema.get("count", 1)
+            align = field_schema.get("align", TYPES[field_type][2])
+            if count < 1:
+                fail(f"field {name}.{field_name} has count {count}")
+            if align < 1 or align > 64 or align & (align - 1) != 0:
+                fail(f"field {name}.{field_name} has alignment {align}, not a power of two up to 64")
+            fields.append(Field(field_name, field_type, count, align))
+        if not fields:
+            fail(f"region {name} has no fields")
+        if len(fields) > MAX_FIELDS:
+            fail(f"region {name} has {len(fields)} fields, more than {MAX_FIELDS}")
+        names = [field.name for field in fields]
+        if len(set(names)) != len(names) or "layout_hash" in names:
+            fail(f"region {name} has duplicate or reserved field names")
+        regions.append(layout(Region(name, region_schema.get("doc", ""), fields)))
+    if not regions:
+        fail("the schema has no regions")
+    return regions
+
+
+def layout(region: Region) -> Region:
+    offset = HASH_SIZE
+    for field in region.fields:
+        offset = (offset + field.align - 1) // field.align * field.align
+        field.offset = offset
+        offset += field.size
+        region.align = max(region.align, field.align)
+    region.size = (offset + region.align - 1) // region.align * region.align
+
+    # FNV-1a over the layout, so that any change to a name, type or offset changes the hash.
+    description = f"{region.name}:{region.size};" + ";".join(
+        f"{field.name}:{field.type}:{field.count}:{field.offset}" for field in region.fields
+    )
+    layout_hash = 0xCBF29CE484222325
+    for byte in description.encode():
+        layout_hash = ((layout_hash ^ byte) * 0x100000001B3) % (1 << 64)
+    region.layout_hash = layout_hash
+    return region
+
+
+def cpp_region(region: Region) -> str:
+    name = region.name
+    lines = []
+    if region.doc:
+        lines.append(f"/// {region.doc}")
+    lines.append(f"struct {name} {{")
+    lines.append(f"    static constexpr uint64_t kLayoutHash = 0x{region.layout_hash:016x}ULL;")
+    lines.append("")
+    lines.append("    /// The bits of each field, to load sets of fields.")
+    lines.append("    enum Field : uint32_t {")
+    for i, field in enumerate(region.fields):
+        lines.append(f"        k{field.camel} = 1U << {i},")
+    lines.append(f"        kAll = (1U << {len(region.fields)}) - 1,")
+    lines.append("    };")
+    lines.append("")
+    lines.append("    uint64_t layout_hash{kLayoutHash};")
+    for field in region.fields:
+        cpp_type = TYPES[field.type][0]
+        align = f"alignas({field.align}) " if field.align != field.element_size else ""
+        extent = f"[{field.count}]" if field.is_array else ""
+        lines.append(f"    {align}{cpp_type} {field.name}{extent}{{}};")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"static_assert(std::is_trivially_copyable_v<{name}>);")
+    lines.append(f"static_assert(sizeof({name}) == {region.size});")
+    for field in region.fields:
+        lines.append(f"static_assert(offsetof({name}, {field.name}) == {field.offset});")
+    lines.append("")
+    lines.append(f"/// `{name}Region` holds a `{name}` in a `GuardedRegion` and, like it, can be placed in shared memory.")
+    lines.append("template <seqlock::mode::Mode ModeT>")
+    lines.append(f"class {name}Region {{")
+    lines.append("   public:")
+    lines.append(f"    static constexpr uint64_t kLayoutHash = {name}::kLayoutHash;")
+    lines.append("")
+    lines.append(f"    /// `kDataOffset` is the offset of the `{name}` in the region, which the Go `{name}Region` checks.")
+    lines.append(
+        "    static constexpr size_t kDataOffset = std::is_same_v<ModeT, seqlock::mode::MultiWriter> ? "
+        f"{MULTI_WRITER_OFFSET} : {region.single_writer_offset};"
+    )
+    lines.append(f"    static_assert(seqlock::GuardedRegion<ModeT, sizeof({name})>::DataOffset() == kDataOffset);")
+    lines.append("")
+    lines.append(f"    {name}Region() = default;")
+    lines.append(f"    ~{name}Region() = default;")
+    lines.append("")
+    lines.append("    // Copy.")
+    lines.append(f"    {name}Region(const {name}Region&) = delete;")
+    lines.append(f"    {name}Region& operator=(const {name}Region&) = delete;")
+    lines.append("")
+    lines.append("    // Move.")
+    lines.append(f"    {name}Region({name}Region&&) = delete;")
+    lines.append(f"    {name}Region& operator=({name}Region&&) = delete;")
+    lines.append("")
+    lines.append("    /// `Store` stores `value`, including its layout hash.")
+    lines.append(f"    void Store(const {name}& value) {{")
+    lines.append("        region_.Store(reinterpret_cast<const char*>(&value), sizeof(value));")
+    lines.append("    }")
+    lines.append("")
+    lines.append("    /// `Load` copies the whole region into `into` and returns the sequence number of the copied version.")
+    lines.append(f"    uint64_t Load({name}& into) const {{")
+    lines.append("        return region_.Load(reinterpret_cast<char*>(&into), sizeof(into));")
+    lines.append("    }")
+    lines.append("")
+    lines.append("    /// `TryLoad` tries to copy the `fields` of the region into the same fields of `into` once, leaving the other")
+    lines.append("    /// fields untouched. Only the cache lines of those fields are read. Returns false if a write interfered.")
+    lines.append(f"    bool TryLoad({name}& into, uint32_t fields, uint64_t* seq = nullptr) const {{")
+    lines.append("        auto* to = reinterpret_cast<char*>(&into);")
+    lines.append("        return region_.TryLoadWith(")
+    lines.append("            [&](const char* data) {")
+    for field in region.fields:
+        lines.append(f"                if ((fields & {name}::k{field.camel}) != 0) {{")
+        lines.append(f"                    std::memcpy(to + {field.offset}, data + {field.offset}, {field.size});")
+        lines.append("                }")
+    lines.append("            },")
+    lines.append("            seq);")
+    lines.append("    }")
+    lines.append("")
+    lines.append("    /// `Load` copies the `fields` of the region into `into` like `TryLoad`, retrying until no write interferes.")
+    lines.append(f"    uint64_t Load({name}& into, uint32_t fields) const {{")
+    lines.append("        uint64_t seq{0};")
+    lines.append("        while (not TryLoad(into, fields, &seq)) {")
+    lines.append("        }")
+    lines.append("        return seq;")
+    lines.append("    }")
+    for field in region.fields:
+        cpp_type = TYPES[field.type][0]
+        lines.append("")
+        if field.is_array:
+            lines.append(f"    /// `Load{field.camel}` copies `{field.name}` into `into`.")
+            lines.append(f"    void Load{field.camel}({cpp_type} (&into)[{field.count}]) const {{")
+            lines.append(f"        LoadBytes(into, {field.offset}, {field.size});")
+            lines.append("    }")
+        else:
+            lines.append(f"    /// `Load{field.camel}` returns `{field.name}`, reading only its bytes.")
+            lines.append(f"    {cpp_type} Load{field.camel}() const {{")
+            lines.append(f"        {cpp_type} value;")
+            lines.append(f"        LoadBytes(&value, {field.offset}, {field.size});")
+            lines.append("        return value;")
+            lines.append("    }")
+    lines.append("")
+    lines.append("    /// `CheckLayout` returns an error if the region was never stored or was stored with a different layout.")
+    lines.append("    std::expected<void, std::string> CheckLayout() const {")
+    lines.append("        if (region_.Sequence() == 0) {")
+    lines.append(f'            return std::unexpected("{name} was never stored.");')
+    lines.append("        }")
+    lines.append("        uint64_t layout_hash{0};")
+    lines.append("        LoadBytes(&layout_hash, 0, sizeof(layout_hash));")
+    lines.append("        if (layout_hash != kLayoutHash) {")
+    lines.append("            return std::unexpected(")
+    lines.append(f'                std::format("{name} has layout hash {{:#x}} instead of {{:#x}}.", layout_hash, kLayoutHash));')
+    lines.append("        }")
+    lines.append("        return {};")
+    lines.append("    }")
+    lines.append("")
+    lines.append("    /// `Sequence` returns the current sequence number of the region.")
+    lines.append("    uint64_t Sequence() const noexcept { return region_.Sequence(); }")
+    lines.append("")
+    lines.append("   private:")
+    lines.append(f"    seqlock::GuardedRegion<ModeT, sizeof({name})> region_;")
+    lines.append("")
+    lines.append("    void LoadBytes(void* into, size_t offset, size_t size) const {")
+    lines.append("        while (not region_.TryLoadWith([&](const char* data) { std::memcpy(into, data + offset, size); })) {")
+    lines.append("        }")
+    lines.append("    }")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def generate_cpp(regions: list[Region], namespace: str, source: str) -> str:
+    header = [
+        f"// Code generated by tools/seqlockgen.py from {source}. DO NOT EDIT.",
+        "",
+        "#pragma once",
+        "",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "#include <cstring>",
+        "#include <expected>",
+        "#include <format>",
+        "#include <string>",
+        "#include <type_traits>",
+        "",
+        '#include "seqlock/seqlock.hpp"',
+        "",
+        f"namespace {namespace} {{",
+        "",
+    ]
+    body = "\n\n".join(cpp_region(region) for region in regions)
+    return "\n".join(header) + "\n" + body + f"\n\n}}  // namespace {namespace}\n"
+
+
+def go_decode(field: Field, target: str, data: str) -> list[str]:
+    go_type = TYPES[field.type][1]
+    if field.type == "bytes":
+        return [f"copy({target}[:], {data}[{field.offset}:{field.offset + field.size}])"]
+
+    def element(offset: str) -> str:
+        size = field.element_size
+        if field.type == "bool":
+            return f"{data}[{offset}] != 0"
+        if size == 1:
+            return f"{go_type}({data}[{offset}])"
+        unsigned = f"binary.LittleEndian.Uint{size * 8}({data}[{offset}:])"
+        if field.type.startswith("u"):
+            return unsigned
+        if field.type.startswith("i"):
+            return f"{go_type}({unsigned})"
+        return f"math.Float{size * 8}frombits({unsigned})"
+
+    if not field.is_array:
+        return [f"{target} = {element(str(field.offset))}"]
+    return [
+        f"for i := range {target} {{",
+        f"\t{target}[i] = {element(f'{field.offset}+i*{field.element_size}')}",
+        "}",
+    ]
+
+
+def go_encode(field: Field, source: str) -> list[str]:
+    if field.type == "bytes":
+        return [f"copy(data[{field.offset}:{field.offset + field.size}], {source}[:])"]
+
+    def element(offset: str, value: str) -> str:
+        size = field.element_size
+        if field.type == "bool":
+            return f"data[{offset}] = 0\nif {value} {{\n\tdata[{offset}] = 1\n}}"
+        if size == 1:
+            return f"data[{offset}] = byte({value})"
+        if field.type.startswith("u"):
+            converted = value
+        elif field.type.startswith("i"):
+            converted = f"uint{size * 8}({value})"
+        else:
+            converted = f"math.Float{size * 8}bits({value})"
+        return f"binary.LittleEndian.PutUint{size * 8}(data[{offset}:], {converted})"
+
+    if not field.is_array:
+        return element(str(field.offset), source).split("\n")
+    body = element(f"{field.offset}+i*{field.element_size}", f"{source}[i]").split("\n")
+    return [f"for i := range {source} {{"] + ["\t" + line for line in body] + ["}"]
+
+
+def go_aligned(rows: list[tuple[str, str]], separator: str) -> list[str]:
+    """Aligns the second column of `rows` like gofmt does in blocks of constants and struct fields."""
+    width = max(len(first) for first, _ in rows)
+    return [f"\t{first.ljust(width)}{separator}{second}" for first, second in rows]
+
+
+def go_region(region: Region) -> str:
+    name = region.name
+    lock = ["LoadFn(fn func(data []byte)) bool", "StoreFn(fn func(data []byte))", "Size() int", "DataOffset() int"]
+    lines = ["const ("]
+    # The sizes and offsets are untyped: gofmt leaves an empty type column before their `=`.
+    lines += go_aligned(
+        [
+            (f"{name}Size", f"{'':6} = {region.size}"),
+            (f"{name}LayoutHash", f"uint64 = 0x{region.layout_hash:016x}"),
+            (f"{name}SingleWriterOffset", f"{'':6} = {region.single_writer_offset}"),
+            (f"{name}MultiWriterOffset", f"{'':6} = {MULTI_WRITER_OFFSET}"),
+        ],
+        " ",
+    )
+    lines += [")", "", f"// Bits of the fields of a {name}, to load sets of fields.", "const ("]
+    lines += go_aligned(
+        [(f"{name}{field.camel}", f"uint32 = 1 << {i}") for i, field in enumerate(region.fields)]
+        + [(f"{name}All", f"uint32 = 1<<{len(region.fields)} - 1")],
+        " ",
+    )
+    lines += [")", ""]
+    if region.doc:
+        lines.append(f"// {name}: {region.doc}")
+    lines.append(f"type {name} struct {{")
+    lines += go_aligned(
+        [(field.camel, (f"[{field.count}]" if field.is_array else "") + TYPES[field.type][1]) for field in region.fields],
+        " ",
+    )
+    lines += ["}", ""]
+
+    lines += [
+        f"// Encode writes the layout hash and all fields into data, which holds at least {name}Size bytes.",
+        f"func (v *{name}) Encode(data []byte) {{",
+        f"\tbinary.LittleEndian.PutUint64(data[0:], {name}LayoutHash)",
+    ]
+    for field in region.fields:
+        lines += ["\t" + line for line in go_encode(field, f"v.{field.camel}")]
+    lines += ["}", ""]
+
+    lines += [
+        f"// Decode reads all fields from data, which holds at least {name}Size bytes.",
+        f"func (v *{name}) Decode(data []byte) {{",
+        f"\tv.DecodeFields(data, {name}All)",
+        "}",
+        "",
+        "// DecodeFields reads the fields set in fields from data, leaving the others untouched.",
+        f"func (v *{name}) DecodeFields(data []byte, fields uint32) {{",
+    ]
+    for field in region.fields:
+        lines.append(f"\tif fields&{name}{field.camel} != 0 {{")
+        lines += ["\t\t" + line for line in go_decode(field, f"v.{field.camel}", "data")]
+        lines.append("\t}")
+    lines += ["}", ""]
+
+    lines += [
+        f"// {name}Region holds a {name} in a lock whose data starts where the C++ {name}Region of the same mode puts it:",
+        f"// at {name}SingleWriterOffset for a single writer, see NewSeqLockNativeRegionShared, or at {name}MultiWriterOffset",
+        "// in a SeqLockNativeMulti.",
+        f"type {name}Region struct {{",
+        "\tlock interface {",
+        *("\t\t" + method for method in lock),
+        "\t}",
+        "}",
+        "",
+        f"func New{name}Region(lock interface {{",
+        *("\t" + method for method in lock),
+        f"}}) ({name}Region, error) {{",
+        f"\tif lock.Size() < {name}Size {{",
+        f'\t\treturn {name}Region{{}}, fmt.Errorf("region of %d bytes cannot hold a {name} of %d bytes", lock.Size(), {name}Size)',
+        "\t}",
+        f"\tif offset := lock.DataOffset(); offset != {name}SingleWriterOffset && offset != {name}MultiWriterOffset {{",
+        f'\t\treturn {name}Region{{}}, fmt.Errorf("region with data at offset %d is not laid out like a C++ {name}Region", offset)',
+        "\t}",
+        f"\treturn {name}Region{{lock: lock}}, nil",
+        "}",
+        "",
+        f"func (r {name}Region) Store(v *{name}) {{",
+        "\tr.lock.StoreFn(v.Encode)",
+        "}",
+        "",
+        f"func (r {name}Region) Load(v *{name}) {{",
+        f"\tr.LoadFields(v, {name}All)",
+        "}",
+        "",
+        "// LoadFields loads the fields set in fields, reading only their bytes from the shared memory.",
+        f"func (r {name}Region) LoadFields(v *{name}, fields uint32) {{",
+        "\tfor !r.lock.LoadFn(func(data []byte) { v.DecodeFields(data, fields) }) {",
+        "\t}",
+        "}",
+    ]
+    for field in region.fields:
+        go_type = (f"[{field.count}]" if field.is_array else "") + TYPES[field.type][1]
+        lines += [
+            "",
+            f"func (r {name}Region) Load{field.camel}() {go_type} {{",
+            f"\tvar value {go_type}",
+            "\tfor !r.lock.LoadFn(func(data []byte) {",
+            *("\t\t" + line for line in go_decode(field, "value", "data")),
+            "\t}) {",
+            "\t}",
+            "\treturn value",
+            "}",
+        ]
+    lines += [
+        "",
+        "// CheckLayout returns an error if the region was stored by a writer with a different layout, or never stored.",
+        f"func (r {name}Region) CheckLayout() error {{",
+        "\tvar layoutHash uint64",
+        "\tfor !r.lock.LoadFn(func(data []byte) { layoutHash = binary.LittleEndian.Uint64(data[0:]) }) {",
+        "\t}",
+        "\tif layoutHash == 0 {",
+        f'\t\treturn fmt.Errorf("{name} was never stored")',
+        "\t}",
+        f"\tif layoutHash != {name}LayoutHash {{",
+        f'\t\treturn fmt.Errorf("{name} has layout hash %#x instead of %#x", layoutHash, {name}LayoutHash)',
+        "\t}",
+        "\treturn nil",
+        "}",
+    ]
+    return "\n".join(lines)
+
+
+def generate_go(regions: list[Region], package: str, source: str) -> str:
+    body = "\n\n".join(go_region(region) for region in regions)
+    imports = ['"encoding/binary"', '"fmt"']
+    if "math." in body:
+        imports.append('"math"')
+    header = [
+        f"// Code generated by tools/seqlockgen.py from {source}. DO NOT EDIT.",
+        "",
+        f"package {package}",
+        "",
+        "import (",
+        *(f"\t{path}" for path in imports),
+        ")",
+        "",
+    ]
+    return "\n".join(header) + "\n" + body + "\n"
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("schema", help="TOML schema describing the regions")
+    parser.add_argument("--cpp", help="path of the generated C++ header")
+    parser.add_argument("--go", help="path of the generated Go file")
+    args = parser.parse_args()
+
+    with open(args.schema, "rb") as schema_file:
+        schema = tomllib.load(schema_file)
+    regions = parse(schema)
+    source = args.schema.rsplit("/", 1)[-1]
+    if args.cpp:
+        with open(args.cpp, "w") as out:
+            out.write(generate_cpp(regions, schema.get("namespace", "regions"), source))
+    if args.go:
+        with open(args.go, "w") as out:
+            out.write(generate_go(regions, schema.get("package", "regions"), source))
+    if not args.cpp and not args.go:
+        for region in regions:
+            print(f"{region.name}: {region.size} bytes, layout hash 0x{region.layout_hash:016x}")
+            for field in region.fields:
+                print(f"  {field.offset:>6} {field.name}: {field.type} x {field.count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+import pathlib
+import tomllib
+import unittest
+
+import seqlockgen
+
+TOOLS = pathlib.Path(__file__).parent
+REPO = TOOLS.parent
+SCHEMA = TOOLS / "examples" / "quote.toml"
+
+
+def _regions(fields: list[dict]) -> list[seqlockgen.Region]:
+    return seqlockgen.parse({"region": [{"name": "Test", "fields": fields}]})
+
+
+class SeqlockgenTest(unittest.TestCase):
+    def test_layout(self):
+        (region,) = _regions(
+            [
+                {"name": "a", "type": "u8"},
+                {"name": "b", "type": "f64"},
+                {"name": "c", "type": "i16", "count": 3, "align": 64},
+            ]
+        )
+        self.assertEqual([field.offset for field in region.fields], [8, 16, 64])
+        self.assertEqual(region.size, 128)
+
+    def test_layout_hash(self):
+        (region,) = _regions([{"name": "a", "type": "u32"}])
+        (renamed,) = _regions([{"name": "b", "type": "u32"}])
+        (retyped,) = _regions([{"name": "a", "type": "i32"}])
+        self.assertNotEqual(region.layout_hash, renamed.layout_hash)
+        self.assertNotEqual(region.layout_hash, retyped.layout_hash)
+
+    def test_single_writer_offset(self):
+        # The data shares the cache line of the sequence number up to 56 bytes.
+        (small,) = _regions([{"name": "a", "type": "u8", "count": 48}])
+        (large,) = _regions([{"name": "a", "type": "u8", "count": 49}])
+        self.assertEqual((small.size, small.single_writer_offset), (56, 8))
+        self.assertEqual((large.size, large.single_writer_offset), (64, 64))
+
+    def test_max_fields(self):
+        (region,) = _regions([{"name": f"f{i}", "type": "u8"} for i in range(seqlockgen.MAX_FIELDS)])
+        self.assertIn("kAll = (1U << 31) - 1,", seqlockgen.generate_cpp([region], "test", "test.toml"))
+
+    def test_invalid(self):
+        for fields in (
+            [],
+            [{"name": "a", "type": "u128"}],
+            [{"name": "a", "type": "u8", "align": 3}],
+            [{"name": "a", "type": "u8"}, {"name": "a", "type": "u8"}],
+            [{"name": "layout_hash", "type": "u64"}],
+            [{"name": f"f{i}", "type": "u8"} for i in range(seqlockgen.MAX_FIELDS + 1)],
+        ):
+            with self.assertRaises(SystemExit):
+                _regions(fields)
+
+    def test_generated_files_up_to_date(self):
+        with open(SCHEMA, "rb") as schema_file:
+            schema = tomllib.load(schema_file)
+        regions = seqlockgen.parse(schema)
+        cpp = seqlockgen.generate_cpp(regions, schema["namespace"], SCHEMA.name)
+        go = seqlockgen.generate_go(regions, schema["package"], SCHEMA.name)
+        self.assertEqual((REPO / "seqlock" / "testdata" / "quote.hpp").read_text(), cpp)
+        self.assertEqual((REPO / "bindings-go" / "quote_generated_test.go").read_text(), go)
+
+
+if __name__ == "__main__":
+    unittest.main()